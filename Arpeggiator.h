@@ -0,0 +1,166 @@
+/**
+ * Arpeggiator.h - Held-note arpeggiator clocked by the audio sample counter
+ *
+ * Sits between the inter-core MIDI queue and the synth's note handling on
+ * Core 1: while it is on, key presses only change the held set, and the
+ * arpeggiator plays one note per step at the exact sample the step falls on
+ * (the same block-splitting scheme as StepSequencer). Each step sorts at most
+ * NoteStack::CAPACITY held notes, so the cost per note is bounded.
+ *
+ * Modes walk the held notes up, down, in random order or in the order they
+ * were played, repeated over 1-4 octaves. The gate is a fraction of the step.
+ * The first key of a chord starts the clock; releasing every key stops it.
+ * No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "MemoryPlacement.h"
+#include "NoteStack.h"
+
+class Arpeggiator {
+public:
+    static constexpr uint8_t NOTE_ON = 0x90;
+    static constexpr uint8_t NOTE_OFF = 0x80;
+    static constexpr int NO_EVENT = -1;
+    static constexpr int MAX_OCTAVES = 4;
+
+    enum class Mode : uint8_t { OFF, UP, DOWN, RANDOM, AS_PLAYED };
+
+    bool isEnabled() const { return mode != Mode::OFF; }
+
+    // Once per block before any note events. step_length_q16 is in Q16 samples, gate in (0, 1].
+    // Turning the arpeggiator on or off forgets the held keys; emit(command, note, velocity) plays notes.
+    template <typename EmitFn>
+    void AUDIO_RAM_FUNC(configure)(Mode new_mode, int new_octaves, float gate, uint64_t new_step_length_q16, EmitFn&& emit) {
+        if (new_mode != mode) {
+            if (new_mode == Mode::OFF || mode == Mode::OFF) {
+                held.clear();
+                release(emit);
+            }
+            mode = new_mode;
+        }
+        octaves = new_octaves < 1 ? 1 : (new_octaves > MAX_OCTAVES ? MAX_OCTAVES : new_octaves);
+        step_length_q16 = new_step_length_q16 > 0 ? new_step_length_q16 : 1;
+        if (gate < 0.01f) gate = 0.01f;
+        if (gate > 1.0f) gate = 1.0f;
+        gate_q16 = (uint32_t)(gate * 65536.0f);
+    }
+
+    // A key went down at the given frame of the current block; the first one starts the clock there
+    void noteOn(uint8_t note, uint8_t velocity, uint32_t frame) {
+        note &= 0x7F;
+        bool was_empty = held.isEmpty();
+        held.push(note);
+        velocities[note] = velocity;
+        if (was_empty) {
+            position = 0;
+            grid_q16 = (clock + frame) << 16;
+            next_step_time = clock + frame;
+        }
+    }
+
+    // The sounding arp note keeps its gate; the key just drops out of the pattern
+    void noteOff(uint8_t note) { held.remove(note & 0x7F); }
+
+    template <typename EmitFn>
+    void allNotesOff(EmitFn&& emit) {
+        held.clear();
+        release(emit);
+    }
+
+    // Frame within a block of block_frames where the next event is due, or NO_EVENT
+    int nextEventFrame(uint32_t block_frames) const {
+        uint64_t next = UINT64_MAX;
+        if (mode != Mode::OFF && !held.isEmpty()) next = next_step_time;
+        if (sounding && note_off_time < next) next = note_off_time;
+        if (next == UINT64_MAX) return NO_EVENT;
+        if (next <= clock) return 0;
+        return (next - clock < block_frames) ? (int)(next - clock) : NO_EVENT;
+    }
+
+    // Plays everything due at or before the given frame of the current block
+    template <typename EmitFn>
+    void AUDIO_RAM_FUNC(processEvents)(uint32_t frame, EmitFn&& emit) {
+        uint64_t now = clock + frame;
+        if (sounding && note_off_time <= now) release(emit);
+        if (mode == Mode::OFF || held.isEmpty() || next_step_time > now) return;
+
+        release(emit);      // Gate 1.0 ties into the next step
+        uint8_t velocity = 0;
+        sounding_note = selectNote(velocity);
+        emit(NOTE_ON, sounding_note, velocity);
+        sounding = true;
+        uint64_t gate = ((step_length_q16 >> 16) * gate_q16) >> 16;
+        note_off_time = now + (gate > 0 ? gate : 1);
+
+        grid_q16 += step_length_q16;
+        next_step_time = grid_q16 >> 16;
+        if (next_step_time <= now) {    // Tempo jumped up a long way: restart the grid here
+            grid_q16 = (now + 1) << 16;
+            next_step_time = now + 1;
+        }
+    }
+
+    void endBlock(uint32_t block_frames) { clock += block_frames; }
+
+private:
+    // Note for the current step (velocity of the key it came from), then advances the position
+    uint8_t AUDIO_RAM_FUNC(selectNote)(uint8_t& velocity) {
+        int count = held.size();
+        uint8_t order[NoteStack::CAPACITY];
+        for (int i = 0; i < count; ++i) order[i] = held.at(i);
+        if (mode == Mode::UP || mode == Mode::DOWN) {
+            // Insertion sort, ascending
+            for (int i = 1; i < count; ++i) {
+                uint8_t n = order[i];
+                int j = i - 1;
+                for (; j >= 0 && order[j] > n; --j) order[j + 1] = order[j];
+                order[j + 1] = n;
+            }
+        }
+
+        int length = count * octaves;
+        int index = (mode == Mode::RANDOM) ? (int)(nextRandom() % (uint32_t)length) : position % length;
+        position = (position + 1) % length;
+        if (mode == Mode::DOWN) index = length - 1 - index;
+
+        uint8_t key = order[index % count];
+        velocity = velocities[key];
+        int note = key + 12 * (index / count);
+        while (note > 127) note -= 12;
+        return (uint8_t)note;
+    }
+
+    template <typename EmitFn>
+    void release(EmitFn& emit) {
+        if (sounding) emit(NOTE_OFF, sounding_note, 0);
+        sounding = false;
+    }
+
+    // xorshift32, deterministic from boot like the sequencer's
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    Mode mode = Mode::OFF;
+    int octaves = 1;
+    uint32_t gate_q16 = 1 << 15;
+    uint64_t step_length_q16 = 1;
+
+    NoteStack held;
+    uint8_t velocities[128] = {};
+    int position = 0;                   // Step within the current held-note pattern
+
+    uint64_t clock = 0;                 // Samples rendered before the current block
+    uint64_t grid_q16 = 0;              // Time of the next step, Q16 samples
+    uint64_t next_step_time = 0;
+    bool sounding = false;
+    uint8_t sounding_note = 0;
+    uint64_t note_off_time = 0;
+    uint32_t rng = 0x9E3779B9u;
+};
@@ -0,0 +1,69 @@
+/**
+ * AudioCapture.h - Contiguous audio block capture from Core 1 for analysis on Core 0
+ *
+ * The waveform FIFO only carries every 4th sample, which is fine for the scope
+ * but useless for spectrum analysis. This captures a full-rate contiguous block
+ * on request, using a simple request/ready handshake:
+ *
+ * - Core 0 calls request() when it wants a new block
+ * - Core 1 calls captureBlock() once per audio buffer (a single flag check when idle)
+ * - Core 0 polls isReady(), reads samples, then requests the next block
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Fix15.h"
+#include "choc/audio/choc_SampleBuffers.h"
+#include "pico/multicore.h" // For memory barriers
+
+class AudioCapture {
+public:
+    static constexpr int CAPTURE_SIZE = 128;
+
+    // === Core 0 interface ===
+    void request() {
+        if (requested || ready) return;
+        write_pos = 0;
+        __dmb();
+        requested = true;
+    }
+
+    bool isReady() const { return ready; }
+    const int16_t* getSamples() const { return samples; }
+
+    // Hands the buffer back to Core 1 for the next capture
+    void release() {
+        __dmb();
+        ready = false;
+    }
+
+    // === Core 1 interface ===
+    // Copies channel 0 of a processed block until the capture is full
+    void captureBlock(const choc::buffer::InterleavedView<fix15>& buffer) {
+        if (!requested) return;
+
+        int pos = write_pos;
+        const int num_frames = (int)buffer.getNumFrames();
+        for (int f = 0; f < num_frames && pos < CAPTURE_SIZE; ++f) {
+            fix15 sample = buffer.getSample(0, (uint32_t)f);
+            samples[pos++] = (int16_t)clampfix15(sample, -32768, 32767);
+        }
+        write_pos = pos;
+
+        if (pos >= CAPTURE_SIZE) {
+            requested = false;
+            __dmb(); // Samples must be visible before ready flag
+            ready = true;
+        }
+    }
+
+private:
+    int16_t samples[CAPTURE_SIZE] = {};
+    int write_pos = 0;
+    volatile bool requested = false;
+    volatile bool ready = false;
+};
+
+// Single capture channel shared between the cores (Core 1 writes, Core 0 reads)
+inline AudioCapture g_audio_capture;
@@ -8,12 +8,13 @@
 
 #pragma once
 
-#include <vector>
 #include <cstdint>
 #include <algorithm>
 #include "choc/audio/choc_SampleBuffers.h"
 #include "AudioModule.h"
 #include "Fix15.h"
+#include "FixedVector.h"
+#include "MemoryPlacement.h"
 
 /**
  * AudioEngine - Central coordinator for audio processing modules
@@ -22,7 +23,7 @@
  * - Hardware-agnostic: doesn't know about I2S, PWM, or other hardware details
  * - Module-based: audio processing is done by composable AudioModule instances
  * - Fixed-point: all processing uses fix15 arithmetic for RP2040 optimization
- * - Real-time safe: no dynamic memory allocation during processing
+ * - Real-time safe: no dynamic memory allocation, modules are held in a FixedVector
  * 
  * Processing Flow:
  * 1. Hardware driver calls processNextBlock() with an empty buffer
@@ -32,6 +33,11 @@
  */
 class AudioEngine {
 public:
+    // Optional microsecond clock for per-module timing (supplied by the hardware driver)
+    using ProfilingClock = uint32_t (*)();
+    static constexpr int MAX_PROFILED_MODULES = 8;
+    static constexpr size_t MAX_MODULES = 8;
+
     AudioEngine(int channels, int frames)
       : numChannels(channels), numFrames(frames)
     {
@@ -49,19 +55,39 @@ public:
      * allowing each to add its output to the buffer.
      * @param bufferToFill An interleaved CHOC view representing the memory to write audio into.
      */
-    void processNextBlock(choc::buffer::InterleavedView<fix15>& bufferToFill) {
+    void AUDIO_RAM_FUNC(processNextBlock)(choc::buffer::InterleavedView<fix15>& bufferToFill) {
 
         // 1. Clear the buffer to ensure a clean slate for mixing.
         bufferToFill.clear();
 
         // 2. Process all modules, mixing their output into the buffer.
-        for (auto module : modules) {
-            module->process(bufferToFill);
+        if (!profilingClock) {
+            for (auto module : modules) {
+                module->process(bufferToFill);
+            }
+            return;
+        }
+
+        // Same loop with a clock read around each module
+        uint32_t start = profilingClock();
+        for (size_t i = 0; i < modules.size(); ++i) {
+            modules[i]->process(bufferToFill);
+            uint32_t end = profilingClock();
+            if (i < MAX_PROFILED_MODULES) moduleTimes[i] = end - start;
+            start = end;
         }
 
     }
 
+    void setProfilingClock(ProfilingClock clock) { profilingClock = clock; }
+
+    // Time spent in each module during the last block (in profiling clock ticks)
+    int getNumProfiledModules() const { return std::min((int)modules.size(), MAX_PROFILED_MODULES); }
+    uint32_t getModuleTime(int index) const { return moduleTimes[index]; }
+
 private:
     int numChannels, numFrames;
-    std::vector<AudioModule*> modules;
+    FixedVector<AudioModule*, MAX_MODULES> modules;
+    ProfilingClock profilingClock = nullptr;
+    uint32_t moduleTimes[MAX_PROFILED_MODULES] = {};
 };
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * BenchScenarios.h - Scripted note and CC workloads for renders and benchmarks
+ *
+ * Shared by host/DspRender (golden renders) and the PicoSynthBench firmware
+ * (cycle counts), so both exercise the DSP chain with the same material.
+ * Scenario names appear in reports and golden file names; keep them stable.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "PartBank.h"
+#include "StepSequencer.h"
+
+namespace bench_scenarios {
+
+constexpr int SAMPLE_RATE = 44100;
+constexpr int BLOCK_SIZE = 64;     // Matches I2sAudioOutput::BUFFER_SIZE
+
+// One MIDI message at a frame position (applied at the start of the block containing it)
+struct ScriptEvent {
+    uint32_t frame;
+    uint8_t status, data1, data2;
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    uint32_t length_frames;
+    std::vector<ScriptEvent> events;
+    void (*setup)() = nullptr;      // Runs after initialize_parameters(), e.g. to bind parts or start the sequencer
+};
+
+constexpr uint32_t ms(uint32_t milliseconds) { return milliseconds * SAMPLE_RATE / 1000; }
+
+inline std::vector<Scenario> buildScenarios() {
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back({"chord", "Default patch, C major triad held then released", ms(1000), {
+        {0, 0x90, 60, 100}, {0, 0x90, 64, 100}, {0, 0x90, 67, 100},
+        {ms(500), 0x80, 60, 0}, {ms(500), 0x80, 64, 0}, {ms(500), 0x80, 67, 0},
+    }});
+
+    Scenario sweep{"filter_sweep", "Held bass note with resonant cutoff sweep", ms(1200), {
+        {0, 0xB0, 77, 110}, {0, 0xB0, 83, 90}, {0, 0x90, 36, 127},
+        {ms(1000), 0x80, 36, 0},
+    }};
+    for (uint8_t value = 0; value < 128; value += 4) {
+        sweep.events.push_back({ms(20) + value * ms(7), 0xB0, 76, value});
+    }
+    scenarios.push_back(sweep);
+
+    scenarios.push_back({"voice_steal", "Six overlapping notes on four voices, then all notes off", ms(1000), {
+        {ms(0), 0x90, 48, 90}, {ms(50), 0x90, 52, 90}, {ms(100), 0x90, 55, 90},
+        {ms(150), 0x90, 59, 90}, {ms(200), 0x90, 62, 90}, {ms(250), 0x90, 65, 90},
+        {ms(300), 0x80, 52, 0}, {ms(600), 0xB0, 123, 0},
+    }});
+
+    scenarios.push_back({"osc_mix", "Pulse, sub and noise mix with PWM modulation", ms(900), {
+        {0, 0xB0, 80, 127}, {0, 0xB0, 82, 127}, {0, 0xB0, 78, 40},
+        {0, 0xB0, 85, 100}, {0, 0xB0, 86, 90}, {0, 0xB0, 87, 20},
+        {ms(10), 0x90, 41, 110}, {ms(400), 0xB0, 81, 20}, {ms(700), 0x80, 41, 0},
+    }});
+
+    scenarios.push_back({"envelope", "Envelope edits between notes and retriggering", ms(1200), {
+        {0, 0xB0, 74, 0}, {0, 0xB0, 71, 10}, {0, 0xB0, 73, 60}, {0, 0xB0, 72, 5},
+        {ms(10), 0x90, 57, 80}, {ms(150), 0x90, 57, 120}, {ms(300), 0x80, 57, 0},
+        {ms(400), 0xB0, 74, 40}, {ms(400), 0xB0, 72, 50},
+        {ms(450), 0x90, 69, 100}, {ms(800), 0x80, 69, 0},
+    }});
+
+    scenarios.push_back({"unison", "Four-note chord, 8-set unison with shared filters (worst case load)", ms(1000), {
+        {0, 0xB0, 88, 127}, {0, 0xB0, 89, 50}, {0, 0xB0, 90, 100},
+        {0, 0x90, 48, 100}, {0, 0x90, 55, 100}, {0, 0x90, 60, 100}, {0, 0x90, 64, 100},
+        {ms(500), 0xB0, 89, 100}, {ms(700), 0xB0, 123, 0},
+    }});
+
+    scenarios.push_back({"unison_filters", "Two notes, 8-set unison with a filter per set", ms(800), {
+        {0, 0xB0, 88, 127}, {0, 0xB0, 91, 0}, {0, 0xB0, 77, 90},
+        {0, 0x90, 43, 110}, {0, 0x90, 50, 110}, {ms(500), 0x80, 43, 0}, {ms(500), 0x80, 50, 0},
+    }});
+
+    scenarios.push_back({"mono_glide", "Legato line with low-note priority and portamento", ms(1200), {
+        {0, 0xB0, 92, 127}, {0, 0xB0, 93, 64}, {0, 0xB0, 5, 10},
+        {ms(10), 0x90, 45, 100}, {ms(200), 0x90, 57, 100}, {ms(350), 0x90, 40, 100},
+        {ms(500), 0x80, 40, 0}, {ms(650), 0x80, 45, 0}, {ms(800), 0x80, 57, 0},
+        {ms(900), 0x90, 64, 100}, {ms(1050), 0x80, 64, 0},
+    }});
+
+    // Arp up over two octaves at 1/16 notes (120 BPM), chord changes mid-pattern
+    scenarios.push_back({"arpeggio", "Arpeggiator up over two octaves with a chord change", ms(1200), {
+        {0, 0xB0, 106, 32}, {0, 0xB0, 107, 42},
+        {ms(5), 0x90, 48, 100}, {ms(5), 0x90, 52, 90}, {ms(5), 0x90, 55, 80},
+        {ms(600), 0x80, 52, 0}, {ms(600), 0x90, 51, 90}, {ms(1000), 0x80, 48, 0},
+        {ms(1000), 0x80, 51, 0}, {ms(1000), 0x80, 55, 0},
+    }});
+
+    Scenario bend{"pitch_mod", "Held chord with pitch bend sweeps and mod wheel vibrato", ms(1200), {
+        {0, 0xB0, 1, 0}, {0, 0x90, 48, 100}, {0, 0x90, 55, 100},
+        {ms(600), 0xB0, 1, 100}, {ms(1000), 0x80, 48, 0}, {ms(1000), 0x80, 55, 0},
+    }};
+    // Bend up to +2 semitones and back down below centre, 14-bit value in steps of 512
+    for (int i = 0; i <= 32; ++i) {
+        int value = i <= 16 ? 8192 + i * 511 : 8192 + (32 - i) * 511 - 4096;
+        bend.events.push_back({ms(20) + (uint32_t)i * ms(15), 0xE0, (uint8_t)(value & 0x7F), (uint8_t)(value >> 7)});
+    }
+    scenarios.push_back(bend);
+
+    // Two-track pattern from the step sequencer at 120 BPM with swing: bass on the beats and
+    // off-beats, a short higher note on the last 16th of each beat; no notes from the script
+    scenarios.push_back({"sequencer", "Step sequencer pattern with swing, played on the audio core", ms(1200), {
+        {0, 0xB0, 105, 40}, {ms(600), 0xB0, 76, 90},
+    }, [] {
+        SequencerPattern& pattern = g_sequencer_pattern.edit();
+        pattern.num_tracks = 2;
+        pattern.length = SequencerTrack::NUM_STEPS;
+        for (int t = 0; t < 2; ++t) {
+            SequencerTrack& track = pattern.tracks[t];
+            track.note = t ? 67 : 36;
+            track.chance = 100;
+            track.gate_ms = t ? 60 : 200;
+            for (int step = 0; step < SequencerTrack::NUM_STEPS; ++step) {
+                track.step_chance[step] = 100;
+                track.velocity[step] = t ? (step % 4 == 3 ? 90 : 0) : (step % 4 == 0 ? 120 : step % 4 == 2 ? 70 : 0);
+            }
+        }
+        g_sequencer_pattern.publish();
+        g_sequencer_reset_requests = g_sequencer_reset_requests + 1;
+        g_sequencer_running = true;
+    }});
+
+    // Bass on channel 1 (mono, one voice), lead chords on channel 2 with their own cutoff and envelope
+    scenarios.push_back({"multitimbral", "Mono bass and a poly lead part sharing the voice pool", ms(1200), {
+        {0, 0xB0, 92, 127}, {0, 0xB0, 5, 8}, {0, 0xB0, 76, 40}, {0, 0xB0, 77, 80},
+        {0, 0xB1, 76, 100}, {0, 0xB1, 74, 30}, {0, 0xB1, 72, 60}, {0, 0xB1, 80, 0},
+        {ms(5), 0x90, 36, 110}, {ms(300), 0x90, 43, 110}, {ms(320), 0x80, 36, 0},
+        {ms(100), 0x91, 60, 90}, {ms(100), 0x91, 64, 90}, {ms(100), 0x91, 67, 90},
+        {ms(500), 0x91, 72, 100}, {ms(600), 0x81, 60, 0}, {ms(600), 0x81, 64, 0},
+        {ms(700), 0xE1, 0, 80}, {ms(900), 0x80, 43, 0}, {ms(900), 0x81, 67, 0}, {ms(900), 0x81, 72, 0},
+    }, [] {
+        g_part_config[0].channel = 0;
+        g_part_config[0].max_voices = 1;
+        g_part_config[1].channel = 1;
+        g_part_config[1].max_voices = 3;
+    }});
+
+    // Flash sample mixed over a quiet saw: held looped tone with a bend, then one-shot hits
+    scenarios.push_back({"sampler", "Looped flash tone under a bend, then one-shot drum hits", ms(1200), {
+        {0, 0xB0, 110, 110}, {0, 0xB0, 79, 30}, {0, 0xB0, 76, 90},
+        {ms(5), 0x90, 48, 100}, {ms(5), 0x90, 60, 100},
+        {ms(300), 0xE0, 0, 96}, {ms(450), 0xE0, 0, 64}, {ms(500), 0xB0, 123, 0},
+        {ms(550), 0xB0, 111, 127}, {ms(600), 0x90, 36, 120}, {ms(700), 0x80, 36, 0},
+        {ms(800), 0x90, 45, 100}, {ms(820), 0x90, 57, 90}, {ms(1000), 0x80, 45, 0}, {ms(1000), 0x80, 57, 0},
+    }});
+
+    // One bar at 120 BPM on the drum channel (10) over a bass note on channel 1; the open hat on
+    // the last off-beat is choked by the closed hat after it
+    Scenario drums{"drums", "Kick, snare, hats and clap on channel 10 over a synth bass", ms(2100), {
+        {0, 0xB9, 114, 60}, {0, 0x90, 36, 90}, {ms(1900), 0x80, 36, 0},
+        {ms(1000), 0xB9, 115, 110}, {ms(1750), 0x99, 46, 100}, {ms(1875), 0x99, 42, 80},
+    }};
+    for (uint32_t beat = 0; beat < 4; ++beat) {
+        uint32_t t = beat * ms(500);
+        drums.events.push_back({t, 0x99, 36, 120});
+        drums.events.push_back({t + ms(250), 0x99, 42, (uint8_t)(beat == 3 ? 0 : 90)});
+        if (beat & 1) drums.events.push_back({t, 0x99, 38, 110});
+    }
+    drums.events.push_back({ms(1500), 0x99, 39, 100});
+    scenarios.push_back(drums);
+
+    // Events are applied in frame order
+    for (auto& scenario : scenarios) {
+        std::stable_sort(scenario.events.begin(), scenario.events.end(),
+                         [](const ScriptEvent& a, const ScriptEvent& b) { return a.frame < b.frame; });
+    }
+    return scenarios;
+}
+
+}  // namespace bench_scenarios
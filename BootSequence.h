@@ -0,0 +1,79 @@
+/**
+ * BootSequence.h - Boot milestones, the non-blocking splash screen and the boot report
+ *
+ * main() brings up the clocks and Core 1 audio before anything else, so a unit
+ * that reboots mid-set is making sound again long before the OLED or USB are up.
+ * Both of those come up later, driven from the Core 0 loop through update():
+ * - the splash is written once the SSD1306 has had its power-up time since reset,
+ *   with a DMA transfer instead of a blocking one
+ * - the boot report is printed once the USB serial port is connected, because
+ *   anything printed before enumeration is lost:
+ *
+ *   LOG:Boot: audio <t> ms (clocks <t> ms, core 1 launched <t> ms), display <t> ms, USB <t> ms
+ *
+ * Times come from time_us_64(), which starts counting during the SDK's runtime
+ * init, so the boot ROM's few milliseconds before that are not included.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "HeapGuard.h"
+#include "OledDisplay.h"
+
+enum class BootMilestone {
+    CLOCKS,          // System clock and core voltage set
+    CORE1_LAUNCHED,  // multicore_launch_core1() returned
+    AUDIO,           // Core 1 rendered its first block
+    DISPLAY,         // Splash screen sent to the OLED
+    USB,             // USB serial port connected
+    COUNT
+};
+
+class BootSequence {
+public:
+    // Records the first time a milestone is reached
+    void mark(BootMilestone milestone) {
+        uint64_t& at = milestone_us_[(int)milestone];
+        if (at == 0) at = time_us_64();
+    }
+
+    bool reached(BootMilestone milestone) const { return milestone_us_[(int)milestone] != 0; }
+
+    // Call from the Core 0 main loop; never blocks
+    void update() {
+        if (report_printed_) return;
+        if (!reached(BootMilestone::DISPLAY)) updateSplash();
+        if (!reached(BootMilestone::USB) && stdio_usb_connected()) mark(BootMilestone::USB);
+        if (reached(BootMilestone::USB) && reached(BootMilestone::DISPLAY)) printReport();
+    }
+
+private:
+    // main() marks AUDIO before the Core 0 loop starts, so the splash only ever says READY
+    void updateSplash() {
+        if (to_ms_since_boot(get_absolute_time()) < OledDisplay::POWER_UP_MS) return;
+        // Retried on the next call while the OLED's previous transfer is still running
+        if (writeToOledAsync("PICO SYNTH\nREADY")) mark(BootMilestone::DISPLAY);
+    }
+
+    void printReport() {
+        HeapGuardStats heap = heapGuardStats();
+        printf("LOG:--- Pico Synth (Integrated Voice) Initialized ---\n");
+        printf("LOG: System clock is running at %lu kHz\n", (unsigned long)(clock_get_hz(clk_sys) / 1000));
+        printf("LOG:Heap locked after %lu allocations (%lu bytes) during boot\n",
+               (unsigned long)heap.allocations, (unsigned long)heap.bytes);
+        printf("LOG:Boot: audio %.1f ms (clocks %.1f ms, core 1 launched %.1f ms), display %.1f ms, USB %.1f ms\n",
+               milliseconds(BootMilestone::AUDIO), milliseconds(BootMilestone::CLOCKS),
+               milliseconds(BootMilestone::CORE1_LAUNCHED), milliseconds(BootMilestone::DISPLAY),
+               milliseconds(BootMilestone::USB));
+        report_printed_ = true;
+    }
+
+    double milliseconds(BootMilestone milestone) const { return milestone_us_[(int)milestone] / 1000.0; }
+
+    uint64_t milestone_us_[(int)BootMilestone::COUNT] = {};
+    bool report_printed_ = false;
+};
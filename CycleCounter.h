@@ -0,0 +1,61 @@
+/**
+ * CycleCounter.h - Tick counter for benchmarks, built both on target and on the host
+ *
+ * - RP2350 (Cortex-M33): DWT cycle counter, 32 bits
+ * - RP2040 (Cortex-M0+): SysTick running from the processor clock, 24 bits
+ *   (wraps after ~67 ms at 250 MHz, so measured spans must stay shorter)
+ * - Host: steady_clock nanoseconds
+ *
+ * Measure with now() before and after, then elapsed(start, end).
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if PICO_ON_DEVICE
+#if PICO_RP2350
+#include "hardware/structs/m33.h"
+#else
+#include "hardware/structs/systick.h"
+#endif
+
+class CycleCounter {
+public:
+    static constexpr const char* UNIT = "cycles";
+
+#if PICO_RP2350
+    static void init() {
+        m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+        m33_hw->dwt_cyccnt = 0;
+        m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+    }
+    static inline uint32_t now() { return m33_hw->dwt_cyccnt; }
+    static inline uint32_t elapsed(uint32_t start, uint32_t end) { return end - start; }
+#else
+    static void init() {
+        systick_hw->rvr = 0x00FFFFFF;
+        systick_hw->cvr = 0;
+        systick_hw->csr = 0x5; // Enable, processor clock, no interrupt
+    }
+    // SysTick counts down
+    static inline uint32_t now() { return systick_hw->cvr; }
+    static inline uint32_t elapsed(uint32_t start, uint32_t end) { return (start - end) & 0x00FFFFFF; }
+#endif
+};
+
+#else
+#include <chrono>
+
+class CycleCounter {
+public:
+    static constexpr const char* UNIT = "ns";
+
+    static void init() {}
+    static inline uint32_t now() {
+        return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static inline uint32_t elapsed(uint32_t start, uint32_t end) { return end - start; }
+};
+#endif
@@ -0,0 +1,325 @@
+/**
+ * DrumModule.h - Analog-style drum voices on a dedicated MIDI channel
+ *
+ * Four instruments modelled loosely on the classic analog drum machines:
+ * - Kick (notes 35/36): sine from a lookup table with an exponential pitch drop and a noise click
+ * - Snare (38/40): short sine body plus noise through a band-pass resonator
+ * - Hats (42/44 closed, 46 open): six detuned square waves at metallic ratios, high-passed;
+ *   they share one voice, so a closed hat chokes a ringing open one
+ * - Clap (39): band-passed noise in three quick bursts and a tail
+ *
+ * Each instrument owns one voice, which a new hit restarts. Everything that
+ * depends on the knobs or the velocity (increments, decay and filter
+ * coefficients, levels) is computed once when the hit starts, so the sample
+ * loop is only table lookups, multiply-adds and exponential decays.
+ * Decays are Q30 so long tails stay smooth; times are to -60 dB.
+ *
+ * Notes on g_drum_channel reach the module through Sh101StyleSynth, which
+ * hands them over with their frame in the block (sequencer hits stay
+ * sample accurate). The module runs after the synth and adds to its output.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "AudioModule.h"
+#include "Fix15.h"
+#include "MemoryPlacement.h"
+#include "ParameterStore.h"
+
+// MIDI channel (0-15) whose notes play the drums instead of the synth parts, -1 = off.
+// Set from Core 0 ("DRUM_CHANNEL" command), read by Core 1 per packet.
+inline volatile int8_t g_drum_channel = 9;     // Channel 10, as in General MIDI
+
+namespace drum_detail {
+
+constexpr int SINE_BITS = 10;
+constexpr int SINE_SIZE = 1 << SINE_BITS;
+
+struct SineTable {
+    int16_t value[SINE_SIZE];
+};
+
+// One cycle at full scale, Taylor series per entry (compile time only)
+constexpr SineTable makeSineTable() {
+    SineTable table{};
+    for (int i = 0; i < SINE_SIZE; ++i) {
+        double x = 2.0 * 3.14159265358979323846 * i / SINE_SIZE;
+        if (x > 3.14159265358979323846) x -= 2.0 * 3.14159265358979323846;
+        double term = x, sum = x;
+        for (int k = 1; k < 14; ++k) {
+            term *= -x * x / ((2 * k) * (2 * k + 1));
+            sum += term;
+        }
+        table.value[i] = (int16_t)(sum * 32767.0);
+    }
+    return table;
+}
+
+inline constexpr SineTable SINE AUDIO_RAM_DATA("drum_sine") = makeSineTable();
+
+}  // namespace drum_detail
+
+class DrumModule : public AudioModule {
+public:
+    enum class Instrument : uint8_t { KICK, SNARE, HAT, CLAP, COUNT };
+    static constexpr int NUM_VOICES = (int)Instrument::COUNT;
+
+    explicit DrumModule(float sample_rate) : sampleRate(sample_rate) {
+        for (auto& p : g_synth_parameters) {
+            if (p.getID() == "drumLevel") p_level = &p;
+            if (p.getID() == "kickTune") p_kickTune = &p;
+            if (p.getID() == "kickDecay") p_kickDecay = &p;
+            if (p.getID() == "snareTone") p_snareTone = &p;
+            if (p.getID() == "hatDecay") p_hatDecay = &p;
+        }
+    }
+
+    // General MIDI drum notes handled here, -1 for the rest
+    static int instrumentFor(uint8_t note) {
+        switch (note) {
+            case 35: case 36: return (int)Instrument::KICK;
+            case 38: case 40: return (int)Instrument::SNARE;
+            case 42: case 44: case 46: return (int)Instrument::HAT;
+            case 39: return (int)Instrument::CLAP;
+            default: return -1;
+        }
+    }
+
+    // A packet from the drum channel, due at `frame` of the coming (or current) block. Core 1 only.
+    // Two hits on one instrument within a block keep the later one.
+    void handleMidiPacket(uint32_t packet, uint32_t frame) {
+        uint8_t command = (packet >> 24) & 0xF0;
+        uint8_t note = (packet >> 16) & 0x7F;
+        uint8_t velocity = (packet >> 8) & 0x7F;
+        if (command == 0xB0 && note == 123) {   // All Notes Off: silence the kit
+            for (auto& voice : voices) voice.active = voice.pending = false;
+            return;
+        }
+        if (command != 0x90 || velocity == 0) return;  // Drums ignore note-offs
+        int instrument = instrumentFor(note);
+        if (instrument < 0) return;
+        Voice& voice = voices[instrument];
+        voice.pending = true;
+        voice.pending_note = note;
+        voice.pending_velocity = velocity;
+        voice.pending_frame = frame;
+    }
+
+    void AUDIO_RAM_FUNC(process)(choc::buffer::InterleavedView<fix15>& buffer) override {
+        uint32_t num_frames = buffer.getNumFrames();
+        fix15 level = p_level ? float2fix15(p_level->getValue()) >> 2 : 0;   // Same headroom as a synth voice
+
+        for (int i = 0; i < NUM_VOICES; ++i) {
+            Voice& voice = voices[i];
+            uint32_t frame = 0;
+            if (voice.pending) {
+                uint32_t start = voice.pending_frame < num_frames ? voice.pending_frame : 0;
+                if (voice.active) render(voice, (Instrument)i, buffer, 0, start, level);
+                startHit(voice, (Instrument)i);
+                frame = start;
+            }
+            if (voice.active) render(voice, (Instrument)i, buffer, frame, num_frames, level);
+        }
+    }
+
+private:
+    static constexpr int HAT_OSCS = 6;
+    static constexpr int32_t Q30_ONE = 1 << 30;
+    static constexpr int32_t SILENCE_Q30 = 1 << 14;     // Below one fix15 step
+
+    struct Voice {
+        bool active = false;
+        bool pending = false;
+        uint8_t pending_note = 0, pending_velocity = 0;
+        uint32_t pending_frame = 0;
+
+        // Tone: table sine (kick, snare body) with an extra increment that decays away
+        uint32_t phase = 0, increment = 0, sweep = 0;
+        int32_t sweep_decay = 0;
+        int32_t tone_level = 0, tone_decay = 0;     // Q30
+
+        // Noise, or the hat's square cluster, through a Chamberlin state-variable filter
+        int32_t noise_level = 0, noise_decay = 0;   // Q30
+        fix15 svf_f = 0, svf_q = FIX15_ONE;
+        fix15 svf_low = 0, svf_band = 0;
+        uint32_t hat_phase[HAT_OSCS] = {}, hat_increment[HAT_OSCS] = {};
+
+        // Clap: the noise envelope restarts for each burst, then decays with tail_decay
+        uint16_t burst_frames = 0, burst_counter = 0;
+        uint8_t bursts_left = 0;
+        int32_t burst_level = 0, tail_decay = 0;
+    };
+
+    static int32_t decayStep(int32_t level, int32_t coef) { return (int32_t)(((int64_t)level * coef) >> 30); }
+
+    int32_t decayCoef(float seconds) const {
+        if (seconds < 0.001f) seconds = 0.001f;
+        return (int32_t)(expf(-6.9078f / (seconds * sampleRate)) * (float)Q30_ONE);
+    }
+
+    uint32_t incrementFor(float hz) const { return (uint32_t)(hz * 4294967296.0f / sampleRate); }
+
+    // Resonator coefficients: f = 2 sin(pi fc / fs), q = 1 / Q
+    void setResonator(Voice& voice, float hz, float resonance) const {
+        voice.svf_f = float2fix15(2.0f * sinf(3.14159265f * hz / sampleRate));
+        voice.svf_q = float2fix15(1.0f / resonance);
+        voice.svf_low = voice.svf_band = 0;
+    }
+
+    static float param(Parameter* p, float fallback) { return p ? p->getValue() : fallback; }
+
+    // Turns the knobs and velocity into per-sample constants (the only float math of a hit)
+    void AUDIO_RAM_FUNC(startHit)(Voice& voice, Instrument instrument) {
+        voice.pending = false;
+        voice.active = true;
+        int32_t velocity_q30 = (int32_t)((int64_t)Q30_ONE * voice.pending_velocity / 127);
+        voice.phase = 0;
+        voice.sweep = 0;
+        voice.sweep_decay = 0;
+        voice.tone_level = voice.noise_level = 0;
+        voice.bursts_left = 0;
+
+        switch (instrument) {
+            case Instrument::KICK:
+                voice.increment = incrementFor(param(p_kickTune, 50.0f));
+                voice.sweep = voice.increment * 3;              // Starts two octaves up
+                voice.sweep_decay = decayCoef(0.12f);
+                voice.tone_level = velocity_q30;
+                voice.tone_decay = decayCoef(param(p_kickDecay, 0.4f));
+                voice.noise_level = velocity_q30 / 4;           // Beater click
+                voice.noise_decay = decayCoef(0.008f);
+                setResonator(voice, 4000.0f, 0.7f);
+                break;
+            case Instrument::SNARE: {
+                float tone = param(p_snareTone, 0.5f);          // 0 = all body, 1 = all snares
+                voice.increment = incrementFor(185.0f);
+                voice.sweep = voice.increment / 2;
+                voice.sweep_decay = decayCoef(0.03f);
+                voice.tone_level = (int32_t)(velocity_q30 * (1.0f - tone) * 0.8f);
+                voice.tone_decay = decayCoef(0.15f);
+                voice.noise_level = (int32_t)(velocity_q30 * (0.2f + tone));
+                voice.noise_decay = decayCoef(0.25f);
+                setResonator(voice, 3200.0f, 1.2f);
+                break;
+            }
+            case Instrument::HAT: {
+                // 808 cymbal oscillator frequencies
+                static constexpr float HAT_HZ[HAT_OSCS] = {205.3f, 304.4f, 369.6f, 522.7f, 540.0f, 800.0f};
+                for (int k = 0; k < HAT_OSCS; ++k) voice.hat_increment[k] = incrementFor(HAT_HZ[k]);
+                float decay = param(p_hatDecay, 0.35f);
+                voice.noise_level = velocity_q30 / 2;
+                voice.noise_decay = decayCoef(voice.pending_note == 46 ? decay : decay * 0.125f);
+                setResonator(voice, 6000.0f, 1.0f);
+                break;
+            }
+            case Instrument::CLAP:
+                voice.burst_level = velocity_q30;
+                voice.noise_level = velocity_q30;
+                voice.burst_frames = (uint16_t)(0.009f * sampleRate);
+                voice.burst_counter = voice.burst_frames;
+                voice.bursts_left = 2;                          // After this one
+                voice.noise_decay = decayCoef(0.012f);
+                voice.tail_decay = decayCoef(0.3f);
+                setResonator(voice, 1100.0f, 2.0f);
+                break;
+            case Instrument::COUNT:
+                break;
+        }
+    }
+
+    fix15 noise() {
+        noise_seed = noise_seed * 1664525u + 1013904223u;
+        return (fix15)(int16_t)(noise_seed >> 16);
+    }
+
+    // Band-pass (or high-pass) output of the voice's resonator
+    static fix15 resonate(Voice& voice, fix15 in, bool highpass) {
+        voice.svf_low += multfix15(voice.svf_f, voice.svf_band);
+        fix15 high = in - voice.svf_low - multfix15(voice.svf_q, voice.svf_band);
+        voice.svf_band += multfix15(voice.svf_f, high);
+        return highpass ? high : voice.svf_band;
+    }
+
+    fix15 toneSample(Voice& voice) {
+        fix15 s = drum_detail::SINE.value[voice.phase >> (32 - drum_detail::SINE_BITS)];
+        voice.phase += voice.increment + voice.sweep;
+        voice.sweep = (uint32_t)(((uint64_t)voice.sweep * (uint32_t)voice.sweep_decay) >> 30);
+        fix15 out = multfix15(s, voice.tone_level >> 15);
+        voice.tone_level = decayStep(voice.tone_level, voice.tone_decay);
+        return out;
+    }
+
+    // Adds next() to frames [from, to) of every channel
+    template <typename SampleFn>
+    static void AUDIO_RAM_FUNC(mix)(choc::buffer::InterleavedView<fix15>& buffer, uint32_t from, uint32_t to, fix15 level,
+                    SampleFn&& next) {
+        uint32_t channels = buffer.getNumChannels();
+        for (uint32_t f = from; f < to; ++f) {
+            fix15 out = multfix15(next(), level);
+            for (uint32_t ch = 0; ch < channels; ++ch) buffer.getSample(ch, f) += out;
+        }
+    }
+
+    // Renders frames [from, to) of the voice; one loop per instrument, no branching on the kind per sample
+    void render(Voice& voice, Instrument instrument, choc::buffer::InterleavedView<fix15>& buffer,
+                uint32_t from, uint32_t to, fix15 level) {
+        switch (instrument) {
+            case Instrument::KICK:
+                mix(buffer, from, to, level, [&] {
+                    fix15 out = toneSample(voice) + multfix15(noise(), voice.noise_level >> 15);
+                    voice.noise_level = decayStep(voice.noise_level, voice.noise_decay);
+                    return out;
+                });
+                break;
+            case Instrument::SNARE:
+                mix(buffer, from, to, level, [&] {
+                    fix15 out = toneSample(voice) + multfix15(resonate(voice, noise(), false), voice.noise_level >> 15);
+                    voice.noise_level = decayStep(voice.noise_level, voice.noise_decay);
+                    return out;
+                });
+                break;
+            case Instrument::HAT:
+                mix(buffer, from, to, level, [&] {
+                    int32_t cluster = 0;
+                    for (int k = 0; k < HAT_OSCS; ++k) {
+                        cluster += (voice.hat_phase[k] & 0x80000000u) ? -FIX15_ONE / HAT_OSCS : FIX15_ONE / HAT_OSCS;
+                        voice.hat_phase[k] += voice.hat_increment[k];
+                    }
+                    fix15 out = multfix15(resonate(voice, cluster, true), voice.noise_level >> 15);
+                    voice.noise_level = decayStep(voice.noise_level, voice.noise_decay);
+                    return out;
+                });
+                break;
+            case Instrument::CLAP:
+                mix(buffer, from, to, level, [&] {
+                    fix15 out = multfix15(resonate(voice, noise(), false), voice.noise_level >> 15);
+                    if (voice.bursts_left && --voice.burst_counter == 0) {
+                        voice.noise_level = voice.burst_level;
+                        voice.burst_counter = voice.burst_frames;
+                        if (--voice.bursts_left == 0) voice.noise_decay = voice.tail_decay;
+                    } else {
+                        voice.noise_level = decayStep(voice.noise_level, voice.noise_decay);
+                    }
+                    return out;
+                });
+                break;
+            case Instrument::COUNT:
+                break;
+        }
+        if (voice.tone_level < SILENCE_Q30 && voice.noise_level < SILENCE_Q30 && voice.bursts_left == 0) {
+            voice.active = false;
+        }
+    }
+
+    float sampleRate;
+    Voice voices[NUM_VOICES];
+    uint32_t noise_seed = 0x1234567u;
+
+    Parameter* p_level = nullptr;
+    Parameter* p_kickTune = nullptr;
+    Parameter* p_kickDecay = nullptr;
+    Parameter* p_snareTone = nullptr;
+    Parameter* p_hatDecay = nullptr;
+};
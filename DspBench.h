@@ -0,0 +1,244 @@
+/**
+ * DspBench.h - Microbenchmarks for the fix15 DSP kernels
+ *
+ * Each kernel runs in isolation over CHUNK samples per measurement, REPEATS
+ * times after a warm-up pass. Results are ticks per sample from CycleCounter:
+ * CPU cycles on target, nanoseconds on the host. The same source is built into
+ * host/DspBenchHost and the on-target bench firmware so the numbers line up.
+ *
+ * Report lines are machine-readable:
+ *   BENCH:<kernel>,<unit>,<min per sample>,<mean per sample>
+ * with per-sample values printed to two decimals.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "CycleCounter.h"
+#include "Fix15.h"
+#include "Fix15Oscillators.h"
+#include "Fix15SamplePlayer.h"
+#include "SampleBank.h"
+#include "Fix15VCAEnvelopeModule.h"
+#include "SmoothedValue.h"
+#include "GainModule.h"
+#include "DrumModule.h"
+#include "ParameterStore.h"
+#include "Sh101StyleSynth.h"   // VoiceFilter
+#include "I2sFramePack.h"
+
+namespace dsp_bench {
+
+constexpr int CHUNK = 256;          // Samples per measurement (well inside the 24-bit SysTick span)
+constexpr int REPEATS = 32;
+constexpr int SAMPLE_RATE = 44100;
+
+struct Result {
+    const char* name;
+    uint32_t min_ticks = UINT32_MAX;    // Fastest run
+    uint64_t total_ticks = 0;           // Sum over all runs
+    int runs = 0;
+    int samples_per_run = CHUNK;
+};
+
+using ReportFn = void (*)(const Result& result);
+
+// Keeps kernel outputs alive so the compiler cannot drop the work
+inline volatile int32_t g_sink = 0;
+
+// Runs kernel() (one run = samples_per_run samples) REPEATS times after a warm-up
+template <typename Kernel>
+Result measure(const char* name, int samples_per_run, Kernel&& kernel) {
+    Result result;
+    result.name = name;
+    result.samples_per_run = samples_per_run;
+
+    kernel();
+    for (int r = 0; r < REPEATS; ++r) {
+        uint32_t start = CycleCounter::now();
+        kernel();
+        uint32_t ticks = CycleCounter::elapsed(start, CycleCounter::now());
+        if (ticks < result.min_ticks) result.min_ticks = ticks;
+        result.total_ticks += ticks;
+        result.runs++;
+    }
+    return result;
+}
+
+// Prints a BENCH line (per-sample values in hundredths, integer math only)
+inline void printResult(const Result& result) {
+    uint32_t min_x100 = (uint32_t)((uint64_t)result.min_ticks * 100 / result.samples_per_run);
+    uint32_t mean_x100 = (uint32_t)(result.total_ticks * 100 / ((uint64_t)result.runs * result.samples_per_run));
+    printf("BENCH:%s,%s,%lu.%02lu,%lu.%02lu\n", result.name, CycleCounter::UNIT,
+           (unsigned long)(min_x100 / 100), (unsigned long)(min_x100 % 100),
+           (unsigned long)(mean_x100 / 100), (unsigned long)(mean_x100 % 100));
+}
+
+// Benchmarks every kernel of the voice and output path.
+// Requires initialize_parameters() (GainModule looks up the master volume).
+inline void runKernelBenchmarks(ReportFn report = printResult) {
+    using namespace fixOscs::oscillator;
+    const fix15 freq = float2fix15(220.0f);
+
+    {
+        Phase phase;
+        phase.setSampleRate((float)SAMPLE_RATE);
+        phase.setFrequency(freq);
+        report(measure("phase_next", CHUNK, [&] {
+            uint32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += phase.next();
+            g_sink = (int32_t)acc;
+        }));
+    }
+    {
+        Saw saw;
+        saw.setSampleRate((float)SAMPLE_RATE);
+        saw.setFrequency(freq);
+        report(measure("saw", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += saw.getSample();
+            g_sink = acc;
+        }));
+    }
+    {
+        Pulse pulse;
+        pulse.setSampleRate((float)SAMPLE_RATE);
+        pulse.setFrequency(freq);
+        pulse.setPulseWidth(float2fix15(0.3f));
+        report(measure("pulse", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += pulse.getSample();
+            g_sink = acc;
+        }));
+    }
+    {
+        Sub sub;
+        sub.setSampleRate((float)SAMPLE_RATE);
+        sub.setFrequency(freq);
+        report(measure("sub", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += sub.getSample();
+            g_sink = acc;
+        }));
+    }
+    {
+        Noise noise;
+        report(measure("noise", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += noise.getSample();
+            g_sink = acc;
+        }));
+    }
+    {
+        // Four voices streaming the 32 KB looped tone from different offsets and pitches, in
+        // 64-frame blocks like the engine. Positions carry over between runs, so on target the
+        // reads keep walking through flash instead of settling in the XIP cache.
+        constexpr int VOICES = 4;
+        constexpr int BLOCK = 64;
+        const int32_t notes[VOICES] = {48, 55, 60, 67};
+        auto streamKernel = [&](const char* name, bool prefetch) {
+            static SamplePlayer players[VOICES];   // 2 KB of windows, too much for the core 0 stack
+            for (int v = 0; v < VOICES; ++v) {
+                players[v].start(samples::BANK[0], (uint32_t)v * (samples::TONE_FRAMES / VOICES));
+                players[v].setPitch(pitch::fromNote(notes[v]), pitch::rateScale((float)SAMPLE_RATE));
+            }
+            report(measure(name, CHUNK * VOICES, [&] {
+                int32_t acc = 0;
+                for (int b = 0; b < CHUNK; b += BLOCK) {
+                    for (int v = 0; v < VOICES; ++v) {
+                        if (prefetch) players[v].prefetch(BLOCK);
+                        for (int i = 0; i < BLOCK; ++i) acc += players[v].getSample();
+                    }
+                }
+                g_sink = acc;
+            }));
+        };
+        streamKernel("sample_xip_direct", false);
+        streamKernel("sample_xip_prefetch", true);
+    }
+    {
+        ModLFO lfo;
+        lfo.setSampleRate((float)SAMPLE_RATE);
+        lfo.setFrequency(float2fix15(2.0f));
+        report(measure("lfo_triangle", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += lfo.getSample();
+            g_sink = acc;
+        }));
+    }
+    {
+        // Filter fed by a saw so the ladder stages see real signal
+        VoiceFilter filter;
+        Saw saw;
+        saw.setSampleRate((float)SAMPLE_RATE);
+        saw.setFrequency(freq);
+        fix15 input[CHUNK];
+        for (int i = 0; i < CHUNK; ++i) input[i] = saw.getSample();
+        const fix15 cutoff = float2fix15(0.4f);
+        const fix15 resonance = float2fix15(0.6f);
+        report(measure("voice_filter", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += filter.process(input[i], cutoff, resonance);
+            g_sink = acc;
+        }));
+    }
+    {
+        // Long attack keeps the envelope in its ramp for the whole benchmark
+        Fix15VCAEnvelopeModule envelope((float)SAMPLE_RATE);
+        envelope.setAttackTime(2.0f);
+        envelope.noteOn();
+        report(measure("envelope", CHUNK, [&] {
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += envelope.getNextValue();
+            g_sink = acc;
+        }));
+    }
+    {
+        // Retarget every run so the value is always ramping
+        Fix15SmoothedValue smoothed;
+        smoothed.reset(SAMPLE_RATE, 0.05);
+        bool up = true;
+        report(measure("smoothed_value", CHUNK, [&] {
+            smoothed.setTargetValue(up ? FIX15_ONE : FIX15_ZERO);
+            up = !up;
+            int32_t acc = 0;
+            for (int i = 0; i < CHUNK; ++i) acc += smoothed.getNextValue();
+            g_sink = acc;
+        }));
+    }
+    {
+        GainModule gain((float)SAMPLE_RATE);
+        static fix15 stereo[CHUNK * 2];
+        for (int i = 0; i < CHUNK * 2; ++i) stereo[i] = (fix15)(i * 97 - 12000);
+        auto view = choc::buffer::createInterleavedView<fix15>(stereo, 2, CHUNK);
+        // Repeated gain shrinks the data, but the multiply cost does not depend on the values
+        report(measure("gain_module", CHUNK, [&] {
+            gain.process(view);
+            g_sink = stereo[CHUNK];
+        }));
+    }
+    {
+        // Whole kit retriggered every run: kick, snare, open hat and clap all sounding
+        DrumModule drums((float)SAMPLE_RATE);
+        static fix15 stereo[CHUNK * 2];
+        auto view = choc::buffer::createInterleavedView<fix15>(stereo, 2, CHUNK);
+        const uint8_t notes[] = {36, 38, 46, 39};
+        report(measure("drum_kit", CHUNK, [&] {
+            for (uint8_t note : notes) drums.handleMidiPacket((uint32_t)(0x90 << 24) | (note << 16) | (110 << 8), 0);
+            drums.process(view);
+            g_sink = stereo[CHUNK];
+        }));
+    }
+    {
+        static fix15 stereo[CHUNK * 2];
+        static uint32_t words[CHUNK];
+        for (int i = 0; i < CHUNK * 2; ++i) stereo[i] = (fix15)(i * 97 - 12000);
+        report(measure("i2s_pack", CHUNK, [&] {
+            packI2sFrames(stereo, words, CHUNK);
+            g_sink = (int32_t)words[CHUNK - 1];
+        }));
+    }
+}
+
+}  // namespace dsp_bench
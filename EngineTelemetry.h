@@ -0,0 +1,85 @@
+/**
+ * EngineTelemetry.h - Audio engine health metrics shared from Core 1 to Core 0
+ *
+ * Core 1 accumulates metrics into a private working copy during each block
+ * (plain stores, no synchronization) and publishes it once per block under a
+ * sequence lock. Core 0 reads a consistent snapshot whenever it likes without
+ * ever blocking the audio thread:
+ *
+ * - Writer: sequence goes odd, data is copied, sequence goes even
+ * - Reader: retries if the sequence was odd or changed during the copy
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "pico/multicore.h" // For memory barriers
+
+struct EngineTelemetrySnapshot {
+    static constexpr int MAX_MODULES = 4;   // Engine modules with individual timing
+    static constexpr int MAX_VOICES = 8;    // Voices with reported envelope state
+
+    uint32_t block_count = 0;       // Blocks rendered since boot
+    uint32_t block_us = 0;          // Render time of the last block
+    uint32_t peak_block_us = 0;     // Worst render time since the last peak reset
+    uint32_t block_budget_us = 0;   // Real-time duration of one block
+    uint32_t xrun_count = 0;        // Blocks that were not ready when the DMA needed them
+    uint32_t midi_event_count = 0;  // MIDI events applied on Core 1 since boot
+    uint8_t active_voices = 0;      // Voices with a running envelope
+    uint8_t midi_queue_peak = 0;    // Most FIFO packets drained in one block since the last peak reset
+    uint8_t num_modules = 0;
+    uint16_t module_us[MAX_MODULES] = {};  // Render time of each engine module in the last block
+    uint8_t num_voices = 0;
+    uint8_t voice_states[MAX_VOICES] = {}; // Envelope state per voice
+};
+
+class EngineTelemetry {
+public:
+    // === Core 1 interface ===
+    // Working copy updated in place during the block
+    EngineTelemetrySnapshot& writer() { return working; }
+
+    // Records the block timing and publishes the working copy (called once per block)
+    void endBlock(uint32_t block_us) {
+        if (peak_reset_requested) {
+            working.peak_block_us = 0;
+            working.midi_queue_peak = 0;
+            peak_reset_requested = false;
+        }
+        working.block_count++;
+        working.block_us = block_us;
+        if (block_us > working.peak_block_us) working.peak_block_us = block_us;
+
+        sequence = sequence + 1;   // Odd: update in progress
+        __dmb();
+        published = working;
+        __dmb();
+        sequence = sequence + 1;   // Even: snapshot consistent
+    }
+
+    // === Core 0 interface ===
+    EngineTelemetrySnapshot read() const {
+        EngineTelemetrySnapshot snapshot;
+        uint32_t seq_before, seq_after;
+        do {
+            seq_before = sequence;
+            __dmb();
+            snapshot = published;
+            __dmb();
+            seq_after = sequence;
+        } while ((seq_before & 1) || seq_before != seq_after);
+        return snapshot;
+    }
+
+    // Asks Core 1 to restart peak tracking on its next block
+    void resetPeak() { peak_reset_requested = true; }
+
+private:
+    EngineTelemetrySnapshot working;    // Core 1 only
+    EngineTelemetrySnapshot published;  // Guarded by sequence
+    volatile uint32_t sequence = 0;
+    volatile bool peak_reset_requested = false;
+};
+
+// Single telemetry channel (Core 1 writes, Core 0 reads)
+inline EngineTelemetry g_engine_telemetry;
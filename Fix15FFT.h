@@ -0,0 +1,125 @@
+// Fixed-point radix-2 FFT for on-device spectrum analysis
+
+#pragma once
+
+#include "Fix15.h"
+#include <array>
+#include <cstdint>
+
+// Compile-time bit-reversal permutation for the FFT input reordering
+template <int Size, int Log2Size>
+constexpr std::array<uint8_t, Size> makeBitReverseTable() {
+    std::array<uint8_t, Size> table{};
+    for (int i = 0; i < Size; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < Log2Size; ++b) {
+            if (i & (1 << b)) reversed |= 1 << (Log2Size - 1 - b);
+        }
+        table[i] = (uint8_t)reversed;
+    }
+    return table;
+}
+
+// 128-point forward FFT on 16-bit audio with Hann window and log-magnitude lookup.
+// Pure integer code (no 64-bit multiplies), so it runs fine on core 0 and on the host.
+class Fix15FFT {
+public:
+    static constexpr int SIZE = 128;
+    static constexpr int LOG2_SIZE = 7;
+    static constexpr int NUM_BINS = SIZE / 2;
+
+    // Windows the input block and transforms it in place.
+    // Every butterfly stage halves its outputs, so the result is scaled by 1/SIZE and cannot overflow.
+    void process(const int16_t* input) {
+        // Apply Hann window while loading in bit-reversed order
+        for (int i = 0; i < SIZE; ++i) {
+            int j = BIT_REVERSE[i];
+            re[j] = ((int32_t)input[i] * HANN_WINDOW[i]) >> 15;
+            im[j] = 0;
+        }
+
+        // Decimation-in-time butterflies
+        for (int stage = 1; stage <= LOG2_SIZE; ++stage) {
+            const int half = 1 << (stage - 1);
+            const int twiddle_stride = SIZE >> stage;
+
+            for (int k = 0; k < half; ++k) {
+                const int t = k * twiddle_stride;
+                const int32_t wr = SIN_TABLE[(t + SIZE / 4) & (SIZE - 1)];  // cos
+                const int32_t wi = -SIN_TABLE[t];                            // -sin (forward transform)
+
+                for (int i = k; i < SIZE; i += 2 * half) {
+                    const int j = i + half;
+                    // |z| <= 32767 and |w| <= 32767, so both products fit in 32 bits
+                    int32_t tr = (re[j] * wr - im[j] * wi) >> 15;
+                    int32_t ti = (re[j] * wi + im[j] * wr) >> 15;
+
+                    re[j] = (re[i] - tr) >> 1;
+                    im[j] = (im[i] - ti) >> 1;
+                    re[i] = (re[i] + tr) >> 1;
+                    im[i] = (im[i] + ti) >> 1;
+                }
+            }
+        }
+    }
+
+    // Squared magnitude of a bin (0 to NUM_BINS-1) from the last process() call
+    uint32_t getPower(int bin) const {
+        return (uint32_t)(re[bin] * re[bin]) + (uint32_t)(im[bin] * im[bin]);
+    }
+
+    // log2(power) in Q8 (256 = one octave of power = ~3dB) using leading-zero count + mantissa table
+    uint16_t getLog2PowerQ8(int bin) const {
+        return log2Q8(getPower(bin));
+    }
+
+    static uint16_t log2Q8(uint32_t value) {
+        if (value == 0) return 0;
+        int exponent = 31 - __builtin_clz(value);
+        // Top 4 bits below the leading one index the mantissa table
+        uint32_t mantissa = (exponent >= 4) ? (value >> (exponent - 4)) & 0xF
+                                            : (value << (4 - exponent)) & 0xF;
+        return (uint16_t)((exponent << 8) + LOG2_MANTISSA_Q8[mantissa]);
+    }
+
+private:
+    static constexpr std::array<uint8_t, SIZE> BIT_REVERSE = makeBitReverseTable<SIZE, LOG2_SIZE>();
+
+    // sin(2*pi*k/128) in Q15, one full period (cos is read a quarter period ahead)
+    static constexpr int16_t SIN_TABLE[SIZE] = {
+        0, 1608, 3212, 4808, 6393, 7962, 9512, 11039, 12539, 14010, 15446, 16846,
+        18204, 19519, 20787, 22005, 23170, 24279, 25329, 26319, 27245, 28105, 28898, 29621,
+        30273, 30852, 31356, 31785, 32137, 32412, 32609, 32728, 32767, 32728, 32609, 32412,
+        32137, 31785, 31356, 30852, 30273, 29621, 28898, 28105, 27245, 26319, 25329, 24279,
+        23170, 22005, 20787, 19519, 18204, 16846, 15446, 14010, 12539, 11039, 9512, 7962,
+        6393, 4808, 3212, 1608, 0, -1608, -3212, -4808, -6393, -7962, -9512, -11039,
+        -12539, -14010, -15446, -16846, -18204, -19519, -20787, -22005, -23170, -24279, -25329, -26319,
+        -27245, -28105, -28898, -29621, -30273, -30852, -31356, -31785, -32137, -32412, -32609, -32728,
+        -32767, -32728, -32609, -32412, -32137, -31785, -31356, -30852, -30273, -29621, -28898, -28105,
+        -27245, -26319, -25329, -24279, -23170, -22005, -20787, -19519, -18204, -16846, -15446, -14010,
+        -12539, -11039, -9512, -7962, -6393, -4808, -3212, -1608
+    };
+
+    // Hann window in Q15
+    static constexpr int16_t HANN_WINDOW[SIZE] = {
+        0, 20, 80, 180, 320, 499, 717, 973, 1267, 1597, 1965, 2367,
+        2803, 3273, 3775, 4308, 4870, 5461, 6078, 6721, 7387, 8075, 8784, 9511,
+        10254, 11013, 11785, 12569, 13361, 14161, 14967, 15776, 16586, 17396, 18203, 19006,
+        19803, 20591, 21369, 22135, 22886, 23622, 24340, 25039, 25716, 26371, 27001, 27605,
+        28181, 28729, 29247, 29733, 30186, 30606, 30990, 31340, 31652, 31927, 32164, 32363,
+        32522, 32642, 32722, 32762, 32762, 32722, 32642, 32522, 32363, 32164, 31927, 31652,
+        31340, 30990, 30606, 30186, 29733, 29247, 28729, 28181, 27605, 27001, 26371, 25716,
+        25039, 24340, 23622, 22886, 22135, 21369, 20591, 19803, 19006, 18203, 17396, 16586,
+        15776, 14967, 14161, 13361, 12569, 11785, 11013, 10254, 9511, 8784, 8075, 7387,
+        6721, 6078, 5461, 4870, 4308, 3775, 3273, 2803, 2367, 1965, 1597, 1267,
+        973, 717, 499, 320, 180, 80, 20, 0
+    };
+
+    // log2(1 + m/16) in Q8 for m = 0..15
+    static constexpr uint8_t LOG2_MANTISSA_Q8[16] = {
+        0, 22, 44, 63, 82, 100, 118, 134, 150, 165, 179, 193, 207, 220, 232, 244
+    };
+
+    int32_t re[SIZE];
+    int32_t im[SIZE];
+};
@@ -1,17 +1,19 @@
 #pragma once
 
 #include "Fix15.h"
+#include "MemoryPlacement.h"
 #include <cmath>
 
 namespace fixOscs::oscillator
 {
     struct Phase
     {
-        void resetPhase() { phase = 0; }
+        void resetPhase(uint32_t start = 0) { phase = start; }
         void setSampleRate(float sampleRate);
         void setFrequency(fix15 frequency);
+        void setIncrement(uint32_t newIncrement) { increment = newIncrement; }  // Precomputed pitch (e.g. detuned)
 
-        uint32_t next();
+        uint32_t AUDIO_RAM_FUNC(next)();
         uint32_t getCurrentPhase() const { return phase; }
 
         uint32_t phase = 0;
@@ -21,11 +23,13 @@ namespace fixOscs::oscillator
 
     struct Saw
     {
-        void resetPhase() { phase.resetPhase(); }
+        void resetPhase(uint32_t start = 0) { phase.resetPhase(start); }
         void setSampleRate(float sampleRate) { phase.setSampleRate(sampleRate); }
         void setFrequency(fix15 frequency) { phase.setFrequency(frequency); }
+        void setIncrement(uint32_t increment) { phase.setIncrement(increment); }
+        uint32_t getIncrement() const { return phase.increment; }
 
-        fix15 getSample();
+        fix15 AUDIO_RAM_FUNC(getSample)();
 
     private:
         Phase phase;
@@ -33,12 +37,14 @@ namespace fixOscs::oscillator
 
     struct Pulse
     {
-        void resetPhase() { phase.resetPhase(); }
+        void resetPhase(uint32_t start = 0) { phase.resetPhase(start); }
         void setSampleRate(float sampleRate) { phase.setSampleRate(sampleRate); }
         void setFrequency(fix15 frequency) { phase.setFrequency(frequency); }
+        void setIncrement(uint32_t increment) { phase.setIncrement(increment); }
+        uint32_t getIncrement() const { return phase.increment; }
         void setPulseWidth(fix15 width) { pulseWidth = width; }
 
-        fix15 getSample();
+        fix15 AUDIO_RAM_FUNC(getSample)();
 
     private:
         Phase phase;
@@ -55,7 +61,7 @@ namespace fixOscs::oscillator
             phase.setFrequency(halfFreq);
         }
 
-        fix15 getSample();
+        fix15 AUDIO_RAM_FUNC(getSample)();
 
     private:
         Phase phase;
@@ -63,7 +69,7 @@ namespace fixOscs::oscillator
 
     struct Noise
     {
-        fix15 getSample();
+        fix15 AUDIO_RAM_FUNC(getSample)();
 
     private:
         uint32_t seed = 1;
@@ -76,7 +82,7 @@ namespace fixOscs::oscillator
         void setSampleRate(float sampleRate) { phase.setSampleRate(sampleRate); }
         void setFrequency(fix15 frequency) { phase.setFrequency(frequency); }
 
-        fix15 getTriangle();    // Returns triangle wave -1 to +1
+        fix15 AUDIO_RAM_FUNC(getTriangle)();    // Returns triangle wave -1 to +1
         fix15 getSine();        // Returns sine wave -1 to +1 (approximated)
         fix15 getSquare();      // Returns square wave -1 to +1
         fix15 getSaw();         // Returns sawtooth wave -1 to +1
@@ -0,0 +1,174 @@
+/**
+ * Fix15SamplePlayer.h - int16 PCM playback straight from flash, with pitch and loop points
+ *
+ * Sample data is a const array, so on the Pico it stays in flash and is read
+ * through the memory-mapped XIP window; nothing is copied to SRAM at load.
+ * The read position is a Q16 sample index advanced by a Q16 step, with linear
+ * interpolation between neighbouring samples. A sample either loops between
+ * loop_start and loop_end forever or plays once and stops.
+ *
+ * Reading flash costs an XIP cache miss whenever playback crosses into a line
+ * that is not cached, and the cache (16 KB) is shared with the code. prefetch()
+ * copies the span the next block will read into a small per-player SRAM window
+ * in one sequential pass, loop wrap included, so the per-sample path is two
+ * SRAM loads with no wrap check. When the span does not fit (high pitches) the
+ * player reads flash directly. Both paths produce identical output.
+ *
+ * No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "Fix15.h"
+#include "MemoryPlacement.h"
+#include "PitchTable.h"
+
+namespace fixOscs::oscillator
+{
+    struct SampleData
+    {
+        const int16_t* pcm;         // Mono samples (flash resident when const)
+        uint32_t length;            // Frames
+        uint32_t loop_start;        // Loop region [loop_start, loop_end); loop_end == 0 plays once
+        uint32_t loop_end;
+        int32_t root_pitch_q16;     // Pitch the sample plays at when unshifted (PitchTable.h units)
+        uint32_t step_scale_q32;    // From stepScale(), converts phase increments to sample steps
+
+        bool loops() const { return loop_end > loop_start; }
+
+        // Steps through the PCM per output sample = increment(pitch - root + STEP_REFERENCE) * scale >> 32.
+        // The division happens here, at compile time, so note-ons never divide.
+        static constexpr int32_t STEP_REFERENCE = pitch::fromNote(64);
+        static constexpr uint32_t stepScale(uint32_t sample_rate) {
+            return (uint32_t)(((uint64_t)sample_rate << 48) /
+                              ((uint64_t)pitch::NOTE_TABLE.increment[64] * pitch::REFERENCE_RATE));
+        }
+    };
+
+    class SamplePlayer
+    {
+    public:
+        static constexpr int WINDOW = 256;  // Samples of SRAM per player for prefetch()
+
+        void start(const SampleData& data, uint32_t start_frame = 0)
+        {
+            sample = &data;
+            index = start_frame < data.length ? start_frame : 0;
+            frac = 0;
+            window_len = 0;
+        }
+
+        void stop() { sample = nullptr; window_len = 0; }
+        bool isPlaying() const { return sample != nullptr; }
+
+        // Pitch (semitones Q16, modulation included) at the rate given by pitch::rateScale()
+        void setPitch(int32_t pitch_q16, uint32_t rate_scale_q16)
+        {
+            if (!sample) return;
+            uint32_t increment = pitch::increment(pitch_q16 - sample->root_pitch_q16 + SampleData::STEP_REFERENCE,
+                                                  rate_scale_q16);
+            step = (uint32_t)(((uint64_t)increment * sample->step_scale_q32) >> 32);
+        }
+
+        // Copies what the next `frames` samples will read into the SRAM window.
+        // Returns false (and keeps reading flash directly) when that span is larger than WINDOW.
+        bool prefetch(uint32_t frames)
+        {
+            commitWindow();
+            if (!sample) return false;
+            uint32_t span = (uint32_t)(((uint64_t)frac + (uint64_t)step * frames) >> 16) + 2;
+            if (span > (uint32_t)WINDOW) return false;
+
+            // Copy in playback order: up to the wrap point, then again from the loop start
+            uint32_t end = sample->loops() ? sample->loop_end : sample->length;
+            uint32_t src = index, filled = 0;
+            while (filled < span) {
+                uint32_t run = std::min(span - filled, end - src);
+                std::memcpy(&window[filled], &sample->pcm[src], run * sizeof(int16_t));
+                filled += run;
+                src += run;
+                if (src < end) break;
+                if (!sample->loops()) {
+                    std::memset(&window[filled], 0, (span - filled) * sizeof(int16_t));  // Silence past the end
+                    break;
+                }
+                src = sample->loop_start;
+            }
+            window_len = span;
+            window_pos = 0;
+            return true;
+        }
+
+        fix15 AUDIO_RAM_FUNC(getSample)()
+        {
+            if (window_len) {
+                if (window_pos + 1 < window_len) {
+                    int32_t a = window[window_pos];
+                    int32_t b = window[window_pos + 1];
+                    fix15 out = lerp(a, b);
+                    frac += step;
+                    window_pos += frac >> 16;
+                    frac &= 0xFFFF;
+                    return out;
+                }
+                commitWindow();     // Pitch rose since prefetch(): finish the block from flash
+            }
+            return directSample();
+        }
+
+    private:
+        // Frac drops to 15 bits so (b - a) * frac stays inside 32 bits
+        fix15 lerp(int32_t a, int32_t b) const { return (fix15)(a + (((b - a) * (int32_t)(frac >> 1)) >> 15)); }
+
+        fix15 AUDIO_RAM_FUNC(directSample)()
+        {
+            if (!sample) return 0;
+            uint32_t next = index + 1;
+            int32_t a = sample->pcm[index];
+            int32_t b = 0;          // A one-shot fades into the silence after its last sample
+            if (sample->loops()) {
+                b = sample->pcm[next < sample->loop_end ? next : sample->loop_start];
+            } else if (next < sample->length) {
+                b = sample->pcm[next];
+            }
+            fix15 out = lerp(a, b);
+            frac += step;
+            advance(frac >> 16);
+            frac &= 0xFFFF;
+            return out;
+        }
+
+        // Moves the flash position by what was played from the window
+        void commitWindow()
+        {
+            if (!window_len) return;
+            window_len = 0;
+            advance(window_pos);
+        }
+
+        void advance(uint32_t samples)
+        {
+            index += samples;
+            if (sample->loops()) {
+                if (index >= sample->loop_end) {
+                    index = sample->loop_start + (index - sample->loop_start) % (sample->loop_end - sample->loop_start);
+                }
+            } else if (index >= sample->length) {
+                sample = nullptr;   // One-shot finished
+            }
+        }
+
+        const SampleData* sample = nullptr;
+        uint32_t index = 0;         // Integer sample position
+        uint32_t frac = 0;          // Fractional position, Q16
+        uint32_t step = 0;          // Samples per output sample, Q16
+
+        int16_t window[WINDOW];
+        uint32_t window_len = 0;    // Valid samples in window, 0 = read flash directly
+        uint32_t window_pos = 0;    // Position in window relative to index
+    };
+
+} // namespace fixOscs::oscillator
@@ -5,6 +5,7 @@
 #include "AudioModule.h"
 #include "SmoothedValue.h"
 #include "Fix15.h"
+#include "MemoryPlacement.h"
 #include "choc/audio/choc_SampleBuffers.h"
 #include <cmath>
 #include <algorithm>
@@ -58,6 +59,7 @@ public:
 
     bool isActive() const { return state != State::Idle; }
     State getState() const { return state; }
+    fix15 getCurrentLevel() const { return currentLevel; } // Last output, without advancing
 
     void setAttackTime(float seconds) {
         attackTimeSeconds = std::max(0.001f, seconds);
@@ -89,7 +91,7 @@ public:
         }
     }
 
-    void process(choc::buffer::InterleavedView<fix15>& buffer) override {
+    void AUDIO_RAM_FUNC(process)(choc::buffer::InterleavedView<fix15>& buffer) override {
         auto numFrames = buffer.getNumFrames();
         auto numChannels = buffer.getNumChannels();
 
@@ -107,7 +109,7 @@ public:
         }
     }
 
-    fix15 getNextValue() {
+    fix15 AUDIO_RAM_FUNC(getNextValue)() {
         // Update smoothed sustain level and timing parameters
         sustainLevel = s_sustainLevel.getNextValue();
         
@@ -0,0 +1,61 @@
+/**
+ * FixedVector.h - Vector with inline storage and a compile-time capacity
+ *
+ * Used in place of std::vector wherever the firmware knows the maximum count
+ * up front. The elements live inside the object, so a global or static
+ * FixedVector is sized by the linker and never touches the heap (HeapGuard.h).
+ * emplace_back() constructs in place, which also works for types that cannot
+ * be moved, such as Parameter with its std::atomic. Exceeding the capacity is
+ * a programming error: it asserts, and without asserts the element is dropped
+ * and nullptr is returned. No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, size_t Capacity>
+class FixedVector {
+public:
+    FixedVector() = default;
+    FixedVector(const FixedVector&) = delete;
+    FixedVector& operator=(const FixedVector&) = delete;
+    ~FixedVector() { clear(); }
+
+    template <typename... Args>
+    T* emplace_back(Args&&... args) {
+        assert(count < Capacity && "FixedVector capacity exceeded");
+        if (count >= Capacity) return nullptr;
+        T* item = new (&storage[count]) T(std::forward<Args>(args)...);
+        count++;
+        return item;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+
+    void clear() {
+        while (count > 0) data()[--count].~T();
+    }
+
+    size_t size() const { return count; }
+    static constexpr size_t capacity() { return Capacity; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+
+    T* data() { return std::launder(reinterpret_cast<T*>(storage)); }
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    T& operator[](size_t index) { return data()[index]; }
+    const T& operator[](size_t index) const { return data()[index]; }
+
+    T* begin() { return data(); }
+    T* end() { return data() + count; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + count; }
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[Capacity];
+    size_t count = 0;
+};
@@ -2,19 +2,20 @@
 
 #include "AudioModule.h"
 #include "Fix15.h"
+#include "MemoryPlacement.h"
 #include "ParameterStore.h"
 
 class GainModule : public AudioModule {
 public:
   GainModule(float sampleRate) {
     // Find master volume parameter
-    for (auto *p : g_synth_parameters) {
-      if (p->getID() == "masterVol")
-        p_master_vol = p;
+    for (auto& p : g_synth_parameters) {
+      if (p.getID() == "masterVol")
+        p_master_vol = &p;
     }
   }
 
-  void process(choc::buffer::InterleavedView<fix15> &buffer) override {
+  void AUDIO_RAM_FUNC(process)(choc::buffer::InterleavedView<fix15> &buffer) override {
     if (!p_master_vol) return;
     
     float vol = p_master_vol->getValue();
@@ -0,0 +1,59 @@
+#include "HeapGuard.h"
+#include "pico/stdlib.h"
+#include <cstdlib>
+#include <new>
+
+// Written by Core 0 only, read by both cores
+static volatile bool heap_locked = false;
+static HeapGuardStats heap_stats;
+
+// The panic message may need the heap itself (newlib's printf), so the lock comes off first
+[[noreturn]] static void allocationAfterBoot(const char* source, std::size_t size) {
+    heap_locked = false;
+    panic("%s of %u bytes after boot", source, (unsigned)size);
+}
+
+static void* countedAlloc(std::size_t size) {
+    void* block = std::malloc(size ? size : 1);
+    if (block) {
+        heap_stats.allocations++;
+        heap_stats.bytes += (uint32_t)size;
+    }
+    return block;
+}
+
+static void* guardedAlloc(std::size_t size) {
+    if (heap_locked) allocationAfterBoot("Heap allocation", size);
+    void* block = countedAlloc(size);
+    if (!block) panic("Out of memory allocating %u bytes", (unsigned)size);
+    return block;
+}
+
+// The nothrow forms fail the way their callers check for: nullptr, and after boot always
+static void* nothrowAlloc(std::size_t size) noexcept { return heap_locked ? nullptr : countedAlloc(size); }
+
+void lockHeap() { heap_locked = true; }
+bool isHeapLocked() { return heap_locked; }
+HeapGuardStats heapGuardStats() { return heap_stats; }
+
+void* operator new(std::size_t size) { return guardedAlloc(size); }
+void* operator new[](std::size_t size) { return guardedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return nothrowAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return nothrowAlloc(size); }
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+
+#if PICO_ON_DEVICE
+// newlib's allocator entry point, linked with --wrap=_malloc_r (CMakeLists.txt). malloc, calloc
+// and a realloc that moves all end up here, and so do newlib's own buffers (printf's "%f"),
+// which never go through the malloc symbol that pico_malloc wraps.
+extern "C" void* __real__malloc_r(struct _reent* reent, std::size_t size);
+
+extern "C" void* __wrap__malloc_r(struct _reent* reent, std::size_t size) {
+    if (heap_locked) allocationAfterBoot("C heap allocation", size);
+    return __real__malloc_r(reent, size);
+}
+#endif
@@ -0,0 +1,27 @@
+/**
+ * HeapGuard.h - No heap allocation after boot
+ *
+ * The firmware's objects are static storage (FixedVector.h, function-local
+ * statics), sized by the linker and listed per subsystem by memory_report.cmake.
+ * HeapGuard.cpp replaces the global operator new and delete. Allocations during
+ * boot are counted; once main() calls lockHeap(), any C++ allocation panics
+ * with its size. A stray std::string or container growth then fails on the
+ * first run instead of fragmenting the heap or stalling a core much later.
+ * The nothrow operator new returns nullptr instead. On the Pico, newlib's
+ * _malloc_r is wrapped as well, so C allocations (malloc() in the SDK, newlib's
+ * printf buffers) panic the same way after the lock.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+struct HeapGuardStats {
+    uint32_t allocations = 0;   // operator new calls so far
+    uint32_t bytes = 0;
+};
+
+// Called by Core 0 once both cores are set up; there is no unlock
+void lockHeap();
+bool isHeapLocked();
+HeapGuardStats heapGuardStats();
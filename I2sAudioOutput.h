@@ -19,9 +19,14 @@
 // CHOC & Module Includes
 #include "choc/audio/choc_SampleBuffers.h"
 #include "AudioEngine.h"
+#include "EngineTelemetry.h"
+#include "TraceRing.h"
+#include "LatencyProbe.h"
+#include "I2sFramePack.h"
 
 // include Fix15 stuff
 #include "Fix15.h"
+#include "MemoryPlacement.h"
 
 /**
  * I2sAudioOutput - High-Quality I2S Audio Driver for RP2040
@@ -60,6 +65,12 @@ public:
     static constexpr int DATA_PIN = 21;
     static constexpr int DEBUG_PIN = 26; // <<< ADD THIS: Define our debug pin
 
+    // Real-time length of one buffer, used as the DSP load reference
+    static constexpr uint32_t BLOCK_BUDGET_US = (uint32_t)((uint64_t)BUFFER_SIZE * 1000000 / SAMPLE_RATE);
+
+    // Duration of one frame in microseconds, Q8 (22.68 us at 44.1 kHz)
+    static constexpr uint32_t US_PER_FRAME_Q8 = (uint32_t)((1000000ull << 8) / SAMPLE_RATE);
+
 
     /**
      * @brief Constructor that takes a reference to an AudioEngine.
@@ -102,7 +113,10 @@ public:
         sm_config_set_fifo_join(&sm_config, PIO_FIFO_JOIN_TX); // Join FIFOs to make a single 8-word TX FIFO
         sm_config_set_clkdiv(&sm_config, clock_div);
 
-        pio_sm_init(pio, pio_sm, offset, &sm_config);
+        // Start at the entry point (set x, 14 with LRCLK high) so the first slot is a full 16 bits.
+        // From the program offset, bitloop1 would run with X = 0 and leave every word 2 bits out of
+        // step with LRCLK (host/I2sPioCheck shows the garbled frames).
+        pio_sm_init(pio, pio_sm, offset + audio_i2s_offset_entry_point, &sm_config);
 
         // --- This is the NEW, correct code ---
         pio_gpio_init(pio, DATA_PIN);
@@ -123,6 +137,9 @@ public:
 
         dma_channel_configure(dma_chan, &dma_config, &pio->txf[pio_sm], NULL, 0, false);
 
+        g_engine_telemetry.writer().block_budget_us = BLOCK_BUDGET_US;
+        audioEngine.setProfilingClock(time_us_32);
+
         // --- 3. IRQ Setup ---
         instance = this;
         dma_channel_set_irq0_enabled(dma_chan, true);
@@ -159,7 +176,14 @@ public:
 
             // The IRQ has flipped the index, so we can now fill the buffer
             // that just finished playing.
+            int filling_idx = dma_buffer_to_fill_idx;
             fillAndConvertNextBuffer();
+
+            // If the IRQ flipped again while we were rendering, the DMA has already
+            // chained the buffer we were still writing: count it as an xrun.
+            if (dma_buffer_to_fill_idx != filling_idx) {
+                g_engine_telemetry.writer().xrun_count++;
+            }
         }
     }
 
@@ -169,8 +193,10 @@ private:
      * This is the bridge function. It asks the AudioEngine to fill a float buffer,
      * then it converts that float data into the packed uint32_t format required by the PIO/DMA hardware.
      */
-    void fillAndConvertNextBuffer() {
+    void AUDIO_RAM_FUNC(fillAndConvertNextBuffer)() {
         gpio_put(DEBUG_PIN, true); // <<< ADD THIS: Set pin HIGH at the start
+        uint32_t block_start_us = time_us_32();
+        traceEvent(TraceEvent::BLOCK_START, (uint32_t)dma_buffer_to_fill_idx);
 
         // 1. Create a CHOC view pointing to our temporary float buffer.
         auto float_workspace_view = choc::buffer::createInterleavedView<fix15>(
@@ -185,31 +211,48 @@ private:
         // 3. Convert the float buffer to the uint32_t hardware buffer.
         uint32_t* hardware_buffer = audio_buffers[dma_buffer_to_fill_idx];
 
-        for (int i = 0; i < BUFFER_SIZE; ++i) {
-            // take the fix15 samples using just the 16 leftmost/integer bits... will this work as is?
-            int16_t sample_l_s16 = dsp_fix15_buffer[i * 2 + 0];
-            int16_t sample_r_s16 = dsp_fix15_buffer[i * 2 + 1];
+        packI2sFrames(dsp_fix15_buffer, hardware_buffer, BUFFER_SIZE);
 
-            // Pack the two 16-bit samples into a single 32-bit word.
-            // Per the PIO program comment: | 31:16 sample ws=0 | 15:0 sample ws=1 |
-            // Let's assume Right Channel is ws=0 and Left Channel is ws=1.
-            hardware_buffer[i] = (uint32_t)((uint16_t)sample_r_s16) << 16 | (uint16_t)sample_l_s16;
+        // Publish block timing and engine counters for Core 0 (a few stores per block)
+        EngineTelemetrySnapshot& telemetry = g_engine_telemetry.writer();
+        telemetry.num_modules = (uint8_t)std::min(audioEngine.getNumProfiledModules(), EngineTelemetrySnapshot::MAX_MODULES);
+        for (int i = 0; i < telemetry.num_modules; ++i) {
+            telemetry.module_us[i] = (uint16_t)audioEngine.getModuleTime(i);
         }
+        uint32_t block_end_us = time_us_32();
+        uint32_t block_us = block_end_us - block_start_us;
+        completeLatencyProbe(block_end_us);
+        g_engine_telemetry.endBlock(block_us);
+        traceEvent(TraceEvent::BLOCK_END, block_us);
 
         gpio_put(DEBUG_PIN, false); // <<< ADD THIS: Set pin LOW at the end
     }
 
+    /**
+     * Converts a pending latency probe's frame into DAC output time. The block just
+     * filled starts playing after the DMA drains the current buffer and the PIO FIFO
+     * (one 32-bit word per stereo frame in both).
+     */
+    void completeLatencyProbe(uint32_t now_us) {
+        if (!g_latency_probe.hasFirstSample()) return;
+        uint32_t frames_queued = dma_channel_hw_addr(dma_chan)->transfer_count
+                               + pio_sm_get_tx_fifo_level(pio, pio_sm);
+        uint32_t block_output_us = now_us + ((frames_queued * US_PER_FRAME_Q8) >> 8);
+        g_latency_probe.complete(block_output_us, US_PER_FRAME_Q8);
+    }
+
     /**
      * @brief DMA Interrupt Handler. This is called when a buffer transfer completes.
      * It immediately chains the next buffer to the DMA to ensure continuous audio.
      */
-    void dma_irh() {
+    void AUDIO_RAM_FUNC(dma_irh)() {
 
         // Clear the interrupt request flag
         dma_hw->ints0 = (1u << dma_chan);
 
         // Give the next buffer (the one the main loop just filled) to the DMA
         dma_channel_set_read_addr(dma_chan, audio_buffers[dma_buffer_to_fill_idx], true);
+        traceEvent(TraceEvent::DMA_IRQ, (uint32_t)dma_buffer_to_fill_idx);
 
         // Flip the index to signal to the main loop that it can now fill the other buffer.
         dma_buffer_to_fill_idx = 1 - dma_buffer_to_fill_idx;
@@ -222,11 +265,11 @@ private:
     uint pio_sm;
     uint dma_chan;
 
-    // Double-buffered audio data for the DMA
-    uint32_t audio_buffers[2][BUFFER_SIZE];
-
-    // Temporary workspace for the AudioEngine to fill with float samples
-    fix15 dsp_fix15_buffer[BUFFER_SIZE * NUM_CHANNELS];
+    // Double-buffered audio data for the DMA, and the workspace the AudioEngine fills.
+    // Static so they can sit in SCRATCH_X next to Core 1's stack: only Core 1 and the
+    // DMA touch them, and there is a single I2S output anyway (see instance)
+    inline static uint32_t audio_buffers[2][BUFFER_SIZE] AUDIO_CORE1_DATA("i2s_buffers");
+    inline static fix15 dsp_fix15_buffer[BUFFER_SIZE * NUM_CHANNELS] AUDIO_CORE1_DATA("i2s_workspace");
 
     // Index of the buffer for the main loop to fill next (0 or 1).
     // `volatile` is important as it's modified by an IRQ.
@@ -237,7 +280,7 @@ private:
 
     // This allows the static IRQ handler to call our non-static member function.
     inline static I2sAudioOutput* instance = nullptr;
-    static void static_dma_irh() {
+    static void AUDIO_RAM_FUNC(static_dma_irh)() {
         if (instance) instance->dma_irh();
     }
 };
@@ -0,0 +1,19 @@
+// Packing of rendered fix15 frames into I2S DMA words
+
+#pragma once
+
+#include <cstdint>
+#include "Fix15.h"
+#include "MemoryPlacement.h"
+
+// Packs interleaved stereo fix15 (L,R,...) into one 32-bit word per frame.
+// The PIO program shifts out bits 31:16 while LRCLK is high and 15:0 while it is low
+// (checked by host/I2sPioCheck): | 31:16 right | 15:0 left |
+// The 16 integer bits of fix15 audio in -1..1 are already the 16-bit DAC sample.
+inline void AUDIO_RAM_FUNC(packI2sFrames)(const fix15* stereo, uint32_t* words, int frames) {
+    for (int i = 0; i < frames; ++i) {
+        int16_t sample_l_s16 = (int16_t)stereo[i * 2 + 0];
+        int16_t sample_r_s16 = (int16_t)stereo[i * 2 + 1];
+        words[i] = (uint32_t)((uint16_t)sample_r_s16) << 16 | (uint16_t)sample_l_s16;
+    }
+}
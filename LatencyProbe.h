@@ -0,0 +1,122 @@
+/**
+ * LatencyProbe.h - End-to-end MIDI note latency measurement
+ *
+ * A note-on received on MIDI channel 16 is a latency probe. It plays like any
+ * other note, but its path through the synth is timed:
+ *
+ * 1. Core 0 timestamps receipt and tags the FIFO packet (begin)
+ * 2. Core 1 remembers which voice the tagged note landed on and the frame of
+ *    that voice's first non-zero sample (markFirstSample)
+ * 3. The I2S driver converts that frame to a DAC output time from the DMA read
+ *    position once the block is handed over (complete)
+ *
+ * Results accumulate in a histogram; "LATENCY_REPORT" prints the distribution,
+ * "LATENCY_RESET" clears it. One probe is in flight at a time.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "pico/multicore.h" // For memory barriers
+
+class LatencyProbe {
+public:
+    static constexpr uint8_t PROBE_CHANNEL = 15;        // MIDI channel 16 (zero based)
+    static constexpr uint8_t PACKET_FLAG = 0x01;        // Set in the unused low byte of the FIFO packet
+    static constexpr uint32_t BIN_US = 250;
+    static constexpr int NUM_BINS = 40;                 // 0-10 ms, last bin collects everything above
+    static constexpr uint32_t TIMEOUT_US = 1000000;     // Give up on a probe that never sounded
+
+    // === Core 0 interface ===
+    // Returns false if a previous probe is still in flight (the note is then sent untagged)
+    bool begin() {
+        uint32_t now = time_us_32();
+        if (in_flight && now - receive_us < TIMEOUT_US) return false;
+        if (in_flight) timeouts++;
+        receive_us = now;
+        first_sample_frame = -1;
+        __dmb();
+        in_flight = true;
+        return true;
+    }
+
+    void reset() {
+        for (auto& bin : histogram) bin = 0;
+        count = 0;
+        sum_us = 0;
+        min_us = UINT32_MAX;
+        max_us = 0;
+        timeouts = 0;
+    }
+
+    void report() const {
+        if (count == 0) {
+            printf("LOG:Latency: no probes measured (send note-on on channel 16)\n");
+            fflush(stdout);
+            return;
+        }
+        printf("LOG:Latency: %lu probes, min %lu us, mean %lu us, max %lu us, p50 %lu us, p95 %lu us, %lu timeouts\n",
+               (unsigned long)count, (unsigned long)min_us, (unsigned long)(sum_us / count), (unsigned long)max_us,
+               (unsigned long)percentile(50), (unsigned long)percentile(95), (unsigned long)timeouts);
+        for (int i = 0; i < NUM_BINS; ++i) {
+            if (histogram[i] == 0) continue;
+            printf("LOG:Latency %5lu-%5lu us: %lu\n", (unsigned long)(i * BIN_US),
+                   (unsigned long)((i + 1) * BIN_US), (unsigned long)histogram[i]);
+        }
+        fflush(stdout);
+    }
+
+    // === Core 1 interface ===
+    bool isWaitingForSample() const { return in_flight && first_sample_frame < 0; }
+
+    bool hasFirstSample() const { return in_flight && first_sample_frame >= 0; }
+
+    void markFirstSample(int frame) { first_sample_frame = frame; }
+
+    // Called by the output driver after a block was rendered; block_output_us is the DAC time of frame 0
+    void complete(uint32_t block_output_us, uint32_t us_per_frame_q8) {
+        if (!in_flight || first_sample_frame < 0) return;
+
+        uint32_t output_us = block_output_us + (((uint32_t)first_sample_frame * us_per_frame_q8) >> 8);
+        uint32_t latency = output_us - receive_us;
+
+        int bin = (int)(latency / BIN_US);
+        histogram[bin < NUM_BINS ? bin : NUM_BINS - 1]++;
+        count++;
+        sum_us += latency;
+        if (latency < min_us) min_us = latency;
+        if (latency > max_us) max_us = latency;
+
+        __dmb();
+        in_flight = false;
+    }
+
+private:
+    // Upper edge of the bin containing the given percentile
+    uint32_t percentile(uint32_t percent) const {
+        uint32_t target = (count * percent + 99) / 100;
+        uint32_t seen = 0;
+        for (int i = 0; i < NUM_BINS; ++i) {
+            seen += histogram[i];
+            if (seen >= target) return (uint32_t)(i + 1) * BIN_US;
+        }
+        return max_us;
+    }
+
+    volatile bool in_flight = false;
+    volatile uint32_t receive_us = 0;
+    volatile int first_sample_frame = -1;
+
+    // Written by Core 1, read by Core 0 for reports (diagnostic, not synchronized)
+    uint32_t histogram[NUM_BINS] = {};
+    uint32_t count = 0;
+    uint64_t sum_us = 0;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint32_t timeouts = 0;
+};
+
+// Single probe shared between the cores
+inline LatencyProbe g_latency_probe;
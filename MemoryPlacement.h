@@ -0,0 +1,35 @@
+/**
+ * MemoryPlacement.h - Puts the audio path's code and data in SRAM on the Pico
+ *
+ * Code and const data in flash run through the XIP cache, which both cores
+ * share. A miss stalls the core for a QSPI fetch, and a flash write or erase
+ * from Core 0 stalls XIP completely. Core 1's block render should not depend
+ * on either, so:
+ * - AUDIO_RAM_FUNC(name): function runs from SRAM (the SDK's __not_in_flash_func).
+ *   Use it on the per-sample, per-block and IRQ code of Core 1, including the note,
+ *   allocator, sequencer and arpeggiator paths the block runs. Anything such a
+ *   function calls without inlining it stays where it is; the SDK's float routines
+ *   (expf, sinf...) are built into SRAM with PICO_FLOAT_IN_RAM for that reason.
+ * - AUDIO_RAM_DATA("group"): const tables read per sample are copied to SRAM at boot.
+ * - AUDIO_CORE1_DATA("group"): small buffers that only Core 1 and its DMA touch
+ *   go in SCRATCH_X, the 4 KB bank that already holds Core 1's stack. About 2 KB
+ *   of it is free, so only block buffers go there. Voice state stays in the
+ *   striped main SRAM, and sample PCM stays in flash (Fix15SamplePlayer.h).
+ *
+ * The memory_report.cmake post-build step lists where these symbols landed.
+ * On the host the macros expand to nothing, so DSP headers stay SDK-free.
+ */
+
+#pragma once
+
+#if PICO_ON_DEVICE
+#include "pico/platform.h"
+
+#define AUDIO_RAM_FUNC(name) __not_in_flash_func(name)
+#define AUDIO_RAM_DATA(group) __not_in_flash(group)
+#define AUDIO_CORE1_DATA(group) __scratch_x(group)
+#else
+#define AUDIO_RAM_FUNC(name) name
+#define AUDIO_RAM_DATA(group)
+#define AUDIO_CORE1_DATA(group)
+#endif
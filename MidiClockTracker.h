@@ -0,0 +1,126 @@
+/**
+ * MidiClockTracker.h - Phase-locked tempo estimate from MIDI clock ticks
+ *
+ * MIDI clock (0xF8, 24 ticks per quarter note) reaches the Pico through USB
+ * serial, which delivers bytes in bursts, so single tick intervals jitter by a
+ * millisecond or more. A second-order PLL predicts the next tick time and
+ * corrects phase and period by fixed fractions of the prediction error, which
+ * averages the jitter out while still following tempo changes:
+ *
+ *   error  = arrival - predicted
+ *   period += error * BETA
+ *   next   = predicted + error * ALPHA + period
+ *
+ * Wider gains during acquisition get close quickly, then narrower ones keep
+ * the estimate steady. Single late bursts are clamped; several large errors in
+ * a row mean the tempo jumped, and the loop re-seeds from the last interval.
+ * Times are microseconds in Q16, integer only. No Pico SDK dependencies.
+ *
+ * Core 0 owns the tracker and publishes the locked period in samples per tick
+ * (g_midi_clock_samples_per_tick_q16, 0 = no external clock) for Core 1.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class MidiClockTracker {
+public:
+    static constexpr int TICKS_PER_BEAT = 24;
+    static constexpr int64_t MIN_TICK_US = 8333;       // 300 BPM
+    static constexpr int64_t MAX_TICK_US = 125000;     // 20 BPM
+    static constexpr uint32_t LOCK_TICKS = 24;         // One beat of consistent ticks
+    static constexpr int ACQUIRE_ALPHA_SHIFT = 2, ACQUIRE_BETA_SHIFT = 4;
+    static constexpr int TRACK_ALPHA_SHIFT = 3, TRACK_BETA_SHIFT = 6;
+    static constexpr int RESEED_OUTLIERS = 4;          // Consecutive large errors before re-seeding
+
+    void reset() {
+        ticks = 0;
+        outliers = 0;
+        locked = false;
+    }
+
+    // One 0xF8 arrived at time_us
+    void tick(uint64_t time_us) {
+        int64_t now_q16 = (int64_t)(time_us << 16);
+        if (ticks > 0 && time_us - last_tick_us > (uint64_t)MAX_TICK_US * 2) reset();  // Clock paused
+
+        if (ticks == 0) {
+            ticks = 1;
+        } else if (ticks == 1) {
+            seed(now_q16 - ((int64_t)last_tick_us << 16), now_q16);
+        } else {
+            int64_t error = now_q16 - next_q16;
+            int64_t limit = period_q16 >> 1;
+            if (error > limit || error < -limit) {
+                if (++outliers >= RESEED_OUTLIERS) {
+                    seed(now_q16 - ((int64_t)last_tick_us << 16), now_q16);
+                    last_tick_us = time_us;
+                    return;
+                }
+                error = error > 0 ? limit >> 1 : -(limit >> 1);    // A late burst, not a tempo change
+            } else {
+                outliers = 0;
+            }
+
+            bool acquiring = ticks < LOCK_TICKS;
+            int alpha = acquiring ? ACQUIRE_ALPHA_SHIFT : TRACK_ALPHA_SHIFT;
+            int beta = acquiring ? ACQUIRE_BETA_SHIFT : TRACK_BETA_SHIFT;
+            period_q16 = clampPeriod(period_q16 + (error >> beta));
+            next_q16 += (error >> alpha) + period_q16;
+            last_error_q16 = error;
+            if (ticks < LOCK_TICKS) ticks++;
+            else locked = true;
+        }
+        last_tick_us = time_us;
+    }
+
+    // Drops the lock when the clock has stopped; returns true when it just did
+    bool checkTimeout(uint64_t now_us) {
+        if (ticks == 0 || now_us - last_tick_us < (uint64_t)MAX_TICK_US * 2) return false;
+        bool was_locked = locked;
+        reset();
+        return was_locked;
+    }
+
+    bool isLocked() const { return locked; }
+    int64_t tickPeriodUsQ16() const { return period_q16; }
+    int32_t lastErrorUs() const { return (int32_t)(last_error_q16 >> 16); }
+
+    float bpm() const {
+        return period_q16 > 0 ? 60.0e6f * 65536.0f / ((float)period_q16 * TICKS_PER_BEAT) : 0.0f;
+    }
+
+    // Period in audio samples, Q16 (what Core 1 schedules with)
+    uint32_t samplesPerTickQ16(uint32_t sample_rate) const {
+        return (uint32_t)(((uint64_t)period_q16 * sample_rate) / 1000000u);
+    }
+
+private:
+    void seed(int64_t interval_q16, int64_t now_q16) {
+        period_q16 = clampPeriod(interval_q16);
+        next_q16 = now_q16 + period_q16;
+        last_error_q16 = 0;
+        outliers = 0;
+        ticks = 2;
+        locked = false;
+    }
+
+    static int64_t clampPeriod(int64_t period) {
+        if (period < (MIN_TICK_US << 16)) return MIN_TICK_US << 16;
+        if (period > (MAX_TICK_US << 16)) return MAX_TICK_US << 16;
+        return period;
+    }
+
+    int64_t period_q16 = 0;     // Estimated tick period, microseconds Q16
+    int64_t next_q16 = 0;       // Predicted arrival of the next tick
+    int64_t last_error_q16 = 0;
+    uint64_t last_tick_us = 0;
+    uint32_t ticks = 0;         // Ticks since (re)seeding, saturates at LOCK_TICKS
+    int outliers = 0;
+    bool locked = false;
+};
+
+// External clock period in samples per MIDI tick (Q16) while locked, 0 when free running.
+// One 32-bit store, so Core 1 reads it without a handshake.
+inline volatile uint32_t g_midi_clock_samples_per_tick_q16 = 0;
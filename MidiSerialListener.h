@@ -6,12 +6,29 @@
  * 2. ASCII commands (text protocol) from the HTML control interface
  * 
  * MIDI Protocol Support:
- * - Note On/Off messages: Forwarded to audio thread via multicore FIFO
- * - Continuous Controller (CC): Updates global parameter store
+ * - Note On/Off and Pitch Bend messages: Forwarded to audio thread via multicore FIFO with their
+ *   channel; Core 1 plays them on every part listening there (PartBank.h)
+ * - Real-time messages (may arrive between any bytes): clock ticks are timestamped and
+ *   tracked by a PLL (MidiClockTracker.h) that sets the sequencer/arpeggiator tempo while
+ *   locked; Start/Continue/Stop drive the step sequencer transport
+ * - Continuous Controller (CC): Updates global parameters, and per-part parameters of the parts
+ *   listening on the message's channel
  * - Automatic MIDI CC to parameter mapping via parameter CC numbers
  * 
  * ASCII Command Support:
  * - "SYNC_KNOBS": Sends all parameter definitions and values to HTML UI
+ * - "SCREEN:WAVEFORM" / "SCREEN:SPECTRUM" / "SCREEN:PERF": Selects the OLED home screen
+ * - "TLM_RATE:<hz>": Streams binary telemetry frames at the given rate (0 = off)
+ * - "TRACE_DUMP": Prints the per-core event trace rings (see TraceRing.h)
+ * - "LATENCY_REPORT" / "LATENCY_RESET": Note latency distribution (see LatencyProbe.h)
+ * - "MIDI_CLOCK": Reports external clock lock, tempo and last phase error
+ * - "VOICE_POLICY:<oldest|quietest>[,stack][,low][,high]": Voice stealing policy (see VoiceAllocator.h)
+ * - "PART:<part>,<channel 1-16|omni|off>[,<max voices>]": Binds a multitimbral part to a channel
+ * - "PART_EDIT:<part>": Part the knobs, OLED and SYNC_KNOBS address; "PARTS" lists the parts
+ * - "DRUM_CHANNEL:<1-16|off>": MIDI channel played by the drum kit instead of the parts (DrumModule.h)
+ * - "SAMPLE_PREFETCH:<0|1>": Per-block SRAM staging of flash samples (see Fix15SamplePlayer.h)
+ * - "SEQ_...": Step sequencer transport and pattern edits (see handleSequencerCommand, StepSequencer.h);
+ *   the playing step is reported back as "SEQ_POS:<step>"
  * - Line-based protocol (commands end with \n or \r)
  * 
  * Threading Model:
@@ -23,15 +40,26 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "ParameterStore.h"
+#include "SynthScreens.h"
+#include "TelemetryStreamer.h"
+#include "TraceRing.h"
+#include "LatencyProbe.h"
+#include "VoiceAllocator.h"
+#include "StepSequencer.h"
+#include "MidiClockTracker.h"
+#include "SampleBank.h"
+#include "DrumModule.h"
 
 // MIDI command types for inter-core communication
-enum MidiCommandType { NOTE_OFF_CMD = 0x80, NOTE_ON_CMD = 0x90, ALL_NOTES_OFF_CMD = 0xB0 };
+enum MidiCommandType { NOTE_OFF_CMD = 0x80, NOTE_ON_CMD = 0x90, ALL_NOTES_OFF_CMD = 0xB0, PITCH_BEND_CMD = 0xE0 };
 
 /**
  * Dual-protocol serial interface handler
@@ -44,7 +72,8 @@ enum MidiCommandType { NOTE_OFF_CMD = 0x80, NOTE_ON_CMD = 0x90, ALL_NOTES_OFF_CM
  */
 class MidiSerialListener {
 public:
-    MidiSerialListener() : ascii_pos(0), last_midi_activity_(0) {}
+    explicit MidiSerialListener(uint32_t sample_rate = 44100)
+    : ascii_pos(0), last_midi_activity_(0), sample_rate_(sample_rate) {}
     
     /**
      * Check if MIDI activity occurred recently (for prioritization)
@@ -67,10 +96,15 @@ public:
      * - ASCII: Regular text characters (0x00-0x7F) for commands
      */
     void update() {
+        reportSequencerPosition();
+        g_sequencer_pattern.publish();  // Retries an edit Core 1 was not ready for
+        checkMidiClock();
         int c = getchar_timeout_us(0);
         if (c == PICO_ERROR_TIMEOUT) return;
-        if (c & 0x80) {
-            int data1 = getchar(); int data2 = getchar();
+        if (c >= 0xF8) {
+            handleRealtime((uint8_t)c, time_us_64());
+        } else if (c & 0x80) {
+            int data1 = readDataByte(); int data2 = readDataByte();
             if (data1 != PICO_ERROR_TIMEOUT && data2 != PICO_ERROR_TIMEOUT) {
                 last_midi_activity_ = to_ms_since_boot(get_absolute_time());
                 handleMidiMessage(c, data1, data2);
@@ -90,14 +124,64 @@ public:
     }
 
 private:
+    // Next data byte of a message; real-time bytes in between are handled on the way
+    int readDataByte() {
+        while (true) {
+            int b = getchar_timeout_us(MIDI_DATA_TIMEOUT_US);
+            if (b == PICO_ERROR_TIMEOUT || b < 0xF8) return b;
+            handleRealtime((uint8_t)b, time_us_64());
+        }
+    }
+
+    // Single-byte system real-time messages
+    void handleRealtime(uint8_t status, uint64_t time_us) {
+        switch (status) {
+        case 0xF8: {    // Timing clock, 24 per quarter note
+            bool was_locked = midi_clock.isLocked();
+            midi_clock.tick(time_us);
+            g_midi_clock_samples_per_tick_q16 = midi_clock.isLocked() ? midi_clock.samplesPerTickQ16(sample_rate_) : 0;
+            if (midi_clock.isLocked() && !was_locked) printf("LOG:MIDI clock locked at %.1f BPM\n", midi_clock.bpm());
+            break;
+        }
+        case 0xFA:      // Start: the sequencer plays from step 1
+            g_sequencer_reset_requests = g_sequencer_reset_requests + 1;
+            g_sequencer_running = true;
+            break;
+        case 0xFB:      // Continue
+            g_sequencer_running = true;
+            break;
+        case 0xFC:      // Stop
+            g_sequencer_running = false;
+            break;
+        default:        // Active sensing and reset are ignored
+            break;
+        }
+    }
+
+    // The tempo falls back to the Tempo parameter when clock ticks stop
+    void checkMidiClock() {
+        if (midi_clock.checkTimeout(time_us_64())) {
+            g_midi_clock_samples_per_tick_q16 = 0;
+            printf("LOG:MIDI clock stopped\n");
+        }
+    }
+
     void handleMidiMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+        traceEvent(TraceEvent::MIDI_RECEIVE, (uint32_t)(status << 16) | (data1 << 8) | data2);
         uint8_t command = status & 0xF0;
-        if (command == 0x90 && data2 > 0) sendNoteToCore1(NOTE_ON_CMD, data1, data2);
-        else if (command == 0x80 || (command == 0x90 && data2 == 0)) sendNoteToCore1(NOTE_OFF_CMD, data1, data2);
+        uint8_t channel = status & 0x0F;
+        if (command == 0x90 && data2 > 0) {
+            // Note-ons on the probe channel are timed end to end
+            uint8_t flags = (channel == LatencyProbe::PROBE_CHANNEL && g_latency_probe.begin())
+                            ? LatencyProbe::PACKET_FLAG : 0;
+            sendNoteToCore1(NOTE_ON_CMD, data1, data2, channel, flags);
+        }
+        else if (command == 0x80 || (command == 0x90 && data2 == 0)) sendNoteToCore1(NOTE_OFF_CMD, data1, data2, channel);
+        else if (command == 0xE0) sendNoteToCore1(PITCH_BEND_CMD, data1, data2, channel); // Pitch is per voice, so Core 1 applies it
         else if (command == 0xB0) {
             // Handle All Notes Off (CC 123)
             if (data1 == 123) {
-                sendAllNotesOffToCore1();
+                sendAllNotesOffToCore1(channel);
                 printf("LOG:All Notes Off\n");
                 fflush(stdout);
                 return;
@@ -106,9 +190,10 @@ private:
             
             // Process all CC changes - even single value changes are important
             
-            for (auto* p : g_synth_parameters) {
-                if (p->getCcNumber() == data1) {
-                    p->setNormalizedValue(data2 / 127.0f);
+            for (auto& p : g_synth_parameters) {
+                if (p.getCcNumber() == data1) {
+                    setFromController(&p, channel, data2 / 127.0f);
+                    g_parameter_change_count++;
                     // STATE feedback removed - was causing lag and feedback loops
                     break;
                 }
@@ -116,35 +201,236 @@ private:
         }
     }
 
+    // A global parameter takes every CC; a per-part one goes to the parts listening on the channel
+    void setFromController(Parameter* p, uint8_t channel, float norm) {
+        if (!p->isPartParameter()) {
+            p->setNormalizedValue(norm);
+            return;
+        }
+        for (int part = 0; part < MAX_PARTS; ++part) {
+            if (g_part_config[part].listensTo(channel)) p->setNormalizedValue(norm, part);
+        }
+    }
+
     void handleAsciiCommand(const char* buffer) {
         if (strcmp(buffer, "SYNC_KNOBS") == 0) {
             printf("KNOB_UPDATE_START\n");
             // 1. Send all the definitions
-            for (const auto* p : g_synth_parameters) {
-                printf("CC_DEF:%d:%s\n", p->getCcNumber(), p->getName().c_str());
+            for (const auto& p : g_synth_parameters) {
+                printf("CC_DEF:%d:%s\n", p.getCcNumber(), p.getName());
             }
             // *** NEW FEATURE: Send all the current values ***
-            for (const auto* p : g_synth_parameters) {
-                printf("STATE:%d:%.3f\n", p->getCcNumber(), p->getNormalizedValue());
+            for (const auto& p : g_synth_parameters) {
+                printf("STATE:%d:%.3f\n", p.getCcNumber(), p.getNormalizedValue());
             }
             printf("KNOB_UPDATE_END\n");
             fflush(stdout);
+        } else if (strcmp(buffer, "SCREEN:WAVEFORM") == 0) {
+            setSynthHomeScreen(SynthScreen::WAVEFORM);
+        } else if (strcmp(buffer, "SCREEN:SPECTRUM") == 0) {
+            setSynthHomeScreen(SynthScreen::SPECTRUM);
+        } else if (strcmp(buffer, "SCREEN:PERF") == 0) {
+            setSynthHomeScreen(SynthScreen::PERFORMANCE);
+        } else if (strcmp(buffer, "LATENCY_REPORT") == 0) {
+            g_latency_probe.report();
+        } else if (strcmp(buffer, "LATENCY_RESET") == 0) {
+            g_latency_probe.reset();
+            printf("LOG:Latency statistics cleared\n");
+        } else if (strcmp(buffer, "TRACE_DUMP") == 0) {
+            dumpTraceRings();
+        } else if (strcmp(buffer, "MIDI_CLOCK") == 0) {
+            printf("LOG:MIDI clock %s, %.2f BPM, last phase error %ld us\n", midi_clock.isLocked() ? "locked" : "not locked",
+                   midi_clock.bpm(), (long)midi_clock.lastErrorUs());
+        } else if (strncmp(buffer, "VOICE_POLICY:", 13) == 0) {
+            setVoicePolicy(buffer + 13);
+        } else if (strncmp(buffer, "PART:", 5) == 0) {
+            setPart(buffer + 5);
+        } else if (strncmp(buffer, "PART_EDIT:", 10) == 0) {
+            setEditPart(atoi(buffer + 10));
+        } else if (strcmp(buffer, "PARTS") == 0) {
+            reportParts();
+        } else if (strncmp(buffer, "DRUM_CHANNEL:", 13) == 0) {
+            setDrumChannel(buffer + 13);
+        } else if (strncmp(buffer, "SAMPLE_PREFETCH:", 16) == 0) {
+            g_sample_prefetch = atoi(buffer + 16) != 0;
+            printf("LOG:Sample prefetch %s\n", g_sample_prefetch ? "on" : "off");
+        } else if (strncmp(buffer, "SEQ_", 4) == 0) {
+            handleSequencerCommand(buffer + 4);
+        } else if (strncmp(buffer, "TLM_RATE:", 9) == 0) {
+            g_telemetry_streamer.setRate((uint32_t)atoi(buffer + 9));
+            printf("LOG:Telemetry rate %lu Hz\n", (unsigned long)g_telemetry_streamer.getRate());
         } else {
             printf("LOG:Received ASCII Command: %s\n", buffer);
         }
     }
 
-    void sendNoteToCore1(uint8_t command, uint8_t data1, uint8_t data2) {
-        uint32_t packet = (command << 24) | (data1 << 16) | (data2 << 8);
+    // Comma separated: steal mode first, then "stack" (new voice per repeated note), "low"/"high" protection
+    void setVoicePolicy(const char* spec) {
+        VoiceAllocator::Policy policy;
+        char options[48];
+        strncpy(options, spec, sizeof(options) - 1);
+        options[sizeof(options) - 1] = '\0';
+        for (char* token = strtok(options, ","); token; token = strtok(nullptr, ",")) {
+            if (strcmp(token, "quietest") == 0) policy.steal = VoiceAllocator::StealMode::QUIETEST;
+            else if (strcmp(token, "oldest") == 0) policy.steal = VoiceAllocator::StealMode::OLDEST;
+            else if (strcmp(token, "stack") == 0) policy.retrigger_same_note = false;
+            else if (strcmp(token, "low") == 0) policy.protect_lowest = true;
+            else if (strcmp(token, "high") == 0) policy.protect_highest = true;
+            else printf("LOG:Unknown voice policy option %s\n", token);
+        }
+        g_voice_policy = policy.pack();
+        printf("LOG:Voice policy %s%s%s%s\n", policy.steal == VoiceAllocator::StealMode::QUIETEST ? "quietest" : "oldest",
+               policy.retrigger_same_note ? "" : ", stacked notes", policy.protect_lowest ? ", lowest protected" : "",
+               policy.protect_highest ? ", highest protected" : "");
+    }
+
+    // 1-16 or "off"; Core 1 checks the channel of every packet, so the switch takes effect at once
+    void setDrumChannel(const char* spec) {
+        int channel = atoi(spec);
+        if (strcmp(spec, "off") == 0) {
+            g_drum_channel = -1;
+            printf("LOG:Drums off\n");
+        } else if (channel >= 1 && channel <= 16) {
+            g_drum_channel = (int8_t)(channel - 1);
+            printf("LOG:Drums on channel %d\n", channel);
+        } else {
+            printf("LOG:Usage DRUM_CHANNEL:<1-16|off>\n");
+        }
+    }
+
+    // <part>,<channel 1-16|omni|off>[,<max voices>]; Core 1 releases the part's notes on a channel change
+    void setPart(const char* spec) {
+        int part = -1, max_voices = 0;
+        char channel[8] = {};
+        if (sscanf(spec, "%d,%7[^,],%d", &part, channel, &max_voices) < 2 || part < 0 || part >= MAX_PARTS) {
+            printf("LOG:Usage PART:<part 0-%d>,<channel 1-16|omni|off>[,<max voices>]\n", MAX_PARTS - 1);
+            return;
+        }
+        int8_t value;
+        if (strcmp(channel, "omni") == 0) value = PartConfig::OMNI;
+        else if (strcmp(channel, "off") == 0) value = PartConfig::OFF;
+        else if (atoi(channel) >= 1 && atoi(channel) <= 16) value = (int8_t)(atoi(channel) - 1);
+        else {
+            printf("LOG:Unknown part channel %s\n", channel);
+            return;
+        }
+        g_part_config[part].max_voices = (uint8_t)std::max(0, std::min(max_voices, 255));
+        g_part_config[part].channel = value;
+        reportParts();
+    }
+
+    // Switches the knobs to another part and sends its values (same lines as SYNC_KNOBS)
+    void setEditPart(int part) {
+        if (part < 0 || part >= MAX_PARTS) return;
+        g_edit_part = (uint8_t)part;
+        printf("LOG:Editing part %d\n", part);
+        for (const auto& p : g_synth_parameters) {
+            if (p.isPartParameter()) printf("STATE:%d:%.3f\n", p.getCcNumber(), p.getNormalizedValue());
+        }
+        fflush(stdout);
+    }
+
+    void reportParts() {
+        for (int part = 0; part < MAX_PARTS; ++part) {
+            int8_t channel = g_part_config[part].channel;
+            char name[8];
+            if (channel == PartConfig::OMNI) strcpy(name, "omni");
+            else if (channel == PartConfig::OFF) strcpy(name, "off");
+            else snprintf(name, sizeof(name), "%d", channel + 1);
+            printf("PART:%d,%s,%d%s\n", part, name, g_part_config[part].max_voices, part == g_edit_part ? ",edit" : "");
+        }
+        fflush(stdout);
+    }
+
+    // Sequencer commands (after the "SEQ_" prefix). Each edit is published whole; Core 1 picks it up
+    // at the start of its next block.
+    //   PLAY, STOP, RESET (back to step 1), CLEAR (all steps to rest)
+    //   TEMPO:<bpm>, SWING:<percent>, LENGTH:<steps>, TRACKS:<count>
+    //   TRACK:<track>,<note>,<gate ms>,<chance %>[,<channel 1-16>]
+    //   STEP:<track>,<step>,<velocity>[,<chance %>]
+    //   PATTERN:<track>,<32 hex digits>       all 16 step velocities of a track at once
+    void handleSequencerCommand(const char* command) {
+        SequencerPattern& pattern = g_sequencer_pattern.edit();
+        int a = 0, b = 0, c = 0, d = -1, e = 0;
+
+        if (strcmp(command, "PLAY") == 0) {
+            g_sequencer_running = true;
+        } else if (strcmp(command, "STOP") == 0) {
+            g_sequencer_running = false;
+        } else if (strcmp(command, "RESET") == 0) {
+            g_sequencer_reset_requests = g_sequencer_reset_requests + 1;
+        } else if (strcmp(command, "CLEAR") == 0) {
+            for (auto& track : pattern.tracks) {
+                for (int s = 0; s < SequencerTrack::NUM_STEPS; ++s) track.velocity[s] = 0;
+            }
+        } else if (sscanf(command, "TEMPO:%d", &a) == 1) {
+            setParameterValue("seqTempo", (float)a);
+        } else if (sscanf(command, "SWING:%d", &a) == 1) {
+            setParameterValue("seqSwing", a / 100.0f);
+        } else if (sscanf(command, "LENGTH:%d", &a) == 1 && a >= 1 && a <= SequencerTrack::NUM_STEPS) {
+            pattern.length = (uint8_t)a;
+        } else if (sscanf(command, "TRACKS:%d", &a) == 1 && a >= 0 && a <= SequencerPattern::MAX_TRACKS) {
+            pattern.num_tracks = (uint8_t)a;
+        } else if (sscanf(command, "TRACK:%d,%d,%d,%d,%d", &a, &b, &c, &d, &e) >= 4 && a >= 0 &&
+                   a < SequencerPattern::MAX_TRACKS) {
+            SequencerTrack& track = pattern.tracks[a];
+            track.note = (uint8_t)(b & 0x7F);
+            track.gate_ms = (uint16_t)std::max(1, std::min(c, 10000));
+            track.chance = (uint8_t)std::max(0, std::min(d, 100));
+            if (e >= 1 && e <= 16) track.channel = (uint8_t)(e - 1);
+            if (a >= pattern.num_tracks) pattern.num_tracks = (uint8_t)(a + 1);
+        } else if (sscanf(command, "STEP:%d,%d,%d,%d", &a, &b, &c, &d) >= 3 && a >= 0 &&
+                   a < SequencerPattern::MAX_TRACKS && b >= 0 && b < SequencerTrack::NUM_STEPS) {
+            pattern.tracks[a].velocity[b] = (uint8_t)(c & 0x7F);
+            if (d >= 0) pattern.tracks[a].step_chance[b] = (uint8_t)std::min(d, 100);
+        } else if (strncmp(command, "PATTERN:", 8) == 0 && sscanf(command + 8, "%d,", &a) == 1 &&
+                   a >= 0 && a < SequencerPattern::MAX_TRACKS && strchr(command, ',')) {
+            const char* hex = strchr(command, ',') + 1;
+            for (int s = 0; s < SequencerTrack::NUM_STEPS && hex[0] && hex[1]; ++s, hex += 2) {
+                char byte[3] = {hex[0], hex[1], '\0'};
+                pattern.tracks[a].velocity[s] = (uint8_t)(strtol(byte, nullptr, 16) & 0x7F);
+            }
+        } else {
+            printf("LOG:Unknown sequencer command SEQ_%s\n", command);
+        }
+        g_sequencer_pattern.publish();
+    }
+
+    void setParameterValue(const char* id, float value) {
+        for (auto& p : g_synth_parameters) {
+            if (p.getID() == id) {
+                p.setValue(value);
+                g_parameter_change_count++;
+                printf("STATE:%d:%.3f\n", p.getCcNumber(), p.getNormalizedValue());
+                return;
+            }
+        }
+    }
+
+    // SEQ_POS:<step> whenever the audio core has moved the sequencer on (the HTML highlights it)
+    void reportSequencerPosition() {
+        int8_t position = g_sequencer_position;
+        if (position == reported_sequencer_position) return;
+        reported_sequencer_position = position;
+        printf("SEQ_POS:%d\n", position);
+    }
+
+    // The low byte carries the channel in bits 4-7 and flags (LatencyProbe::PACKET_FLAG) in bits 0-3
+    void sendNoteToCore1(uint8_t command, uint8_t data1, uint8_t data2, uint8_t channel, uint8_t flags = 0) {
+        uint32_t packet = (command << 24) | (data1 << 16) | (data2 << 8) | ((channel & 0x0F) << 4) | flags;
         multicore_fifo_push_blocking(packet);
     }
     
-    void sendAllNotesOffToCore1() {
-        uint32_t packet = (ALL_NOTES_OFF_CMD << 24) | (123 << 16) | (0 << 8);
+    void sendAllNotesOffToCore1(uint8_t channel) {
+        uint32_t packet = (ALL_NOTES_OFF_CMD << 24) | (123 << 16) | (0 << 8) | ((channel & 0x0F) << 4);
         multicore_fifo_push_blocking(packet);
     }
 
     char ascii_buffer[64];
     int ascii_pos;
     uint32_t last_midi_activity_;
+    uint32_t sample_rate_;
+    MidiClockTracker midi_clock;
+    int8_t reported_sequencer_position = -1;
+    static constexpr uint32_t MIDI_DATA_TIMEOUT_US = 2000;     // A status byte's data arrives in the same USB packet
 };
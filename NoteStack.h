@@ -0,0 +1,61 @@
+/**
+ * NoteStack.h - Held-note stack for monophonic note priority
+ *
+ * Remembers the keys currently down in press order so a mono voice can return
+ * to a still-held note when the sounding one is released, like the SH-101's
+ * keyboard. The sounding note is chosen by priority: the last pressed, the
+ * lowest or the highest held key. No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+class NoteStack {
+public:
+    static constexpr int CAPACITY = 16;     // Oldest key is forgotten beyond this
+    static constexpr int NONE = -1;
+
+    enum class Priority : uint8_t { LAST, LOW, HIGH };
+
+    void clear() { count = 0; }
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    uint8_t at(int index) const { return notes[index]; }   // Press order, 0 = oldest
+
+    void push(uint8_t note) {
+        remove(note);   // A key pressed again moves to the top
+        if (count >= CAPACITY) {
+            memmove(notes, notes + 1, CAPACITY - 1);
+            count = CAPACITY - 1;
+        }
+        notes[count++] = note;
+    }
+
+    // Returns false if the note was not held
+    bool remove(uint8_t note) {
+        for (int i = 0; i < count; ++i) {
+            if (notes[i] != note) continue;
+            for (int j = i + 1; j < count; ++j) notes[j - 1] = notes[j];
+            count--;
+            return true;
+        }
+        return false;
+    }
+
+    // The note that should sound, or NONE when no key is down
+    int select(Priority priority) const {
+        if (count == 0) return NONE;
+        int selected = notes[count - 1];
+        if (priority == Priority::LAST) return selected;
+        for (int i = 0; i < count - 1; ++i) {
+            if (priority == Priority::LOW ? notes[i] < selected : notes[i] > selected) selected = notes[i];
+        }
+        return selected;
+    }
+
+private:
+    uint8_t notes[CAPACITY] = {};
+    uint8_t count = 0;
+};
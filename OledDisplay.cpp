@@ -45,7 +45,10 @@ bool OledDisplay::init() {
     gpio_pull_up(sda_pin_);
     gpio_pull_up(scl_pin_);
     
-    sleep_ms(100);
+    // Counted from boot, so a display brought up late in the boot sequence does not wait at all
+    while (to_ms_since_boot(get_absolute_time()) < POWER_UP_MS) {
+        tight_loop_contents();
+    }
     
     uint8_t init_cmds[] = {
         SSD1306_SET_DISP,               // display off
@@ -85,7 +88,7 @@ bool OledDisplay::init() {
     
     initialized_ = true;
     clear();
-    display();
+    displayAsync();
     
     return true;
 }
@@ -96,6 +99,9 @@ void OledDisplay::clear() {
 
 void OledDisplay::display() {
     if (!initialized_) return;
+    while (isDisplayBusy()) {
+        tight_loop_contents();
+    }
     
     uint8_t cmds[] = {
         SSD1306_SET_COL_ADDR, 0, SCREEN_WIDTH - 1,
@@ -110,21 +116,37 @@ void OledDisplay::display() {
 }
 
 bool OledDisplay::displayAsync() {
-    if (!initialized_ || display_busy_) return false;
+    return displayRegionAsync(0, SCREEN_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+}
+
+bool OledDisplay::displayRegionAsync(int x0, int x1, int page0, int page1) {
+    if (!initialized_ || isDisplayBusy()) return false;
+    
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, SCREEN_WIDTH - 1);
+    page0 = std::max(page0, 0);
+    page1 = std::min(page1, SSD1306_NUM_PAGES - 1);
+    if (x1 < x0 || page1 < page0) return true; // Nothing to send
     
-    // Set up display area commands (blocking - very fast)
+    // Set up display window commands (blocking - very fast)
     uint8_t cmds[] = {
-        SSD1306_SET_COL_ADDR, 0, SCREEN_WIDTH - 1,
-        SSD1306_SET_PAGE_ADDR, 0, SSD1306_NUM_PAGES - 1
+        SSD1306_SET_COL_ADDR, (uint8_t)x0, (uint8_t)x1,
+        SSD1306_SET_PAGE_ADDR, (uint8_t)page0, (uint8_t)page1
     };
     
     for (uint8_t cmd : cmds) {
         sendCommand(cmd);
     }
     
-    // Prepare DMA buffer with data command prefix
+    // Prepare DMA buffer with data command prefix, then the window's bytes page by page
+    // (horizontal addressing mode wraps within the column window)
     dma_buffer_[0] = 0x40; // Data command
-    memcpy(dma_buffer_ + 1, buffer_, BUFFER_SIZE);
+    int width = x1 - x0 + 1;
+    int transfer_len = 1;
+    for (int page = page0; page <= page1; page++) {
+        memcpy(dma_buffer_ + transfer_len, buffer_ + page * SCREEN_WIDTH + x0, width);
+        transfer_len += width;
+    }
     
     // Configure DMA channel for I2C transfer
     dma_channel_config config = dma_channel_get_default_config(dma_chan_);
@@ -139,7 +161,7 @@ bool OledDisplay::displayAsync() {
         &config,
         &i2c0->hw->data_cmd, // Write to I2C data register
         dma_buffer_,
-        BUFFER_SIZE + 1,
+        transfer_len,
         true // Start immediately
     );
     
@@ -158,13 +180,14 @@ bool OledDisplay::isDisplayBusy() {
     return display_busy_;
 }
 
-void OledDisplay::writeText(const std::string& text, int16_t x, int16_t y) {
+void OledDisplay::writeText(const char* text, int16_t x, int16_t y) {
     if (!initialized_) return;
     
     int16_t current_x = x;
     int16_t current_y = y;
     
-    for (char c : text) {
+    for (const char* p = text; *p; ++p) {
+        char c = *p;
         if (c == '\n') {
             current_x = x;
             current_y += 8;
@@ -219,6 +242,74 @@ void OledDisplay::drawLine(int x0, int y0, int x1, int y1, bool on) {
     }
 }
 
+void OledDisplay::drawHLine(int x, int y, int w, bool on) {
+    if (y < 0 || y >= SCREEN_HEIGHT) return;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
+    if (w <= 0) return;
+    
+    // A horizontal span is one bit in each of w consecutive bytes of the same page
+    uint8_t* p = &buffer_[(y / 8) * SCREEN_WIDTH + x];
+    uint8_t bit_mask = 1 << (y % 8);
+    
+    if (on) {
+        for (int i = 0; i < w; i++) p[i] |= bit_mask;
+    } else {
+        for (int i = 0; i < w; i++) p[i] &= ~bit_mask;
+    }
+}
+
+void OledDisplay::drawVLine(int x, int y, int h, bool on) {
+    if (x < 0 || x >= SCREEN_WIDTH) return;
+    if (y < 0) { h += y; y = 0; }
+    if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+    if (h <= 0) return;
+    
+    // A vertical span touches one byte per page, with a contiguous bit mask in each
+    int y_end = y + h;
+    uint8_t* p = &buffer_[(y / 8) * SCREEN_WIDTH + x];
+    
+    while (y < y_end) {
+        int bit = y % 8;
+        int n = std::min(8 - bit, y_end - y);
+        uint8_t span_mask = (uint8_t)(((1u << n) - 1) << bit);
+        
+        if (on) {
+            *p |= span_mask;
+        } else {
+            *p &= ~span_mask;
+        }
+        
+        y += n;
+        p += SCREEN_WIDTH;
+    }
+}
+
+void OledDisplay::fillRect(int x, int y, int w, int h, bool on) {
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
+    if (y < 0) { h += y; y = 0; }
+    if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    
+    // Same page-mask approach as drawVLine, applied across the whole width per page
+    int y_end = y + h;
+    while (y < y_end) {
+        int bit = y % 8;
+        int n = std::min(8 - bit, y_end - y);
+        uint8_t span_mask = (uint8_t)(((1u << n) - 1) << bit);
+        uint8_t* p = &buffer_[(y / 8) * SCREEN_WIDTH + x];
+        
+        if (on) {
+            for (int i = 0; i < w; i++) p[i] |= span_mask;
+        } else {
+            for (int i = 0; i < w; i++) p[i] &= ~span_mask;
+        }
+        
+        y += n;
+    }
+}
+
 void OledDisplay::invertDisplay(bool invert) {
     if (!initialized_) return;
     sendCommand(invert ? SSD1306_SET_INV_DISP : SSD1306_SET_NORM_DISP);
@@ -293,16 +384,46 @@ void OledDisplay::writeChar(int16_t x, int16_t y, uint8_t ch) {
     }
 }
 
+// Boot screen display, set up on first use in static storage
 static OledDisplay* global_oled = nullptr;
+static bool boot_oled_finished = false;
 
-void writeToOled(const std::string& text, int16_t x, int16_t y) {
+static OledDisplay* bootOled() {
+    if (boot_oled_finished) return nullptr;
     if (!global_oled) {
-        global_oled = new OledDisplay();
+        static OledDisplay boot_display;
+        global_oled = &boot_display;
         global_oled->init();
     }
-    global_oled->clear();
-    global_oled->writeText(text, x, y);
-    global_oled->display();
+    return global_oled;
+}
+
+void writeToOled(const char* text, int16_t x, int16_t y) {
+    OledDisplay* oled = bootOled();
+    if (!oled) return;
+    oled->clear();
+    oled->writeText(text, x, y);
+    oled->display();
+}
+
+bool writeToOledAsync(const char* text, int16_t x, int16_t y) {
+    OledDisplay* oled = bootOled();
+    if (!oled) return true;
+    if (oled->isDisplayBusy()) return false;
+    oled->clear();
+    oled->writeText(text, x, y);
+    return oled->displayAsync();
+}
+
+// The screen manager drives the same I2C bus with its own OledDisplay
+void finishBootOled() {
+    if (global_oled) {
+        while (global_oled->isDisplayBusy()) {
+            tight_loop_contents();
+        }
+        global_oled = nullptr;
+    }
+    boot_oled_finished = true;
 }
 
 void clearOled() {
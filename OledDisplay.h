@@ -3,25 +3,31 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/dma.h"
-#include <string>
 
 class OledDisplay {
 public:
     static const int SCREEN_WIDTH = 128;
     static const int SCREEN_HEIGHT = 64;
     static const int BUFFER_SIZE = SCREEN_WIDTH * SCREEN_HEIGHT / 8;
+    static const uint32_t POWER_UP_MS = 100;  // SSD1306 start-up time after power-on
     
     OledDisplay(uint sda_pin = 4, uint scl_pin = 5, uint8_t i2c_addr = 0x3C);
     
-    bool init();
+    bool init();  // Waits only for what is left of POWER_UP_MS since boot
     void clear();
-    void display();
+    void display();  // Blocking; waits for a running DMA update first
     bool displayAsync();  // Non-blocking display update
+    bool displayRegionAsync(int x0, int x1, int page0, int page1); // Non-blocking partial update (inclusive)
     bool isDisplayBusy(); // Check if DMA transfer is in progress
-    void writeText(const std::string& text, int16_t x = 0, int16_t y = 0);
+    void writeText(const char* text, int16_t x = 0, int16_t y = 0);
     void setPixel(int x, int y, bool on = true);
     void drawLine(int x0, int y0, int x1, int y1, bool on = true);
     
+    // Clipped span fills that write whole framebuffer bytes (8 vertical pixels) at a time
+    void drawHLine(int x, int y, int w, bool on = true);
+    void drawVLine(int x, int y, int h, bool on = true);
+    void fillRect(int x, int y, int w, int h, bool on = true);
+    
     void invertDisplay(bool invert);
     void startScrolling();
     void stopScrolling();
@@ -43,7 +49,9 @@ private:
     void writeChar(int16_t x, int16_t y, uint8_t ch);
 };
 
-void writeToOled(const std::string& text, int16_t x = 0, int16_t y = 0);
+void writeToOled(const char* text, int16_t x = 0, int16_t y = 0);
+bool writeToOledAsync(const char* text, int16_t x = 0, int16_t y = 0);  // false while the last write is in flight
+void finishBootOled();  // Waits for the last boot screen write; later writes are dropped
 void clearOled();
 void invertOled(bool invert);
 void startScrollOled();
@@ -10,7 +10,8 @@
  * - MIDI CC number association for hardware/UI control
  * - Automatic range clamping and validation
  * - Normalized [0,1] interface for UI/MIDI (0-127) integration
- * - String ID system for parameter lookup
+ * - String ID system for parameter lookup (IDs and names are string literals, never copied)
+ * - Per-part values for multitimbral play (PartBank.h)
  * 
  * Thread Model:
  * - Control Thread: Updates parameters via setValue() or setNormalizedValue()
@@ -20,12 +21,13 @@
 
 #pragma once
 #include <atomic>
-#include <string>
+#include <string_view>
 #include <cassert>
 #include <algorithm>
+#include "PartBank.h"
 
 // Forward declaration
-void showSynthParameter(const std::string& name, float value);
+void showSynthParameter(std::string_view name, float value);
 /**
  * Thread-safe parameter class for real-time audio applications
  * 
@@ -45,23 +47,23 @@ class Parameter {
 public:
     /**
      * Construct a parameter with full specification
-     * @param id - Unique string identifier for parameter lookup
-     * @param name - Human-readable display name
+     * @param id - Unique string identifier for parameter lookup (static storage, e.g. a literal)
+     * @param name - Human-readable display name (static storage, e.g. a literal)
      * @param minValue - Minimum value in physical units
      * @param maxValue - Maximum value in physical units  
      * @param defaultValue - Initial value (will be clamped to range)
      * @param midiCcNumber - MIDI CC number (0-127) for hardware control
      */
-    Parameter(const std::string& id,
-              const std::string& name,
+    Parameter(const char* id,
+              const char* name,
               float minValue,
               float maxValue,
               float defaultValue,
               uint8_t midiCcNumber)
         : parameterID(id), displayName(name),
           minimum(minValue), maximum(maxValue),
-          value(defaultValue),
-          ccNumber(midiCcNumber)
+          ccNumber(midiCcNumber),
+          value(defaultValue)
     {
         assert(minValue < maxValue);
         // Clamp default value to valid range
@@ -69,25 +71,48 @@ public:
         if (defaultValue > maxValue) value.store(maxValue, std::memory_order_relaxed);
     }
 
+    /**
+     * Construct a per-part parameter: every part's bank slot starts at the default
+     * @param slot - Where the value lives in each PartBank
+     */
+    Parameter(const char* id,
+              const char* name,
+              float minValue,
+              float maxValue,
+              float defaultValue,
+              uint8_t midiCcNumber,
+              PartParam slot)
+        : Parameter(id, name, minValue, maxValue, defaultValue, midiCcNumber)
+    {
+        partSlot = (int8_t)slot;
+        for (auto& bank : g_part_banks) bank.set(slot, value.load(std::memory_order_relaxed));
+    }
+
     /**
      * Set parameter value in physical units (thread-safe)
      * Automatically clamps to [minimum, maximum] range
      * @param newValue - New value in physical units
+     * @param part - Part to set for per-part parameters (ignored by global ones)
      */
-    void setValue(float newValue) {
+    void setValue(float newValue, int part) {
         newValue = std::max(minimum, std::min(newValue, maximum));
-        value.store(newValue, std::memory_order_relaxed);
+        if (partSlot >= 0) g_part_banks[part].values[partSlot].store(newValue, std::memory_order_relaxed);
+        else value.store(newValue, std::memory_order_relaxed);
         // Screen update moved to setNormalizedValue() to avoid duplicate calls
     }
+    void setValue(float newValue) { setValue(newValue, g_edit_part); }
 
     /**
      * Get current parameter value in physical units (thread-safe)
      * Safe to call from audio thread - no blocking or locks
+     * @param part - Part to read for per-part parameters (ignored by global ones)
      * @return Current value in physical units
      */
-    float getValue() const {
+    float getValue(int part) const {
+        if (partSlot >= 0) return g_part_banks[part].values[partSlot].load(std::memory_order_relaxed);
         return value.load(std::memory_order_relaxed);
     }
+    float getValue() const { return getValue(g_edit_part); }
 
     /**
      * Get parameter value as normalized [0,1] value
@@ -103,10 +128,12 @@ public:
      * Converts normalized value to physical range
      * Used by MIDI CC (0-127 mapped to 0-1) and UI controls
      * @param norm - Normalized value [0,1] (will be clamped)
+     * @param part - Part to set for per-part parameters; only the edited part is shown on screen
      */
-    void setNormalizedValue(float norm) {
+    void setNormalizedValue(float norm, int part) {
         norm = std::max(0.0f, std::min(norm, 1.0f));
-        setValue(minimum + norm * (maximum - minimum));
+        setValue(minimum + norm * (maximum - minimum), part);
+        if (partSlot >= 0 && part != g_edit_part) return;
         
         // Skip screen updates during rapid parameter changes for better responsiveness
         static uint32_t last_screen_update = 0;
@@ -117,21 +144,24 @@ public:
             last_screen_update = now;
         }
     }
+    void setNormalizedValue(float norm) { setNormalizedValue(norm, g_edit_part); }
 
     // === Accessors for Parameter Metadata ===
-    const std::string& getID() const { return parameterID; }
-    const std::string& getName() const { return displayName; }
+    std::string_view getID() const { return parameterID; }
+    const char* getName() const { return displayName; }
     float getMinimum() const { return minimum; }
     float getMaximum() const { return maximum; }
     uint8_t getCcNumber() const { return ccNumber; }
+    bool isPartParameter() const { return partSlot >= 0; }
 
 private:
     // === Parameter Metadata ===
-    std::string parameterID;        // Unique identifier for parameter lookup
-    std::string displayName;        // Human-readable name for UI display
+    const char* parameterID;        // Unique identifier for parameter lookup
+    const char* displayName;        // Human-readable name for UI display
     float minimum, maximum;         // Physical value range boundaries
     uint8_t ccNumber;              // MIDI CC number for hardware control
+    int8_t partSlot = -1;          // PartParam index for per-part parameters, -1 = global
     
     // === Thread-Safe Value Storage ===
-    std::atomic<float> value;       // Current parameter value (lock-free atomic)
+    std::atomic<float> value;       // Current value of a global parameter (lock-free atomic)
 };
@@ -4,77 +4,142 @@
 
 #pragma once
 #include "Parameter.h"
-#include <vector>
+#include "FixedVector.h"
 
 /**
  * Global parameter storage - single source of truth for all synth parameters
  *
- * This vector contains pointers to all Parameter objects in the system.
+ * The Parameter objects live in this fixed-capacity vector, which is static
+ * storage: raise MAX_PARAMETERS when adding parameters (emplace_back asserts).
  * Accessed by:
  * - Audio modules for parameter value reading
  * - MIDI/UI systems for parameter updates
  * - Rotary encoder system for parameter selection/editing
  *
- * Thread Safety: The vector itself is read-only after initialization.
+ * Thread Safety: The list itself is read-only after initialization.
  * Individual Parameter objects handle thread-safe value updates.
  */
-inline std::vector<Parameter *> g_synth_parameters;
+inline constexpr size_t MAX_PARAMETERS = 48;
+inline FixedVector<Parameter, MAX_PARAMETERS> g_synth_parameters;
+
+// Parameter updates applied from MIDI CC since boot (Core 0 only, read by telemetry)
+inline uint32_t g_parameter_change_count = 0;
 
 inline void initialize_parameters() {
   // Clear any previous parameters to be safe (for re-initialization)
-  for (auto *p : g_synth_parameters)
-    delete p;
   g_synth_parameters.clear();
+  reset_part_config();
+
+  // Parameters with a PartParam slot have one value per part (PartBank.h); the rest are global
 
   // === ADSR Envelope Parameters ===
-  g_synth_parameters.push_back(new Parameter(
-      "attack", "Attack", 0.001f, 2.5f, 0.01f, 74)); // Attack time (seconds)
-  g_synth_parameters.push_back(new Parameter("decay", "Decay", 0.003f, 2.0f,
-                                             0.2f, 71)); // Decay time (seconds)
-  g_synth_parameters.push_back(new Parameter("sustain", "Sustain", 0.0f, 1.0f,
-                                             0.3f, 73)); // Sustain level (0-1)
-  g_synth_parameters.push_back(new Parameter(
-      "release", "Release", 0.01f, 5.0f, 0.1f, 72)); // Release time (seconds)
+  g_synth_parameters.emplace_back(
+      "attack", "Attack", 0.001f, 2.5f, 0.01f, 74, PartParam::ATTACK); // Attack time (seconds)
+  g_synth_parameters.emplace_back("decay", "Decay", 0.003f, 2.0f,
+                                  0.2f, 71, PartParam::DECAY); // Decay time (seconds)
+  g_synth_parameters.emplace_back("sustain", "Sustain", 0.0f, 1.0f,
+                                  0.3f, 73, PartParam::SUSTAIN); // Sustain level (0-1)
+  g_synth_parameters.emplace_back(
+      "release", "Release", 0.01f, 5.0f, 0.1f, 72, PartParam::RELEASE); // Release time (seconds)
 
   // === Oscillator Mix Parameters ===
-  g_synth_parameters.push_back(
-      new Parameter("sawLevel", "Saw Level", 0.0f, 1.0f, 1.0f, 79)); // Saw oscillator mix level
-  g_synth_parameters.push_back(
-      new Parameter("pulseLevel", "Pulse Level", 0.0f, 1.0f, 0.5f, 80)); // Pulse oscillator mix level
-  g_synth_parameters.push_back(
-      new Parameter("subLevel", "Sub Level", 0.0f, 1.0f, 0.2f, 82)); // Sub oscillator mix level
-  g_synth_parameters.push_back(
-      new Parameter("noiseLevel", "Noise Level", 0.0f, 1.0f, 0.0f, 78)); // Noise oscillator mix level
+  g_synth_parameters.emplace_back(
+      "sawLevel", "Saw Level", 0.0f, 1.0f, 1.0f, 79, PartParam::SAW_LEVEL); // Saw oscillator mix level
+  g_synth_parameters.emplace_back(
+      "pulseLevel", "Pulse Level", 0.0f, 1.0f, 0.5f, 80, PartParam::PULSE_LEVEL); // Pulse oscillator mix level
+  g_synth_parameters.emplace_back(
+      "subLevel", "Sub Level", 0.0f, 1.0f, 0.2f, 82, PartParam::SUB_LEVEL); // Sub oscillator mix level
+  g_synth_parameters.emplace_back(
+      "noiseLevel", "Noise Level", 0.0f, 1.0f, 0.0f, 78, PartParam::NOISE_LEVEL); // Noise oscillator mix level
   
+  g_synth_parameters.emplace_back(
+      "sampleLevel", "Sample Level", 0.0f, 1.0f, 0.0f, 110, PartParam::SAMPLE_LEVEL); // Flash sample mix level (SampleBank.h)
+  g_synth_parameters.emplace_back(
+      "sampleSelect", "Sample", 0.0f, 1.0f, 0.0f, 111, PartParam::SAMPLE_SELECT); // 0 = tone (looped), 1 = hit (one-shot)
+
   // === Oscillator Shape Parameters ===
-  g_synth_parameters.push_back(
-      new Parameter("pulseWidth", "Pulse Width", 0.05f, 0.95f, 0.5f, 81)); // Pulse width (duty cycle)
+  g_synth_parameters.emplace_back(
+      "pulseWidth", "Pulse Width", 0.05f, 0.95f, 0.5f, 81, PartParam::PULSE_WIDTH); // Pulse width (duty cycle)
   
   // === Pulse Width Modulation Parameters ===
-  g_synth_parameters.push_back(
-      new Parameter("pwmLfoAmount", "PWM LFO", 0.00f, 0.95f, 0.1f, 85)); // LFO modulation of pulse width
-  g_synth_parameters.push_back(
-      new Parameter("pwmLfoRate", "PWM Rate", 0.05f, 4.0f, 0.5f, 86)); // LFO rate for PWM (Hz)
-  g_synth_parameters.push_back(
-      new Parameter("pwmEnvAmount", "PWM Env", -1.0f, 1.0f, 0.2f, 87)); // Envelope modulation of pulse width
+  g_synth_parameters.emplace_back(
+      "pwmLfoAmount", "PWM LFO", 0.00f, 0.95f, 0.1f, 85, PartParam::PWM_LFO_AMOUNT); // LFO modulation of pulse width
+  g_synth_parameters.emplace_back(
+      "pwmLfoRate", "PWM Rate", 0.05f, 4.0f, 0.5f, 86); // LFO rate for PWM (Hz)
+  g_synth_parameters.emplace_back(
+      "pwmEnvAmount", "PWM Env", -1.0f, 1.0f, 0.2f, 87, PartParam::PWM_ENV_AMOUNT); // Envelope modulation of pulse width
 
   // === Filter Parameters ===
-  g_synth_parameters.push_back(
-      new Parameter("filterCutoff", "Cutoff", 0.0f, 1.0f, 0.5f, 76));
-  g_synth_parameters.push_back(
-      new Parameter("filterResonance", "Resonance", 0.0f, 0.9f, 0.2f, 77));
-  g_synth_parameters.push_back(
-      new Parameter("filterEnvAmount", "Filter Env Amount", -1.0f, 1.0f, 0.0f, 83)); // Filter envelope modulation depth
-  g_synth_parameters.push_back(
-      new Parameter("filterKeyboardTracking", "Filter KBD", 0.0f, 1.0f, 0.3f, 84)); // Filter keyboard tracking amount
+  g_synth_parameters.emplace_back(
+      "filterCutoff", "Cutoff", 0.0f, 1.0f, 0.5f, 76, PartParam::FILTER_CUTOFF);
+  g_synth_parameters.emplace_back(
+      "filterResonance", "Resonance", 0.0f, 0.9f, 0.2f, 77, PartParam::FILTER_RESONANCE);
+  g_synth_parameters.emplace_back(
+      "filterEnvAmount", "Filter Env Amount", -1.0f, 1.0f, 0.0f, 83, PartParam::FILTER_ENV_AMOUNT); // Filter envelope modulation depth
+  g_synth_parameters.emplace_back(
+      "filterKeyboardTracking", "Filter KBD", 0.0f, 1.0f, 0.3f, 84, PartParam::FILTER_KEYBOARD_TRACKING); // Filter keyboard tracking amount
+
+  // === Unison Parameters ===
+  g_synth_parameters.emplace_back(
+      "unisonVoices", "Unison", 1.0f, 8.0f, 1.0f, 88, PartParam::UNISON_VOICES); // Oscillator sets stacked per note (1 = off)
+  g_synth_parameters.emplace_back(
+      "unisonDetune", "Unison Detune", 0.0f, 1.0f, 0.25f, 89, PartParam::UNISON_DETUNE); // Spread detune, 1 = +/-50 cents
+  g_synth_parameters.emplace_back(
+      "unisonSpread", "Unison Spread", 0.0f, 1.0f, 0.5f, 90, PartParam::UNISON_SPREAD); // Stereo spread of the stack
+  g_synth_parameters.emplace_back(
+      "unisonSharedFilter", "Unison Filter", 0.0f, 1.0f, 1.0f, 91, PartParam::UNISON_SHARED_FILTER); // >= 0.5: one stereo filter pair per note
+
+  // === Voice Mode Parameters ===
+  g_synth_parameters.emplace_back(
+      "voiceMode", "Voice Mode", 0.0f, 2.0f, 0.0f, 92, PartParam::VOICE_MODE); // 0 = poly, 1 = mono, 2 = legato
+  g_synth_parameters.emplace_back(
+      "notePriority", "Note Priority", 0.0f, 2.0f, 0.0f, 93, PartParam::NOTE_PRIORITY); // Mono: 0 = last, 1 = low, 2 = high
+  g_synth_parameters.emplace_back(
+      "portamento", "Portamento", 0.0f, 2.0f, 0.0f, 5, PartParam::PORTAMENTO); // Mono glide time (seconds), CC 5 as in GM
+
+  // === Pitch Modulation Parameters ===
+  g_synth_parameters.emplace_back(
+      "bendRange", "Bend Range", 0.0f, 12.0f, 2.0f, 102, PartParam::BEND_RANGE); // Pitch bend range (semitones)
+  g_synth_parameters.emplace_back(
+      "modWheel", "Mod Wheel", 0.0f, 1.0f, 0.0f, 1, PartParam::MOD_WHEEL); // Vibrato depth, full = +/-50 cents
+  g_synth_parameters.emplace_back(
+      "vibratoRate", "Vibrato Rate", 1.0f, 10.0f, 5.5f, 103); // Vibrato LFO rate (Hz)
+
+  // === Step Sequencer Parameters ===
+  g_synth_parameters.emplace_back(
+      "seqTempo", "Tempo", 40.0f, 240.0f, 120.0f, 104); // Sequencer and arpeggiator tempo (BPM)
+  g_synth_parameters.emplace_back(
+      "seqSwing", "Seq Swing", 0.0f, 1.0f, 0.0f, 105); // Odd steps late by up to half a step
+
+  // === Arpeggiator Parameters ===
+  g_synth_parameters.emplace_back(
+      "arpMode", "Arp Mode", 0.0f, 4.0f, 0.0f, 106); // 0 = off, 1 = up, 2 = down, 3 = random, 4 = as played
+  g_synth_parameters.emplace_back(
+      "arpOctaves", "Arp Octaves", 1.0f, 4.0f, 1.0f, 107); // Octave range of the pattern
+  g_synth_parameters.emplace_back(
+      "arpGate", "Arp Gate", 0.05f, 1.0f, 0.5f, 108); // Note length as a fraction of a step
+  g_synth_parameters.emplace_back(
+      "arpRate", "Arp Rate", 0.0f, 3.0f, 2.0f, 109); // 0 = 1/4, 1 = 1/8, 2 = 1/16, 3 = 1/32 notes
+
+  // === Drum Parameters (DrumModule.h) ===
+  g_synth_parameters.emplace_back(
+      "drumLevel", "Drum Level", 0.0f, 1.0f, 0.7f, 112); // Drum kit mix level
+  g_synth_parameters.emplace_back(
+      "kickTune", "Kick Tune", 30.0f, 90.0f, 50.0f, 113); // Kick pitch after the drop (Hz)
+  g_synth_parameters.emplace_back(
+      "kickDecay", "Kick Decay", 0.05f, 1.5f, 0.4f, 114); // Kick time to -60 dB (seconds)
+  g_synth_parameters.emplace_back(
+      "snareTone", "Snare Tone", 0.0f, 1.0f, 0.5f, 115); // 0 = drum body, 1 = snare wires
+  g_synth_parameters.emplace_back(
+      "hatDecay", "Hat Decay", 0.02f, 1.0f, 0.35f, 116); // Open hat time to -60 dB, closed is 1/8
 
   // === Master Controls ===
-  g_synth_parameters.push_back(new Parameter("masterVol", "Master Volume", 0.0f,
-                                             0.7f, 0.4f,
-                                             75)); // Overall output level
+  g_synth_parameters.emplace_back("masterVol", "Master Volume", 0.0f,
+                                  0.7f, 0.4f,
+                                  75); // Overall output level
                                              
   // === Display Controls ===
-  g_synth_parameters.push_back(new Parameter("waveformToggle", "Waveform Scale", 0.0f,
-                                             1.0f, 0.8f,
-                                             127)); // Waveform display scaling (1x to 10x, default 9x)
+  g_synth_parameters.emplace_back("waveformToggle", "Waveform Scale", 0.0f,
+                                  1.0f, 0.8f,
+                                  127); // Waveform display scaling (1x to 10x, default 9x)
 }
\ No newline at end of file
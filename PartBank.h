@@ -0,0 +1,76 @@
+/**
+ * PartBank.h - Per-part parameter banks and channel bindings for multitimbral play
+ *
+ * Up to MAX_PARTS parts share the synth's voice pool. Each part listens on one
+ * MIDI channel (or all of them) and has its own copy of every sound parameter:
+ * envelope, oscillator and sample mix, PWM, filter, unison, voice mode, bend
+ * range and mod wheel. Tempo, arpeggiator, LFO rates and master volume stay global.
+ *
+ * A part's values are one contiguous array of atomics, so Core 1 snapshots a
+ * part once per block with a single sequential read. Core 0 writes them from
+ * MIDI CCs on the part's channel or through the Parameter of the edited part
+ * (g_edit_part, which the OLED, rotary and HTML knobs address).
+ *
+ * By default part 0 listens on every channel and the other parts are off, which
+ * is the single-timbral synth. No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+constexpr int MAX_PARTS = 4;
+
+// Parameters every part has its own value of (index into PartBank::values)
+enum class PartParam : uint8_t {
+    ATTACK, DECAY, SUSTAIN, RELEASE,
+    SAW_LEVEL, PULSE_LEVEL, SUB_LEVEL, NOISE_LEVEL,
+    PULSE_WIDTH, PWM_LFO_AMOUNT, PWM_ENV_AMOUNT,
+    FILTER_CUTOFF, FILTER_RESONANCE, FILTER_ENV_AMOUNT, FILTER_KEYBOARD_TRACKING,
+    UNISON_VOICES, UNISON_DETUNE, UNISON_SPREAD, UNISON_SHARED_FILTER,
+    VOICE_MODE, NOTE_PRIORITY, PORTAMENTO,
+    BEND_RANGE, MOD_WHEEL,
+    SAMPLE_LEVEL, SAMPLE_SELECT,
+    COUNT
+};
+
+constexpr int NUM_PART_PARAMS = (int)PartParam::COUNT;
+
+struct PartBank {
+    std::atomic<float> values[NUM_PART_PARAMS];
+
+    float get(PartParam param) const { return values[(int)param].load(std::memory_order_relaxed); }
+    void set(PartParam param, float value) { values[(int)param].store(value, std::memory_order_relaxed); }
+};
+
+inline PartBank g_part_banks[MAX_PARTS];
+
+// MIDI channel and voice limit of a part ("PART:" command), read by Core 1 once per block
+struct PartConfig {
+    static constexpr int8_t OFF = -1;
+    static constexpr int8_t OMNI = 16;
+
+    volatile int8_t channel = OFF;      // 0-15, OMNI or OFF
+    volatile uint8_t max_voices = 0;    // Voices the part may hold at once, 0 = the whole pool
+
+    bool isEnabled() const { return channel != OFF; }
+    bool listensTo(uint8_t midi_channel) const {
+        int8_t c = channel;
+        return c == OMNI || c == (int8_t)midi_channel;
+    }
+};
+
+inline PartConfig g_part_config[MAX_PARTS] = {{PartConfig::OMNI, 0}};
+
+// Part whose values Parameter::getValue()/setValue() address without an explicit part
+inline volatile uint8_t g_edit_part = 0;
+
+// Single-timbral default: part 0 on every channel, the others off
+inline void reset_part_config() {
+    for (int p = 0; p < MAX_PARTS; ++p) {
+        g_part_config[p].channel = (p == 0) ? PartConfig::OMNI : PartConfig::OFF;
+        g_part_config[p].max_voices = 0;
+    }
+    g_edit_part = 0;
+}
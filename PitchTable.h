@@ -0,0 +1,100 @@
+/**
+ * PitchTable.h - Compile-time pitch to phase increment conversion
+ *
+ * Pitch is a note number in Q16 semitones (60 << 16 = middle C, one cent is
+ * about 655). increment() turns it into a Phase increment through two tables
+ * built at compile time: the increment of every whole MIDI note, and the ratio
+ * 2^(k / 3072) for 256 steps within a semitone (0.39 cent each). That is one
+ * multiply per conversion, with no float math and no runtime initialization,
+ * so pitch bend, vibrato, glide and detune are all just additions to the pitch.
+ *
+ * Increments are computed directly in 32-bit phase units, so low notes keep
+ * their full precision (going through fix15 Hz rounds them to a few cents).
+ * The tables are for REFERENCE_RATE; other sample rates apply a Q16 scale.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "MemoryPlacement.h"
+
+namespace pitch {
+
+constexpr int32_t SEMITONE = 1 << 16;
+constexpr uint32_t REFERENCE_RATE = 44100;
+constexpr int FINE_BITS = 8;
+constexpr int FINE_STEPS = 1 << FINE_BITS;
+
+constexpr int32_t fromNote(int note) { return note * SEMITONE; }
+constexpr int32_t fromCents(int32_t cents) { return (int32_t)((int64_t)cents * SEMITONE / 100); }
+
+namespace detail {
+
+// 2^x for table generation: range reduction plus a Taylor series of e^(frac * ln 2)
+constexpr double exp2(double x) {
+    int whole = (int)x;
+    if (x < whole) whole--;
+    double y = (x - whole) * 0.69314718055994530942;
+    double term = 1.0, sum = 1.0;
+    for (int i = 1; i < 30; ++i) {
+        term *= y / i;
+        sum += term;
+    }
+    for (; whole > 0; --whole) sum *= 2.0;
+    for (; whole < 0; ++whole) sum *= 0.5;
+    return sum;
+}
+
+struct NoteTable {
+    uint32_t increment[129];    // MIDI notes 0-128 (A4 = 440 Hz), the extra entry bounds bends above G9
+};
+
+struct FineTable {
+    uint32_t ratio_q31[FINE_STEPS]; // 2^(k / (12 * FINE_STEPS)), 1.0 to just under one semitone
+};
+
+constexpr NoteTable makeNoteTable() {
+    NoteTable table{};
+    for (int note = 0; note <= 128; ++note) {
+        double hz = 440.0 * exp2((note - 69) / 12.0);
+        table.increment[note] = (uint32_t)(hz * 4294967296.0 / REFERENCE_RATE + 0.5);
+    }
+    return table;
+}
+
+constexpr FineTable makeFineTable() {
+    FineTable table{};
+    for (int k = 0; k < FINE_STEPS; ++k) {
+        table.ratio_q31[k] = (uint32_t)(exp2(k / (12.0 * FINE_STEPS)) * 2147483648.0 + 0.5);
+    }
+    return table;
+}
+
+}  // namespace detail
+
+inline constexpr detail::NoteTable NOTE_TABLE AUDIO_RAM_DATA("pitch_note_table") = detail::makeNoteTable();
+inline constexpr detail::FineTable FINE_TABLE AUDIO_RAM_DATA("pitch_fine_table") = detail::makeFineTable();
+
+static_assert(NOTE_TABLE.increment[69] == 42852281 || NOTE_TABLE.increment[69] == 42852282, "A4 must be 440 Hz");
+static_assert(FINE_TABLE.ratio_q31[0] == 0x80000000u, "Fine table must start at unity");
+
+// Phase increment at REFERENCE_RATE, pitch clamped to MIDI notes 0-128
+constexpr uint32_t increment(int32_t pitch_q16) {
+    if (pitch_q16 <= 0) return NOTE_TABLE.increment[0];
+    if (pitch_q16 >= fromNote(128)) return NOTE_TABLE.increment[128];
+    uint32_t note = (uint32_t)pitch_q16 >> 16;
+    uint32_t fine = ((uint32_t)pitch_q16 >> (16 - FINE_BITS)) & (FINE_STEPS - 1);
+    return (uint32_t)(((uint64_t)NOTE_TABLE.increment[note] * FINE_TABLE.ratio_q31[fine]) >> 31);
+}
+
+// Q16 factor from REFERENCE_RATE increments to another sample rate (computed once)
+constexpr uint32_t rateScale(float sample_rate) {
+    return (uint32_t)((double)REFERENCE_RATE * 65536.0 / sample_rate + 0.5);
+}
+
+// Phase increment at the rate described by rate_scale_q16 (exact at REFERENCE_RATE)
+constexpr uint32_t increment(int32_t pitch_q16, uint32_t rate_scale_q16) {
+    return (uint32_t)(((uint64_t)increment(pitch_q16) * rate_scale_q16) >> 16);
+}
+
+}  // namespace pitch
@@ -0,0 +1,137 @@
+/**
+ * SampleBank.h - Built-in PCM samples for the sample player, generated at compile time
+ *
+ * The samples are constexpr tables, so they are ordinary const data: the
+ * linker keeps them in flash and Fix15SamplePlayer reads them through XIP,
+ * the same way a sample converted from a WAV file into a const array would be.
+ * Generating them keeps the repo free of binary assets.
+ *
+ * - 0 "Tone": bright attack decaying into a steady tone, looped over whole
+ *   cycles from 0.37 s (32 KB, twice the XIP cache, so streaming it misses)
+ * - 1 "Hit": one-shot pitched drum with a noise click, 0.19 s
+ *
+ * Parts pick one with the "sampleSelect" parameter and mix it in with
+ * "sampleLevel" (ParameterStore.h). No Pico SDK dependencies.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Fix15SamplePlayer.h"
+#include "PitchTable.h"
+
+namespace samples {
+
+using fixOscs::oscillator::SampleData;
+
+constexpr uint32_t RATE = 22050;
+
+constexpr int TONE_PERIOD = 84;                             // 262.5 Hz at RATE
+constexpr uint32_t TONE_FRAMES = 16384;
+constexpr uint32_t TONE_LOOP_START = TONE_PERIOD * 98;      // Attack fully decayed here
+constexpr uint32_t TONE_LOOP_END = TONE_LOOP_START + TONE_PERIOD * 97;
+constexpr int32_t TONE_ROOT = 3935946;                      // 262.5 Hz = note 60.058, Q16
+
+constexpr uint32_t HIT_FRAMES = 4096;
+constexpr int32_t HIT_ROOT = pitch::fromNote(33);           // Pitch settles at 55 Hz (A1)
+
+namespace detail {
+
+constexpr double PI = 3.14159265358979323846;
+
+// sin(x) for table generation: reduce to [-pi, pi], then a Taylor series
+constexpr double sine(double x) {
+    while (x > PI) x -= 2.0 * PI;
+    while (x < -PI) x += 2.0 * PI;
+    double term = x, sum = x;
+    for (int i = 1; i < 16; ++i) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+template <uint32_t N>
+struct Pcm {
+    int16_t data[N];
+};
+
+// One cycle of a steady part and one of a bright part that fades out by the loop start;
+// both repeat every TONE_PERIOD samples, so the loop is seamless.
+constexpr Pcm<TONE_FRAMES> makeTone() {
+    double steady[TONE_PERIOD] = {}, bright[TONE_PERIOD] = {};
+    for (int h = 1; h <= 12; ++h) {
+        double steady_amp = (h % 2 ? 0.5 : 0.2) / h;
+        double bright_amp = 0.6 / h;
+        for (int n = 0; n < TONE_PERIOD; ++n) {
+            double s = sine(2.0 * PI * h * n / TONE_PERIOD);
+            steady[n] += steady_amp * s;
+            bright[n] += bright_amp * s;
+        }
+    }
+    auto tone = [&](uint32_t n) {
+        double fade = n < TONE_LOOP_START ? 1.0 - (double)n / TONE_LOOP_START : 0.0;
+        return steady[n % TONE_PERIOD] + fade * fade * fade * bright[n % TONE_PERIOD];
+    };
+
+    // Peak is in the first cycles, where the bright part is strongest
+    double peak = 0.0;
+    for (uint32_t n = 0; n < 4 * TONE_PERIOD; ++n) {
+        double v = tone(n) < 0.0 ? -tone(n) : tone(n);
+        if (v > peak) peak = v;
+    }
+    double scale = 0.7 * 32767.0 / peak;                    // Headroom for the noise transient
+
+    Pcm<TONE_FRAMES> pcm{};
+    uint32_t seed = 1;
+    for (uint32_t n = 0; n < TONE_FRAMES; ++n) {
+        double value = tone(n);
+        if (n < 512) {
+            seed = seed * 1664525u + 1013904223u;
+            double click = 1.0 - n / 512.0;
+            value += 0.25 * peak * click * click * ((int32_t)(seed >> 16) - 32768) / 32768.0;
+        }
+        pcm.data[n] = (int16_t)(value * scale);
+    }
+    return pcm;
+}
+
+// Sine whose pitch drops from 180 Hz to 55 Hz, decaying, with a short noise click
+constexpr Pcm<HIT_FRAMES> makeHit() {
+    Pcm<HIT_FRAMES> pcm{};
+    double phase = 0.0, sweep = 1.0, amp = 1.0;
+    uint32_t seed = 7;
+    for (uint32_t n = 0; n < HIT_FRAMES; ++n) {
+        double value = amp * sine(phase);
+        if (n < 128) {
+            seed = seed * 1664525u + 1013904223u;
+            value += 0.4 * (1.0 - n / 128.0) * ((int32_t)(seed >> 16) - 32768) / 32768.0;
+        }
+        if (n >= HIT_FRAMES - 256) value *= (HIT_FRAMES - n) / 256.0;  // Land on silence
+        pcm.data[n] = (int16_t)(value * 0.7 * 32767.0);
+        phase += 2.0 * PI * (55.0 + 125.0 * sweep) / RATE;
+        if (phase > PI) phase -= 2.0 * PI;
+        sweep *= 0.9967;                                    // ~14 ms time constant
+        amp *= 0.999;                                       // ~45 ms time constant
+    }
+    return pcm;
+}
+
+}  // namespace detail
+
+inline constexpr detail::Pcm<TONE_FRAMES> TONE_PCM = detail::makeTone();
+inline constexpr detail::Pcm<HIT_FRAMES> HIT_PCM = detail::makeHit();
+
+constexpr int NUM_SAMPLES = 2;
+
+inline constexpr SampleData BANK[NUM_SAMPLES] = {
+    {TONE_PCM.data, TONE_FRAMES, TONE_LOOP_START, TONE_LOOP_END, TONE_ROOT, SampleData::stepScale(RATE)},
+    {HIT_PCM.data, HIT_FRAMES, 0, 0, HIT_ROOT, SampleData::stepScale(RATE)},
+};
+
+static_assert(TONE_LOOP_END <= TONE_FRAMES, "Tone loop must end inside the sample");
+
+}  // namespace samples
+
+// Per-block SRAM prefetch of the playing samples (SAMPLE_PREFETCH command), read by Core 1
+inline volatile bool g_sample_prefetch = true;
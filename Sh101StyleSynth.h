@@ -1,15 +1,31 @@
-// Polyphonic synthesizer module with oscillators, envelopes, and voice allocation
+// Polyphonic, multitimbral synthesizer module with oscillators, envelopes, and voice allocation
 
 #pragma once
 
 #include "AudioModule.h"
 #include "ParameterStore.h"
+#include "PartBank.h"
 #include "SmoothedValue.h"
 #include "choc/audio/choc_SampleBuffers.h"
 #include "pico/multicore.h"
 #include "Fix15Oscillators.h"
+#include "SampleBank.h"
+#include "DrumModule.h"
 #include "Fix15VCAEnvelopeModule.h"
-#include <vector>
+#include "AudioCapture.h"
+#include "EngineTelemetry.h"
+#include "TraceRing.h"
+#include "LatencyProbe.h"
+#include "VoiceAllocator.h"
+#include "NoteStack.h"
+#include "MemoryPlacement.h"
+#include "PitchTable.h"
+#include "StepSequencer.h"
+#include "Arpeggiator.h"
+#include "MidiClockTracker.h"
+#include "FixedVector.h"
+#include <algorithm>
+#include <cmath>
 
 // Simple single-voice Moog ladder filter for per-voice filtering
 class VoiceFilter {
@@ -18,7 +34,7 @@ public:
         stage1 = stage2 = stage3 = stage4 = 0;
     }
     
-    fix15 process(fix15 input, fix15 cutoff, fix15 resonance) {
+    fix15 AUDIO_RAM_FUNC(process)(fix15 input, fix15 cutoff, fix15 resonance) {
         // Map cutoff: 0-1 -> 0.001-0.85 
         fix15 g = multfix15(cutoff, 27787) + 33;  // 0.849 * 32768, 0.001 * 32768
         // Map resonance: 0-1 -> 0-4.5
@@ -52,25 +68,66 @@ private:
     fix15 stage1, stage2, stage3, stage4;
 };
 
+// Filter keyboard tracking per MIDI note: each octave from C4 adds/subtracts 0.15 of the cutoff range
+struct KeyboardTrackingTable {
+    fix15 offset[128];
+};
+
+constexpr KeyboardTrackingTable makeKeyboardTrackingTable() {
+    KeyboardTrackingTable table{};
+    for (int i = 0; i < 128; ++i) {
+        int note_offset = i - 60;  // Distance from C4
+        table.offset[i] = float2fix15((note_offset / 12.0f) * 0.15f);
+    }
+    return table;
+}
+
+inline constexpr KeyboardTrackingTable KBD_TRACKING_TABLE AUDIO_RAM_DATA("kbd_tracking_table") = makeKeyboardTrackingTable();
+
+
 class Sh101StyleSynth : public AudioModule {
 private:
-    // Number of polyphonic voices
+    // Number of polyphonic voices, shared by all parts
     static constexpr int NUM_VOICES = 4;
+    // Oscillator sets a voice can stack in unison mode
+    static constexpr int MAX_UNISON = 8;
+    // Samples between pitch modulation updates (glide, bend, vibrato)
+    static constexpr int PITCH_TICK = 16;
+    static_assert(MAX_PARTS <= VoiceAllocator::MAX_GROUPS, "each part is one allocator group");
     
-    struct Voice {
-        // DSP objects per voice
+    enum class VoiceMode : uint8_t { POLY, MONO, LEGATO };  // LEGATO: overlapping notes don't retrigger
+    
+    // One detunable oscillator set. Set 0 alone is the normal (unison off) voice.
+    struct OscillatorSet {
         fixOscs::oscillator::Saw sawOsc;
         fixOscs::oscillator::Pulse pulseOsc;
         fixOscs::oscillator::Pulse subOsc;  // Sub oscillator (1 octave down square wave)
+        VoiceFilter filter;  // Per-set filter; sets 0/1 double as the left/right filter of a shared-filter stack
+    };
+    
+    // Everything besides the note itself that sets the oscillator pitches, shared by a part's voices
+    struct PitchState {
+        int unison = 1;
+        const int32_t* detune_q16 = nullptr;    // Per-set pitch offsets
+        int32_t offset_q16 = 0;                 // Pitch bend + vibrato
+        uint32_t rate_scale_q16 = 1 << 16;      // pitch::rateScale() of the sample rate
+    };
+    
+    struct Voice {
+        // DSP objects per voice
+        OscillatorSet oscs[MAX_UNISON];
         fixOscs::oscillator::Noise noiseOsc;
+        fixOscs::oscillator::SamplePlayer sampler;     // Flash sample, restarted per note when the part mixes one in
 
-        Fix15VCAEnvelopeModule envelope;
-        VoiceFilter filter;  // Per-voice filter for envelope modulation
+        Fix15VCAEnvelopeModule envelope;   // Shared by every oscillator set of the note
         
         // Voice state
         uint8_t midiNote = 0;
+        uint8_t part = 0;                   // Part whose sound the voice plays
         bool isActive = false;
         fix15 velocity = 0;
+        int32_t pitch_q16 = 0;              // Note pitch (semitones Q16), glides in the mono modes
+        int32_t target_pitch_q16 = 0;
         
         // Per-voice smoothers
         Fix15SmoothedValue s_velocity;
@@ -80,97 +137,144 @@ private:
             s_velocity.setValue(0);
         }
         
-        void noteOn(uint8_t note, fix15 vel, float sample_rate) {
+        void noteOn(uint8_t note, fix15 vel, const PitchState& pitch_state, const fixOscs::oscillator::SampleData* sample) {
             midiNote = note;
             isActive = true;
             velocity = vel;
             
-            // OPTIMIZED: Set frequency immediately - envelope StealFade handles smooth stealing
-            fix15 freq = midiNoteToFreq(note);
-            
-            // Reset phases for consistent oscillator synchronization
-            sawOsc.resetPhase();
-            pulseOsc.resetPhase();
-            subOsc.resetPhase();
-
-            // Set frequencies after phase reset
-            sawOsc.setFrequency(freq);
-            pulseOsc.setFrequency(freq);
-            subOsc.setFrequency(freq >> 1); // Bit shift = exact divide by 2
+            // Reset phases for consistent oscillator synchronization. Stacked sets start
+            // spread around the cycle so a unison attack does not begin as one summed spike.
+            for (int k = 0; k < MAX_UNISON; ++k) {
+                uint32_t start = (uint32_t)k * 0x9E3779B9u;  // Golden ratio steps, 0 for set 0
+                oscs[k].sawOsc.resetPhase(start);
+                oscs[k].pulseOsc.resetPhase(start);
+                oscs[k].subOsc.resetPhase(start);
+            }
+
+            if (sample) sampler.start(*sample);
+            else sampler.stop();
+
+            // Set pitch immediately after phase reset - envelope StealFade handles smooth stealing
+            pitch_q16 = target_pitch_q16 = pitch::fromNote(note);
+            applyPitch(pitch_state);
             // Noise doesn't need frequency setting
             s_velocity.setTargetValue(vel);
             envelope.noteOn(); // This handles StealFade for smooth voice stealing
         }
         
+        // Converts pitch + modulation + per-set detune into phase increments (one table multiply per set)
+        void applyPitch(const PitchState& pitch_state) {
+            int32_t voice_pitch = pitch_q16 + pitch_state.offset_q16;
+            for (int k = 0; k < pitch_state.unison; ++k) {
+                uint32_t increment = pitch::increment(voice_pitch + pitch_state.detune_q16[k], pitch_state.rate_scale_q16);
+                oscs[k].sawOsc.setIncrement(increment);
+                oscs[k].pulseOsc.setIncrement(increment);
+                oscs[k].subOsc.setIncrement(increment >> 1); // Bit shift = exact octave down
+            }
+            sampler.setPitch(voice_pitch, pitch_state.rate_scale_q16);  // Follows the note, not the unison detune
+        }
+        
         void noteOff() {
             if (!isActive) return;
             isActive = false;  // Key is no longer pressed
             envelope.noteOff(); // Start release phase
         }
-        
-        static fix15 midiNoteToFreq(uint8_t note) {
-            // OPTIMIZED: Use fix15 lookup table generated at initialization
-            static fix15 midi_freq_table_fix15[128];
-            static bool table_initialized = false;
-            
-            // Initialize table once using float calculations then convert to fix15
-            if (!table_initialized) {
-                const float midi_freq_table_float[128] = {
-                    8.176f, 8.662f, 9.177f, 9.723f, 10.301f, 10.913f, 11.562f, 12.250f, 12.978f, 13.750f, 14.568f, 15.434f, // C-1 to B-1
-                    16.352f, 17.324f, 18.354f, 19.445f, 20.602f, 21.827f, 23.125f, 24.500f, 25.957f, 27.500f, 29.135f, 30.868f, // C0 to B0
-                    32.703f, 34.648f, 36.708f, 38.891f, 41.203f, 43.654f, 46.249f, 48.999f, 51.913f, 55.000f, 58.270f, 61.735f, // C1 to B1
-                    65.406f, 69.296f, 73.416f, 77.782f, 82.407f, 87.307f, 92.499f, 97.999f, 103.826f, 110.000f, 116.541f, 123.471f, // C2 to B2
-                    130.813f, 138.591f, 146.832f, 155.563f, 164.814f, 174.614f, 184.997f, 195.998f, 207.652f, 220.000f, 233.082f, 246.942f, // C3 to B3
-                    261.626f, 277.183f, 293.665f, 311.127f, 329.628f, 349.228f, 369.994f, 391.995f, 415.305f, 440.000f, 466.164f, 493.883f, // C4 to B4
-                    523.251f, 554.365f, 587.330f, 622.254f, 659.255f, 698.456f, 739.989f, 783.991f, 830.609f, 880.000f, 932.328f, 987.767f, // C5 to B5
-                    1046.502f, 1108.731f, 1174.659f, 1244.508f, 1318.510f, 1396.913f, 1479.978f, 1567.982f, 1661.219f, 1760.000f, 1864.655f, 1975.533f, // C6 to B6
-                    2093.005f, 2217.461f, 2349.318f, 2489.016f, 2637.020f, 2793.826f, 2959.955f, 3135.963f, 3322.438f, 3520.000f, 3729.310f, 3951.066f, // C7 to B7
-                    4186.009f, 4434.922f, 4698.636f, 4978.032f, 5274.041f, 5587.652f, 5919.911f, 6271.927f, 6644.875f, 7040.000f, 7458.620f, 7902.133f, // C8 to B8
-                    8372.018f, 8869.844f, 9397.273f, 9956.063f, 10548.082f, 11175.303f, 11839.822f, 12543.854f // C9 to G9
-                };
-                
-                // Convert float table to fix15 at initialization
-                for (int i = 0; i < 128; ++i) {
-                    midi_freq_table_fix15[i] = float2fix15(midi_freq_table_float[i]);
-                }
-                table_initialized = true;
-            }
-            
-            if (note >= 128) note = 127; // Clamp to valid range
-            return midi_freq_table_fix15[note];
+    };
+
+    // One multitimbral part: its block snapshot of g_part_banks and everything derived from it.
+    // The voice loop reads only this, so parts never touch each other's state.
+    struct Part {
+        int8_t channel = PartConfig::OFF;   // Applied g_part_config channel
+        uint8_t max_voices = 0;
+        float values[NUM_PART_PARAMS] = {}; // This block's copy of the part's bank
+
+        float value(PartParam param) const { return values[(int)param]; }
+        bool isEnabled() const { return channel != PartConfig::OFF; }
+        bool listensTo(uint8_t midi_channel) const {
+            return channel == PartConfig::OMNI || channel == (int8_t)midi_channel;
         }
+
+        // === OPTIMIZATION: Cached fix15 parameters (updated once per buffer) ===
+        // Eliminates 128x redundant float->fix15 conversions per buffer
+        fix15 cached_sawLevel = FIX15_ONE;
+        fix15 cached_pulseLevel = FIX15_ZERO;
+        fix15 cached_subLevel = FIX15_ZERO;
+        fix15 cached_noiseLevel = FIX15_ZERO;
+        fix15 cached_basePulseWidth = FIX15_HALF;
+        fix15 cached_pwmLfoAmount = FIX15_ZERO;
+        fix15 cached_pwmEnvAmount = FIX15_ZERO;
+        fix15 cached_filterCutoff = float2fix15(0.5f);
+        fix15 cached_filterResonance = float2fix15(0.2f);
+        fix15 cached_filterEnvAmount = FIX15_ZERO;
+        fix15 cached_filterKeyboardTracking = FIX15_ZERO;
+        fix15 cached_sampleLevel = FIX15_ZERO;
+        const fixOscs::oscillator::SampleData* sample = nullptr;   // Started on new notes, null while sampleLevel is 0
+
+        // Last envelope parameter values pushed to the part's voices
+        float last_attack = -1.0f, last_decay = -1.0f, last_sustain = -1.0f, last_release = -1.0f;
+
+        // Unison stack, recomputed only when its parameters change
+        int unison_count = 1;
+        bool unison_shared_filter = true;
+        int32_t unison_detune_q16[MAX_UNISON] = {};    // Pitch offset per set, semitones Q16
+        fix15 unison_gain_left[MAX_UNISON] = {};
+        fix15 unison_gain_right[MAX_UNISON] = {};
+        fix15 unison_noise_gain = FIX15_ONE;
+        float last_unison_voices = -1.0f, last_unison_detune = -1.0f, last_unison_spread = -1.0f;
+
+        // Mono/legato modes play one voice from a stack of held keys
+        VoiceMode voice_mode = VoiceMode::POLY;
+        NoteStack::Priority note_priority = NoteStack::Priority::LAST;
+        NoteStack held_notes;
+        int8_t mono_voice = VoiceAllocator::NONE;   // Voice of the current (or last) mono phrase
+        int32_t glide_coef_q16 = 0;         // Fraction of the remaining pitch distance per tick, 0 = no glide
+        float last_portamento = -1.0f;
+
+        // Pitch modulation of the part's voices, applied every PITCH_TICK samples
+        PitchState pitch_state;
+        int32_t bend_value = 0;             // Last pitch bend message, -8192 to 8191
+        int32_t bend_q16 = 0;               // Bend in semitones Q16 at the current bend range
+        int32_t vibrato_depth_q16 = 0;      // Mod wheel vibrato depth, 0 = off
     };
 
     
     // Voice management
-    std::vector<Voice> voices;
-    size_t next_voice_to_steal = 0;
+    FixedVector<Voice, NUM_VOICES> voices;
+    VoiceAllocator allocator;               // Free/held/releasing lists, indexes into voices; one group per part
+    uint8_t applied_voice_policy = 0xFF;    // Last g_voice_policy value handed to the allocator
+    Part parts[MAX_PARTS];
     
     float sampleRate;                        // Sample rate (stored for frequency calculations)
     uint8_t waveform_counter = 0;           // Counter for waveform display decimation
+    Voice* latency_probe_voice = nullptr;   // Voice playing the in-flight latency probe note
+    
+    fixOscs::oscillator::ModLFO vibratoLfo; // Shared by the parts (depth is per part), advances once per pitch tick
+    
+    // Plays g_sequencer_pattern on this core's sample clock
+    StepSequencer sequencer;
+    
+    // While on, incoming notes feed the arpeggiator, which plays them on the same clock
+    Arpeggiator arpeggiator;
+    uint8_t arp_channel = 0;            // Channel of the last key the arpeggiator got; its notes play there
+    uint8_t arp_sounding_channel = 0;   // Channel the sounding arpeggiator note went to
+    uint32_t event_frame = 0;           // Frame of the note event being applied (FIFO packets: 0)
+    uint64_t clock_tick_q16 = 0;        // Samples per MIDI clock tick (24 per beat), Q16
+    DrumModule* drums = nullptr;        // Plays the notes of g_drum_channel
     
     // Global modulation LFO (shared across all voices)
     fixOscs::oscillator::ModLFO modLfo;
     
     // === Parameter System ===
-    // Pointers to global parameters (shared between control and audio threads)
-    // These are read-only from the audio thread perspective
-    Parameter* p_attack = nullptr;
-    Parameter* p_decay = nullptr;
-    Parameter* p_sustain = nullptr;
-    Parameter* p_release = nullptr;
-    Parameter* p_sawLevel = nullptr;
-    Parameter* p_pulseLevel = nullptr;
-    Parameter* p_subLevel = nullptr;
-    Parameter* p_noiseLevel = nullptr;
-    Parameter* p_pulseWidth = nullptr;
-    Parameter* p_filterCutoff = nullptr;
-    Parameter* p_filterResonance = nullptr;
-    Parameter* p_filterEnvAmount = nullptr;
-    Parameter* p_filterKeyboardTracking = nullptr;
-    Parameter* p_pwmLfoAmount = nullptr;
+    // Pointers to the global parameters (shared between control and audio threads).
+    // Per-part parameters are read from g_part_banks instead, once per block.
     Parameter* p_pwmLfoRate = nullptr;
-    Parameter* p_pwmEnvAmount = nullptr;
+    Parameter* p_vibratoRate = nullptr;
+    Parameter* p_seqTempo = nullptr;
+    Parameter* p_seqSwing = nullptr;
+    Parameter* p_arpMode = nullptr;
+    Parameter* p_arpOctaves = nullptr;
+    Parameter* p_arpGate = nullptr;
+    Parameter* p_arpRate = nullptr;
     
     
     // === Audio Thread Smoothers ===
@@ -181,59 +285,47 @@ private:
     Fix15SmoothedValue s_decay;            // They're kept for potential future use
     Fix15SmoothedValue s_sustain;
     Fix15SmoothedValue s_release;
-    
-    // === OPTIMIZATION: Cached fix15 parameters (updated once per buffer) ===
-    // Eliminates 128x redundant float->fix15 conversions per buffer
-    fix15 cached_sawLevel = FIX15_ONE;
-    fix15 cached_pulseLevel = FIX15_ZERO;
-    fix15 cached_subLevel = FIX15_ZERO; 
-    fix15 cached_noiseLevel = FIX15_ZERO;
-    fix15 cached_basePulseWidth = FIX15_HALF;
-    fix15 cached_pwmLfoAmount = FIX15_ZERO;
-    fix15 cached_pwmEnvAmount = FIX15_ZERO;
-    fix15 cached_filterCutoff = float2fix15(0.5f);
-    fix15 cached_filterResonance = float2fix15(0.2f);
-    fix15 cached_filterEnvAmount = FIX15_ZERO;
-    fix15 cached_filterKeyboardTracking = FIX15_ZERO;
 
 
 public:
     explicit Sh101StyleSynth(float sample_rate)
     : sampleRate(sample_rate) {
         // Initialize voices
-        voices.reserve(NUM_VOICES);
         for (int i = 0; i < NUM_VOICES; ++i) {
             voices.emplace_back(sample_rate);
         }
+        allocator.reset(NUM_VOICES);
 
         for (auto& voice : voices) {
-            voice.sawOsc.setSampleRate(sample_rate);
-            voice.pulseOsc.setSampleRate(sample_rate);
-            voice.subOsc.setSampleRate(sample_rate);
+            for (auto& set : voice.oscs) {
+                set.sawOsc.setSampleRate(sample_rate);
+                set.pulseOsc.setSampleRate(sample_rate);
+                set.subOsc.setSampleRate(sample_rate);
+            }
             // Noise doesn't need sample rate
         }
         
         // Initialize global modulation LFO
         modLfo.setSampleRate(sample_rate);
+        
+        vibratoLfo.setSampleRate(sample_rate / PITCH_TICK);
+        sequencer.setSampleRate(sample_rate);
+        
+        for (auto& part : parts) {
+            part.pitch_state.detune_q16 = part.unison_detune_q16;
+            part.pitch_state.rate_scale_q16 = pitch::rateScale(sample_rate);
+        }
 
         // Find our parameters by their string ID from the global store
-        for (auto* p : g_synth_parameters) {
-            if (p->getID() == "attack") p_attack = p;
-            if (p->getID() == "decay") p_decay = p;
-            if (p->getID() == "sustain") p_sustain = p;
-            if (p->getID() == "release") p_release = p;
-            if (p->getID() == "sawLevel") p_sawLevel = p;
-            if (p->getID() == "pulseLevel") p_pulseLevel = p;
-            if (p->getID() == "subLevel") p_subLevel = p;
-            if (p->getID() == "noiseLevel") p_noiseLevel = p;
-            if (p->getID() == "pulseWidth") p_pulseWidth = p;
-            if (p->getID() == "filterCutoff") p_filterCutoff = p;
-            if (p->getID() == "filterResonance") p_filterResonance = p;
-            if (p->getID() == "filterEnvAmount") p_filterEnvAmount = p;
-            if (p->getID() == "filterKeyboardTracking") p_filterKeyboardTracking = p;
-            if (p->getID() == "pwmLfoAmount") p_pwmLfoAmount = p;
-            if (p->getID() == "pwmLfoRate") p_pwmLfoRate = p;
-            if (p->getID() == "pwmEnvAmount") p_pwmEnvAmount = p;
+        for (auto& p : g_synth_parameters) {
+            if (p.getID() == "pwmLfoRate") p_pwmLfoRate = &p;
+            if (p.getID() == "vibratoRate") p_vibratoRate = &p;
+            if (p.getID() == "seqTempo") p_seqTempo = &p;
+            if (p.getID() == "seqSwing") p_seqSwing = &p;
+            if (p.getID() == "arpMode") p_arpMode = &p;
+            if (p.getID() == "arpOctaves") p_arpOctaves = &p;
+            if (p.getID() == "arpGate") p_arpGate = &p;
+            if (p.getID() == "arpRate") p_arpRate = &p;
         }
         
         // Set ramp times for smoothers
@@ -242,56 +334,165 @@ public:
         s_sustain.reset(sample_rate, 0.01);
         s_release.reset(sample_rate, 0.01);
         
-        // Initialize smoothers with current values
-
-        // Initialize all voice envelopes with parameter values from store
+        // Initialize all voice envelopes with part 0's values (voices take their part's on each note)
+        const PartBank& bank = g_part_banks[0];
         for (auto& voice : voices) {
-            if (p_attack) voice.envelope.setAttackTime(p_attack->getValue());
-            if (p_decay) voice.envelope.setDecayTime(p_decay->getValue());
-            if (p_sustain) voice.envelope.setSustainLevel(p_sustain->getValue());
-            if (p_release) voice.envelope.setReleaseTime(p_release->getValue());
+            voice.envelope.setAttackTime(bank.get(PartParam::ATTACK));
+            voice.envelope.setDecayTime(bank.get(PartParam::DECAY));
+            voice.envelope.setSustainLevel(bank.get(PartParam::SUSTAIN));
+            voice.envelope.setReleaseTime(bank.get(PartParam::RELEASE));
         }
     }
 
 
-    void process(choc::buffer::InterleavedView<fix15>& buffer) override {
+    void AUDIO_RAM_FUNC(process)(choc::buffer::InterleavedView<fix15>& buffer) override {
         auto numFrames = buffer.getNumFrames();
 
         // Update parameters once per buffer (more efficient)
         updateControlSignals();
         
+        // Voice count and envelope states for telemetry (once per buffer)
+        EngineTelemetrySnapshot& telemetry = g_engine_telemetry.writer();
+        uint8_t active_voices = 0;
+        int voice_index = 0;
+        for (auto& voice : voices) {
+            int index = (int)(&voice - voices.data());
+            if (voice.envelope.isActive()) active_voices++;
+            else if (allocator.isReleasing(index)) allocator.voiceFinished(index);   // Release tail ended
+            if (voice_index < EngineTelemetrySnapshot::MAX_VOICES) {
+                telemetry.voice_states[voice_index++] = (uint8_t)voice.envelope.getState();
+            }
+        }
+        telemetry.active_voices = active_voices;
+        telemetry.num_voices = (uint8_t)voice_index;
+        
+        // Stage this block's stretch of each playing sample in SRAM (one sequential flash read per voice)
+        if (g_sample_prefetch) {
+            for (auto& voice : voices) {
+                if (voice.envelope.isActive() && voice.sampler.isPlaying()) voice.sampler.prefetch(numFrames);
+            }
+        }
+        
+        // Sequencer notes start and end on their exact frame, not at the block start
+        auto playSequencerNote = [this](uint8_t command, uint8_t note, uint8_t velocity, uint8_t channel) {
+            handleMidiPacket((uint32_t)(command << 24) | (note << 16) | (velocity << 8) | ((channel & 0x0F) << 4));
+        };
+        // Sixteenth-note steps: 6 clock ticks
+        sequencer.beginBlock(clock_tick_q16 * 6, p_seqSwing ? p_seqSwing->getValue() : 0.0f, playSequencerNote);
+        int sequencer_frame = sequencer.nextEventFrame(numFrames);
+        int arp_frame = arpeggiator.nextEventFrame(numFrames);
+        
         for (uint32_t f = 0; f < numFrames; ++f) {
+            if ((int)f == sequencer_frame) {
+                event_frame = f;
+                sequencer.processEvents(f, playSequencerNote);
+                event_frame = 0;
+                sequencer_frame = sequencer.nextEventFrame(numFrames);
+                arp_frame = arpeggiator.nextEventFrame(numFrames);    // Sequencer notes may start the arp
+            }
+            if ((int)f == arp_frame) {
+                arpeggiator.processEvents(f, arpOutput());
+                arp_frame = arpeggiator.nextEventFrame(numFrames);
+            }
             
+            // Glide, bend and vibrato move the oscillator pitches at control rate
+            if ((f % PITCH_TICK) == 0) {
+                updatePitchModulation();
+            }
             
-            // Use 32-bit accumulator to prevent overflow
-            int32_t mixedSample32 = 0;
+            // Use 32-bit accumulators to prevent overflow
+            int32_t left32 = 0, right32 = 0;
             
             // Process all active voices and mix their output
             for (auto& voice : voices) {
                 if (voice.envelope.isActive()) {
-                    mixedSample32 += processVoice(voice); // Accumulate in 32-bit to prevent overflow
+                    int32_t voiceLeft = 0, voiceRight = 0;
+                    processVoice(voice, parts[voice.part], voiceLeft, voiceRight);
+                    left32 += voiceLeft; // Accumulate in 32-bit to prevent overflow
+                    right32 += voiceRight;
+                    
+                    // Latency probe: first audible sample of the tagged note
+                    if (&voice == latency_probe_voice && (voiceLeft | voiceRight) != 0) {
+                        g_latency_probe.markFirstSample((int)f);
+                        latency_probe_voice = nullptr;
+                    }
                 }
             }
             
             // Scale down to avoid clipping output
-            fix15 finalSample = (fix15)(mixedSample32 >> 3); // Divide by 8 using bit shift
+            fix15 finalLeft = (fix15)(left32 >> 3); // Divide by 8 using bit shift
+            fix15 finalRight = (fix15)(right32 >> 3);
 
             // Send occasional samples for waveform display (minimal CPU overhead)
             if (++waveform_counter == 4) {  // Every 2nd sample for smoother waveform
                 waveform_counter = 0;
                 // Pack fix15 directly as uint32_t (no float conversion in audio thread)
-                multicore_fifo_push_timeout_us((uint32_t)(finalSample + 32768), 0);
+                fix15 displaySample = (finalLeft + finalRight) >> 1;
+                multicore_fifo_push_timeout_us((uint32_t)(displaySample + 32768), 0);
             }
 
-        // Output to all channels
+        // Output to all channels (left on even, right on odd; identical unless unison spreads them)
             for (uint32_t ch = 0; ch < buffer.getNumChannels(); ++ch) {
-                buffer.getSample(ch, f) = finalSample;
+                buffer.getSample(ch, f) = (ch & 1) ? finalRight : finalLeft;
+            }
+        }
+
+        sequencer.endBlock(numFrames);
+        arpeggiator.endBlock(numFrames);
+
+        // Full-rate block capture for the spectrum screen (flag check only when not requested)
+        g_audio_capture.captureBlock(buffer);
+    }
+    
+    // Notes on g_drum_channel go to the drum module (which must run after this one) instead of the parts
+    void setDrumModule(DrumModule* module) { drums = module; }
+    
+    // Applies one inter-core MIDI packet: (command << 24) | (data1 << 16) | (data2 << 8) | flags,
+    // where flags holds the MIDI channel in bits 4-7 and LatencyProbe::PACKET_FLAG in bit 0.
+    // Every part listening on the channel gets the message, except on the drum channel.
+    // Normally fed from the FIFO; the bench firmware calls it directly on a single core.
+    void AUDIO_RAM_FUNC(handleMidiPacket)(uint32_t packet) {
+        uint8_t command = (packet >> 24) & 0xFF;
+        uint8_t data1   = (packet >> 16) & 0xFF;
+        uint8_t data2   = (packet >> 8) & 0xFF;
+        uint8_t channel = (packet >> 4) & 0x0F;
+        g_engine_telemetry.writer().midi_event_count++;
+        traceEvent(TraceEvent::MIDI_APPLY, packet >> 8);
+        
+        if (drums && (int8_t)channel == g_drum_channel) {
+            drums->handleMidiPacket(packet, event_frame);
+            return;
+        }
+        if (arpeggiator.isEnabled() && (command == 0x90 || command == 0x80)) {
+            if (command == 0x90 && data2 > 0) {
+                arp_channel = channel;
+                arpeggiator.noteOn(data1, data2, event_frame);
+            } else {
+                arpeggiator.noteOff(data1);
+            }
+        } else if (command == 0x90 && data2 > 0) { // Note on
+            fix15 velocity = (data2 << 8); // Convert MIDI velocity (0-127) to fix15
+            Voice* voice = playNote(channel, data1, velocity);
+            if ((packet & LatencyProbe::PACKET_FLAG) && g_latency_probe.isWaitingForSample()) {
+                latency_probe_voice = voice;
+            }
+        } else if (command == 0x80 || (command == 0x90 && data2 == 0)) { // Note off
+            releaseNote(channel, data1);
+        } else if (command == 0xB0 && data1 == 123) { // All Notes Off (CC 123)
+            arpeggiator.allNotesOff(arpOutput());
+            for (int p = 0; p < MAX_PARTS; ++p) {
+                if (parts[p].listensTo(channel)) handleAllNotesOff(p);
+            }
+        } else if (command == 0xE0) { // Pitch bend
+            for (int p = 0; p < MAX_PARTS; ++p) {
+                if (parts[p].listensTo(channel)) handlePitchBend(parts[p], data1, data2);
             }
         }
     }
 
 private:
-    fix15 processVoice(Voice& voice) {
+    // Adds one voice's output to left/right. With unison off both get the same mono sample.
+    void AUDIO_RAM_FUNC(processVoice)(Voice& voice, const Part& part, int32_t& left, int32_t& right) {
         // OPTIMIZED: Removed per-sample frequency smoothing - frequency is set once per note
         fix15 current_velocity = voice.s_velocity.getNextValue();
         
@@ -299,9 +500,9 @@ private:
         fix15 env_level = voice.envelope.getNextValue();
         
         // Calculate modulated pulse width (SH-101 style PWM) - OPTIMIZED: Use cached values
-        fix15 basePulseWidth = cached_basePulseWidth;
-        fix15 lfoAmount = cached_pwmLfoAmount;
-        fix15 envAmount = cached_pwmEnvAmount;
+        fix15 basePulseWidth = part.cached_basePulseWidth;
+        fix15 lfoAmount = part.cached_pwmLfoAmount;
+        fix15 envAmount = part.cached_pwmEnvAmount;
         
         // Get LFO and envelope values (LFO is now global, shared across voices)
         fix15 lfoValue = modLfo.getSample();  // Triangle wave -1 to +1
@@ -324,46 +525,19 @@ private:
         if (modulatedWidth < minWidth) modulatedWidth = minWidth;
         if (modulatedWidth > maxWidth) modulatedWidth = maxWidth;
         
-        voice.pulseOsc.setPulseWidth(modulatedWidth);
-        
-        // Get oscillator samples
-        fix15 saw_sample = voice.sawOsc.getSample();
-        fix15 pulse_sample = voice.pulseOsc.getSample();
-        fix15 sub_sample = voice.subOsc.getSample();  // Back to separate sub oscillator
+        // Noise is per note, not per oscillator set; so is the sample, which shares its path
         fix15 noise_sample = voice.noiseOsc.getSample();
-        
-        // Get mix levels (SH-101 style - each oscillator has independent level) - OPTIMIZED: Use cached values
-        fix15 sawLevel = cached_sawLevel;
-        fix15 pulseLevel = cached_pulseLevel;
-        fix15 subLevel = cached_subLevel;
-        fix15 noiseLevel = cached_noiseLevel;
-        
-        // Mix oscillators additively (like SH-101)
-        int32_t mixed_sample32 = multfix15(saw_sample, sawLevel) + multfix15(pulse_sample, pulseLevel) + multfix15(sub_sample, subLevel) + multfix15(noise_sample, noiseLevel);
-        
-        // Pure additive oscillator mixing with safe casting
-        // Scale down to prevent overflow while preserving more signal level
-        mixed_sample32 = mixed_sample32 >> 2;  //
-        fix15 mixed_sample = (fix15)mixed_sample32;
+        fix15 noise_mix = multfix15(noise_sample, part.cached_noiseLevel);
+        if (voice.sampler.isPlaying()) noise_mix += multfix15(voice.sampler.getSample(), part.cached_sampleLevel);
         
         // Apply per-voice filter with envelope and keyboard tracking modulation - OPTIMIZED: Use cached values
-        fix15 base_cutoff = cached_filterCutoff;
-        fix15 env_amount = cached_filterEnvAmount;
-        fix15 kbd_amount = cached_filterKeyboardTracking;
-        fix15 resonance = cached_filterResonance;
-        
-        // Calculate keyboard tracking offset (relative to C4 = MIDI note 60) - OPTIMIZED: Pre-compute table
-        // Each octave up/down adds/subtracts a smaller amount for musical tracking
-        static fix15 kbd_tracking_table[128];
-        static bool kbd_table_initialized = false;
-        if (!kbd_table_initialized) {
-            for (int i = 0; i < 128; ++i) {
-                int note_offset = i - 60;  // Distance from C4
-                kbd_tracking_table[i] = float2fix15((note_offset / 12.0f) * 0.15f);
-            }
-            kbd_table_initialized = true;
-        }
-        fix15 kbd_offset = multfix15(kbd_tracking_table[voice.midiNote], kbd_amount);
+        fix15 base_cutoff = part.cached_filterCutoff;
+        fix15 env_amount = part.cached_filterEnvAmount;
+        fix15 kbd_amount = part.cached_filterKeyboardTracking;
+        fix15 resonance = part.cached_filterResonance;
+        
+        // Keyboard tracking offset (relative to C4 = MIDI note 60) from the compile-time table
+        fix15 kbd_offset = multfix15(KBD_TRACKING_TABLE.offset[voice.midiNote & 0x7F], kbd_amount);
         
         // Modulate filter cutoff: base + envelope + keyboard tracking
         fix15 modulated_cutoff = base_cutoff + multfix15(env_level, env_amount) + kbd_offset;
@@ -372,165 +546,469 @@ private:
         if (modulated_cutoff > FIX15_ONE) modulated_cutoff = FIX15_ONE;
         else if (modulated_cutoff < FIX15_ZERO) modulated_cutoff = FIX15_ZERO;
         
-        // Apply per-voice filter
-        fix15 filtered_sample = voice.filter.process(mixed_sample, modulated_cutoff, resonance);
-        
-        // Apply envelope to filtered sample
-        fix15 enveloped_sample = multfix15(filtered_sample, env_level);
+        if (part.unison_count == 1) {
+            OscillatorSet& set = voice.oscs[0];
+            set.pulseOsc.setPulseWidth(modulatedWidth);
+            
+            // Pure additive oscillator mixing with safe casting
+            // Scale down to prevent overflow while preserving more signal level
+            fix15 mixed_sample = (fix15)((mixOscillators(set, part) + noise_mix) >> 2);
+            
+            // Apply per-voice filter, then envelope and velocity
+            fix15 filtered_sample = set.filter.process(mixed_sample, modulated_cutoff, resonance);
+            fix15 output = multfix15(multfix15(filtered_sample, env_level), current_velocity);
+            left += output;
+            right += output;
+            return;
+        }
         
-        // Apply velocity
-        return multfix15(enveloped_sample, current_velocity);
+        // Unison: every set shares the envelope, PWM and cutoff computed above. Panning before
+        // the filter lets a shared-filter stack run one left/right filter pair instead of one per set.
+        fix15 stack_noise = multfix15(noise_mix, part.unison_noise_gain);
+        int32_t left_mix = 0, right_mix = 0;
+        for (int k = 0; k < part.unison_count; ++k) {
+            OscillatorSet& set = voice.oscs[k];
+            set.pulseOsc.setPulseWidth(modulatedWidth);
+            fix15 set_sample = (fix15)((mixOscillators(set, part) + stack_noise) >> 2);
+            if (!part.unison_shared_filter) {
+                set_sample = set.filter.process(set_sample, modulated_cutoff, resonance);
+            }
+            left_mix += multfix15(set_sample, part.unison_gain_left[k]);
+            right_mix += multfix15(set_sample, part.unison_gain_right[k]);
+        }
+        if (part.unison_shared_filter) {
+            left_mix = voice.oscs[0].filter.process((fix15)left_mix, modulated_cutoff, resonance);
+            right_mix = voice.oscs[1].filter.process((fix15)right_mix, modulated_cutoff, resonance);
+        }
+        left += multfix15(multfix15((fix15)left_mix, env_level), current_velocity);
+        right += multfix15(multfix15((fix15)right_mix, env_level), current_velocity);
     }
     
-    // Called from audio thread - updates smoothers with new targets from control thread
-    void updateControlSignals() {
+    // Saw + pulse + sub of one oscillator set at the part's cached mix levels (SH-101 style independent levels)
+    int32_t AUDIO_RAM_FUNC(mixOscillators)(OscillatorSet& set, const Part& part) {
+        return multfix15(set.sawOsc.getSample(), part.cached_sawLevel) +
+               multfix15(set.pulseOsc.getSample(), part.cached_pulseLevel) +
+               multfix15(set.subOsc.getSample(), part.cached_subLevel);
+    }
+    
+    // Rebuilds the part's detune and pan tables when its unison parameters change and retunes its voices
+    void AUDIO_RAM_FUNC(updateUnison)(int p) {
+        Part& part = parts[p];
+        part.unison_shared_filter = part.value(PartParam::UNISON_SHARED_FILTER) >= 0.5f;
+        
+        float voices_value = part.value(PartParam::UNISON_VOICES);
+        float detune_value = part.value(PartParam::UNISON_DETUNE);
+        float spread_value = part.value(PartParam::UNISON_SPREAD);
+        if (voices_value == part.last_unison_voices && detune_value == part.last_unison_detune &&
+            spread_value == part.last_unison_spread) return;
+        part.last_unison_voices = voices_value;
+        part.last_unison_detune = detune_value;
+        part.last_unison_spread = spread_value;
+        
+        part.unison_count = std::max(1, std::min(MAX_UNISON, (int)(voices_value + 0.5f)));
+        float stack_gain = 1.0f / std::sqrt((float)part.unison_count);  // Equal power: a wider stack is not louder
+        part.unison_noise_gain = float2fix15(stack_gain);
+        for (int k = 0; k < MAX_UNISON; ++k) {
+            // Set position across the stack, -1 (lowest, left) to +1 (highest, right)
+            float position = (k < part.unison_count && part.unison_count > 1) ? 2.0f * k / (part.unison_count - 1) - 1.0f : 0.0f;
+            float cents = position * detune_value * 50.0f;
+            part.unison_detune_q16[k] = (int32_t)(cents * (pitch::SEMITONE / 100.0f));
+            float pan = position * spread_value * 0.5f;
+            part.unison_gain_left[k] = float2fix15(stack_gain * (1.0f - pan));
+            part.unison_gain_right[k] = float2fix15(stack_gain * (1.0f + pan));
+        }
+        
+        part.pitch_state.unison = part.unison_count;
+        for (auto& voice : voices) {
+            if (voice.part == p && voice.envelope.isActive()) voice.applyPitch(part.pitch_state);
+        }
+    }
+
+    // Picks up a new channel or voice limit for the part; a channel change releases its notes
+    void updatePartConfig(int p) {
+        Part& part = parts[p];
+        int8_t channel = g_part_config[p].channel;
+        if (channel != part.channel) {
+            if (part.isEnabled()) handleAllNotesOff(p);
+            part.channel = channel;
+        }
+        part.max_voices = g_part_config[p].max_voices;
+    }
+
+    // Copies the part's bank (one contiguous block) and converts what the voice loop needs to fix15
+    void AUDIO_RAM_FUNC(snapshotPart)(Part& part, const PartBank& bank) {
+        for (int i = 0; i < NUM_PART_PARAMS; ++i) {
+            part.values[i] = bank.values[i].load(std::memory_order_relaxed);
+        }
+
         // === OPTIMIZATION: Cache all parameters as fix15 once per buffer ===
         // This eliminates 128x redundant float->fix15 conversions per buffer
-        cached_sawLevel = p_sawLevel ? float2fix15(p_sawLevel->getValue()) : FIX15_ONE;
-        cached_pulseLevel = p_pulseLevel ? float2fix15(p_pulseLevel->getValue()) : FIX15_ZERO;
-        cached_subLevel = p_subLevel ? float2fix15(p_subLevel->getValue()) : FIX15_ZERO;
-        cached_noiseLevel = p_noiseLevel ? float2fix15(p_noiseLevel->getValue()) : FIX15_ZERO;
-        cached_basePulseWidth = p_pulseWidth ? float2fix15(p_pulseWidth->getValue()) : FIX15_HALF;
-        cached_pwmLfoAmount = p_pwmLfoAmount ? float2fix15(p_pwmLfoAmount->getValue()) : FIX15_ZERO;
-        cached_pwmEnvAmount = p_pwmEnvAmount ? float2fix15(p_pwmEnvAmount->getValue()) : FIX15_ZERO;
-        cached_filterCutoff = p_filterCutoff ? float2fix15(p_filterCutoff->getValue()) : float2fix15(0.5f);
-        cached_filterResonance = p_filterResonance ? float2fix15(p_filterResonance->getValue()) : float2fix15(0.2f);
-        cached_filterEnvAmount = p_filterEnvAmount ? float2fix15(p_filterEnvAmount->getValue()) : FIX15_ZERO;
-        cached_filterKeyboardTracking = p_filterKeyboardTracking ? float2fix15(p_filterKeyboardTracking->getValue()) : FIX15_ZERO;
+        part.cached_sawLevel = float2fix15(part.value(PartParam::SAW_LEVEL));
+        part.cached_pulseLevel = float2fix15(part.value(PartParam::PULSE_LEVEL));
+        part.cached_subLevel = float2fix15(part.value(PartParam::SUB_LEVEL));
+        part.cached_noiseLevel = float2fix15(part.value(PartParam::NOISE_LEVEL));
+        part.cached_basePulseWidth = float2fix15(part.value(PartParam::PULSE_WIDTH));
+        part.cached_pwmLfoAmount = float2fix15(part.value(PartParam::PWM_LFO_AMOUNT));
+        part.cached_pwmEnvAmount = float2fix15(part.value(PartParam::PWM_ENV_AMOUNT));
+        part.cached_filterCutoff = float2fix15(part.value(PartParam::FILTER_CUTOFF));
+        part.cached_filterResonance = float2fix15(part.value(PartParam::FILTER_RESONANCE));
+        part.cached_filterEnvAmount = float2fix15(part.value(PartParam::FILTER_ENV_AMOUNT));
+        part.cached_filterKeyboardTracking = float2fix15(part.value(PartParam::FILTER_KEYBOARD_TRACKING));
+        part.cached_sampleLevel = float2fix15(part.value(PartParam::SAMPLE_LEVEL));
+        int sample_index = std::max(0, std::min(samples::NUM_SAMPLES - 1, (int)(part.value(PartParam::SAMPLE_SELECT) + 0.5f)));
+        part.sample = part.cached_sampleLevel > 0 ? &samples::BANK[sample_index] : nullptr;
+    }
+    
+    // Called from audio thread - updates smoothers with new targets from control thread
+    void AUDIO_RAM_FUNC(updateControlSignals)() {
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            updatePartConfig(p);
+            if (parts[p].isEnabled()) snapshotPart(parts[p], g_part_banks[p]);
+        }
         
         // Update global modulation LFO frequency once per buffer
         if (p_pwmLfoRate) {
             fix15 lfoRate = float2fix15(p_pwmLfoRate->getValue());
             modLfo.setFrequency(lfoRate);
         }
+        if (p_vibratoRate) vibratoLfo.setFrequency(float2fix15(p_vibratoRate->getValue()));
+        traceEvent(TraceEvent::PARAM_SNAPSHOT, g_parameter_change_count);
+        
+        uint8_t voice_policy = g_voice_policy;
+        if (voice_policy != applied_voice_policy) {
+            allocator.setPolicy(VoiceAllocator::Policy::unpack(voice_policy));
+            applied_voice_policy = voice_policy;
+        }
+        
+        // Detune/pan tables must be current before new notes are tuned
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            if (!parts[p].isEnabled()) continue;
+            updateUnison(p);
+            updateVoiceMode(p);
+            updatePitchControls(parts[p]);
+        }
+        updateClockTick();
+        updateArpeggiator();
+        
         // Handle MIDI messages from multicore FIFO
+        uint8_t drained = 0;
         while (multicore_fifo_rvalid()) {
-            uint32_t packet = multicore_fifo_pop_blocking();
-            uint8_t command = (packet >> 24) & 0xFF;
-            uint8_t data1   = (packet >> 16) & 0xFF;
-            uint8_t data2   = (packet >> 8) & 0xFF;
-            
-            if (command == 0x90 && data2 > 0) { // Note on
-                fix15 velocity = (data2 << 8); // Convert MIDI velocity (0-127) to fix15
-                handleNoteOn(data1, velocity);
-            } else if (command == 0x80 || (command == 0x90 && data2 == 0)) { // Note off
-                handleNoteOff(data1);
-            } else if (command == 0xB0 && data1 == 123) { // All Notes Off (CC 123)
-                handleAllNotesOff();
-            }
+            handleMidiPacket(multicore_fifo_pop_blocking());
+            drained++;
+        }
+        if (drained > g_engine_telemetry.writer().midi_queue_peak) {
+            g_engine_telemetry.writer().midi_queue_peak = drained;
         }
         
-        // Update parameters from parameter store
-        
-        // Update envelope parameters selectively to avoid interference with active notes
-        if (p_attack && p_decay && p_sustain && p_release) {
-            float attackValue = p_attack->getValue();
-            float decayValue = p_decay->getValue();
-            float sustainValue = p_sustain->getValue();
-            float releaseValue = p_release->getValue();
-            
-            // Cache parameter values to detect changes
-            static float last_attack = -1.0f, last_decay = -1.0f, last_sustain = -1.0f, last_release = -1.0f;
-            
-            bool attack_changed = (attackValue != last_attack);
-            bool decay_changed = (decayValue != last_decay);
-            bool sustain_changed = (sustainValue != last_sustain);
-            bool release_changed = (releaseValue != last_release);
-            
-            // Update parameters based on voice state and what changed
-            for (auto& voice : voices) {
-                auto state = voice.envelope.getState();
-                
-                // Attack/Decay: Only update idle voices (avoids interference with active envelopes)
-                if (state == Fix15VCAEnvelopeModule::State::Idle) {
-                    if (attack_changed) voice.envelope.setAttackTime(attackValue);
-                    if (decay_changed) voice.envelope.setDecayTime(decayValue);
-                }
-                
-                // Sustain/Release: Always update for classic analog synth behavior
-                if (sustain_changed) voice.envelope.setSustainLevel(sustainValue);
-                if (release_changed) voice.envelope.setReleaseTime(releaseValue);
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            if (parts[p].isEnabled()) updateEnvelopes(p);
+        }
+    }
+    
+    // Update envelope parameters selectively to avoid interference with active notes
+    void AUDIO_RAM_FUNC(updateEnvelopes)(int p) {
+        Part& part = parts[p];
+        float attackValue = part.value(PartParam::ATTACK);
+        float decayValue = part.value(PartParam::DECAY);
+        float sustainValue = part.value(PartParam::SUSTAIN);
+        float releaseValue = part.value(PartParam::RELEASE);
+
+        bool attack_changed = (attackValue != part.last_attack);
+        bool decay_changed = (decayValue != part.last_decay);
+        bool sustain_changed = (sustainValue != part.last_sustain);
+        bool release_changed = (releaseValue != part.last_release);
+
+        // Update parameters based on voice state and what changed
+        for (auto& voice : voices) {
+            if (voice.part != p) continue;
+            auto state = voice.envelope.getState();
+
+            // Attack/Decay: Only update idle voices (avoids interference with active envelopes)
+            if (state == Fix15VCAEnvelopeModule::State::Idle) {
+                if (attack_changed) voice.envelope.setAttackTime(attackValue);
+                if (decay_changed) voice.envelope.setDecayTime(decayValue);
+            }
+
+            // Sustain/Release: Always update for classic analog synth behavior
+            if (sustain_changed) voice.envelope.setSustainLevel(sustainValue);
+            if (release_changed) voice.envelope.setReleaseTime(releaseValue);
+        }
+
+        // Cache the values
+        if (attack_changed) part.last_attack = attackValue;
+        if (decay_changed) part.last_decay = decayValue;
+        if (sustain_changed) part.last_sustain = sustainValue;
+        if (release_changed) part.last_release = releaseValue;
+    }
+
+    // Applies voice mode, note priority and portamento time; a mode change releases the part's notes
+    void AUDIO_RAM_FUNC(updateVoiceMode)(int p) {
+        Part& part = parts[p];
+        VoiceMode mode = (VoiceMode)std::max(0, std::min(2, (int)(part.value(PartParam::VOICE_MODE) + 0.5f)));
+        if (mode != part.voice_mode) {
+            handleAllNotesOff(p);
+            part.voice_mode = mode;
+        }
+        part.note_priority = (NoteStack::Priority)std::max(0, std::min(2, (int)(part.value(PartParam::NOTE_PRIORITY) + 0.5f)));
+        float portamento = part.value(PartParam::PORTAMENTO);
+        if (portamento != part.last_portamento) {
+            part.last_portamento = portamento;
+            if (portamento <= 0.0f) {
+                part.glide_coef_q16 = 0;
+            } else {
+                // One-pole in the log-frequency domain: ~98% of the interval within the portamento time
+                float tau_ticks = portamento * 0.25f * sampleRate / PITCH_TICK;
+                part.glide_coef_q16 = std::max(1, (int32_t)((1.0f - std::exp(-1.0f / tau_ticks)) * 65536.0f));
             }
-            
-            // Cache the values
-            if (attack_changed) last_attack = attackValue;
-            if (decay_changed) last_decay = decayValue;
-            if (sustain_changed) last_sustain = sustainValue;
-            if (release_changed) last_release = releaseValue;
         }
     }
     
-    // Helper to update a voice with current envelope parameters (for new notes)
-    void updateVoiceEnvelopeParams(Voice& voice) {
-        if (p_attack && p_decay && p_sustain && p_release) {
-            voice.envelope.setAttackTime(p_attack->getValue());
-            voice.envelope.setDecayTime(p_decay->getValue());
-            voice.envelope.setSustainLevel(p_sustain->getValue());
-            voice.envelope.setReleaseTime(p_release->getValue());
+    // Tempo for the sequencer and arpeggiator: the external MIDI clock while Core 0 has it locked,
+    // otherwise the Tempo parameter
+    void updateClockTick() {
+        uint32_t external = g_midi_clock_samples_per_tick_q16;
+        if (external) {
+            clock_tick_q16 = external;
+            return;
         }
+        float bpm = std::max(1.0f, p_seqTempo ? p_seqTempo->getValue() : 120.0f);
+        clock_tick_q16 = (uint64_t)(sampleRate * 60.0f / (bpm * MidiClockTracker::TICKS_PER_BEAT) * 65536.0f);
     }
     
-    void handleNoteOn(uint8_t note, fix15 velocity) {
-        // 1. FIRST: Check if this note is already playing OR still sounding - steal it immediately
-        for (auto& voice : voices) {
-            if (voice.midiNote == note && (voice.isActive || voice.envelope.isActive())) {
-                updateVoiceEnvelopeParams(voice);  // Update envelope params for retriggered note
-                voice.noteOn(note, velocity, sampleRate); // Retrigger the same note
-                return; // Don't allow duplicate notes, even if in release phase
+    // Arpeggiator mode, range, gate and step length; steps are 1/4 to 1/32 notes (24 to 3 clock ticks)
+    void updateArpeggiator() {
+        auto mode = Arpeggiator::Mode::OFF;
+        if (p_arpMode) mode = (Arpeggiator::Mode)std::max(0, std::min(4, (int)(p_arpMode->getValue() + 0.5f)));
+        int octaves = p_arpOctaves ? (int)(p_arpOctaves->getValue() + 0.5f) : 1;
+        float gate = p_arpGate ? p_arpGate->getValue() : 0.5f;
+        int division = p_arpRate ? std::max(0, std::min(3, (int)(p_arpRate->getValue() + 0.5f))) : 2;
+        arpeggiator.configure(mode, octaves, gate, (clock_tick_q16 * MidiClockTracker::TICKS_PER_BEAT) >> division,
+                              arpOutput());
+    }
+    
+    // Where arpeggiated notes go: straight to the parts on the arpeggiator's channel, bypassing it.
+    // A note ends on the channel it started on, even if a key on another channel came in meanwhile.
+    struct ArpOutput {
+        Sh101StyleSynth* synth;
+        void operator()(uint8_t command, uint8_t note, uint8_t velocity) const {
+            if (command == Arpeggiator::NOTE_ON) {
+                synth->arp_sounding_channel = synth->arp_channel;
+                synth->playNote(synth->arp_channel, note, (fix15)(velocity << 8));
+            } else {
+                synth->releaseNote(synth->arp_sounding_channel, note);
             }
         }
-        
-        // 2. Find the first completely idle voice
-        for (auto& voice : voices) {
-            if (!voice.envelope.isActive()) {
-                updateVoiceEnvelopeParams(voice);  // Update envelope params for new note
-                voice.noteOn(note, velocity, sampleRate);
-                return; // Found a free voice, we're done
-            }
+    };
+    ArpOutput arpOutput() { return ArpOutput{this}; }
+    
+    // Note on for every part listening on the channel; returns the first part's voice
+    Voice* AUDIO_RAM_FUNC(playNote)(uint8_t channel, uint8_t note, fix15 velocity) {
+        Voice* first = nullptr;
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            if (!parts[p].listensTo(channel)) continue;
+            Voice* voice = handleNoteOn(p, note, velocity);
+            if (!first) first = voice;
         }
-        
-        // 3. If no idle voices, look for voices in release phase (prefer stealing these)
-        for (auto& voice : voices) {
-            if (voice.envelope.getState() == Fix15VCAEnvelopeModule::State::Release) {
-                updateVoiceEnvelopeParams(voice);  // Update envelope params for stolen voice
-                voice.noteOn(note, velocity, sampleRate);
-                return; // Found a releasing voice to reuse
-            }
+        return first;
+    }
+
+    void releaseNote(uint8_t channel, uint8_t note) {
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            if (parts[p].listensTo(channel)) handleNoteOff(p, note);
         }
-        
-        // 4. ONLY IF MORE THAN 4 NOTES: steal the oldest voice (FIFO)
-        // This should rarely happen with 4 voices - only when playing more than 4 simultaneous notes
-        size_t oldest_voice = 0;
-        for (size_t i = 1; i < voices.size(); ++i) {
-            // Find voice that's been playing longest (simple heuristic: lowest envelope level in sustain)
-            if (voices[i].envelope.getState() == Fix15VCAEnvelopeModule::State::Sustain &&
-                voices[oldest_voice].envelope.getState() == Fix15VCAEnvelopeModule::State::Sustain) {
-                // Both in sustain, steal the one with lower envelope level (been playing longer)
-                if (voices[i].envelope.getNextValue() < voices[oldest_voice].envelope.getNextValue()) {
-                    oldest_voice = i;
+    }
+
+    // The part's bend range and mod wheel depth (once per block)
+    void updatePitchControls(Part& part) {
+        int32_t range_q16 = (int32_t)(part.value(PartParam::BEND_RANGE) * pitch::SEMITONE);
+        part.bend_q16 = (int32_t)(((int64_t)part.bend_value * range_q16) >> 13);
+        // Full mod wheel = +/- half a semitone
+        part.vibrato_depth_q16 = (int32_t)(part.value(PartParam::MOD_WHEEL) * (pitch::SEMITONE / 2));
+    }
+    
+    // 14-bit pitch bend from the FIFO (LSB in data1, MSB in data2)
+    void handlePitchBend(Part& part, uint8_t lsb, uint8_t msb) {
+        part.bend_value = (int32_t)(((msb & 0x7F) << 7) | (lsb & 0x7F)) - 8192;
+        updatePitchControls(part);
+    }
+    
+    // Once per PITCH_TICK: advances glide and vibrato, retunes the voices whose pitch moved
+    void AUDIO_RAM_FUNC(updatePitchModulation)() {
+        // One vibrato LFO, read only while some part has the mod wheel up
+        bool vibrato_on = false;
+        for (const auto& part : parts) vibrato_on |= part.isEnabled() && part.vibrato_depth_q16 != 0;
+        int32_t vibrato = vibrato_on ? vibratoLfo.getSample() : 0;
+        
+        for (int p = 0; p < MAX_PARTS; ++p) {
+            Part& part = parts[p];
+            if (!part.isEnabled()) continue;
+            Voice* mono = monoVoice(p);
+            bool glided = part.voice_mode != VoiceMode::POLY && mono && advanceGlide(part, *mono);
+
+            int32_t offset = part.bend_q16;
+            if (part.vibrato_depth_q16 != 0) {
+                offset += (int32_t)(((int64_t)vibrato * part.vibrato_depth_q16) >> 15);
+            }
+            if (offset != part.pitch_state.offset_q16) {
+                part.pitch_state.offset_q16 = offset;
+                for (auto& voice : voices) {
+                    if (voice.part == p && voice.envelope.isActive()) voice.applyPitch(part.pitch_state);
                 }
+            } else if (glided) {
+                mono->applyPitch(part.pitch_state);
             }
         }
-        updateVoiceEnvelopeParams(voices[oldest_voice]);  // Update envelope params for stolen voice
-        voices[oldest_voice].noteOn(note, velocity, sampleRate);
     }
     
-    void handleNoteOff(uint8_t note) {
-        // Find the voice playing this note and turn it off
-        for (auto& voice : voices) {
-            if (voice.isActive && voice.midiNote == note) {
-                voice.noteOff();
-                return; // A note should only be active on one voice at a time
-            }
+    // Moves the pitch a step towards its target; returns false when already there
+    bool advanceGlide(const Part& part, Voice& voice) {
+        if (voice.pitch_q16 == voice.target_pitch_q16) return false;
+        int32_t step = (int32_t)(((int64_t)(voice.target_pitch_q16 - voice.pitch_q16) * part.glide_coef_q16) >> 16);
+        if (step == 0 || part.glide_coef_q16 == 0) {
+            voice.pitch_q16 = voice.target_pitch_q16;   // Close enough (or glide switched off): land exactly
+        } else {
+            voice.pitch_q16 += step;
         }
+        return true;
     }
     
-    void handleAllNotesOff() {
-        // Turn off all active voices immediately
-        for (auto& voice : voices) {
-            if (voice.isActive) {
-                voice.noteOff();
+    // Points the mono voice at a new note, gliding there when portamento is on
+    void glideTo(const Part& part, Voice& voice, uint8_t note) {
+        voice.midiNote = note;
+        voice.target_pitch_q16 = pitch::fromNote(note);
+        if (part.glide_coef_q16 == 0) {
+            voice.pitch_q16 = voice.target_pitch_q16;
+            voice.applyPitch(part.pitch_state);
+        }
+    }
+    
+    // Envelope retrigger without a phase reset (mono mode note changes)
+    void retriggerMonoVoice(const Part& part, Voice& voice, fix15 velocity) {
+        updateVoiceEnvelopeParams(part, voice);
+        voice.isActive = true;
+        voice.velocity = velocity;
+        voice.s_velocity.setTargetValue(velocity);
+        voice.envelope.noteOn();
+        if (part.sample) {
+            voice.sampler.start(*part.sample);
+            voice.applyPitch(part.pitch_state);
+        }
+    }
+    
+    // A mono part holds one allocator key; its note 0 slot is free because mono parts never key real notes
+    static uint16_t monoKey(int p) { return VoiceAllocator::key((uint8_t)p, 0); }
+
+    // The part's last mono voice, unless another part has taken it since
+    Voice* monoVoice(int p) {
+        int8_t v = parts[p].mono_voice;
+        return (v != VoiceAllocator::NONE && voices[v].part == p) ? &voices[v] : nullptr;
+    }
+
+    // True while the part's mono voice is still keyed (not stolen or released)
+    bool ownsMonoVoice(int p) {
+        int8_t v = parts[p].mono_voice;
+        return monoVoice(p) && allocator.isHeld(v) && allocator.getKey(v) == monoKey(p);
+    }
+
+    Voice* AUDIO_RAM_FUNC(handleMonoNoteOn)(int p, uint8_t note, fix15 velocity) {
+        Part& part = parts[p];
+        bool phrase_start = part.held_notes.isEmpty() || !ownsMonoVoice(p);
+        part.held_notes.push(note);
+        uint8_t target = (uint8_t)part.held_notes.select(part.note_priority);
+        
+        if (phrase_start) {
+            // First key: a normal note, gliding from wherever the part's last phrase ended.
+            // The previous phrase's voice is reused when free, so the line keeps its filter state.
+            Voice* previous = monoVoice(p);
+            int32_t previous_pitch = previous ? previous->pitch_q16 : 0;
+            auto allocation = allocator.noteOn(monoKey(p), [this](int v) { return voices[v].envelope.getCurrentLevel(); },
+                                               part.max_voices, part.mono_voice);
+            if (allocation.voice == VoiceAllocator::NONE) return nullptr;
+            if (allocation.released != VoiceAllocator::NONE) voices[allocation.released].noteOff();
+            part.mono_voice = allocation.voice;
+            Voice& voice = voices[allocation.voice];
+            voice.part = (uint8_t)p;
+            updateVoiceEnvelopeParams(part, voice);
+            voice.noteOn(target, velocity, part.pitch_state, part.sample);
+            if (part.glide_coef_q16 != 0 && previous_pitch != 0) {
+                voice.pitch_q16 = previous_pitch;
+                voice.applyPitch(part.pitch_state);
             }
+            traceEvent(allocation.stolen ? TraceEvent::VOICE_STEAL : TraceEvent::VOICE_ALLOCATE,
+                       (uint32_t)(allocation.voice << 8) | target);
+            return &voice;
+        }
+
+        Voice& voice = voices[part.mono_voice];
+        if (target != voice.midiNote) {
+            if (part.voice_mode == VoiceMode::MONO) retriggerMonoVoice(part, voice, velocity);
+            glideTo(part, voice, target);
+        }
+        traceEvent(TraceEvent::VOICE_ALLOCATE, target);
+        return &voice;
+    }
+    
+    void AUDIO_RAM_FUNC(handleMonoNoteOff)(int p, uint8_t note) {
+        Part& part = parts[p];
+        if (!part.held_notes.remove(note) || !ownsMonoVoice(p)) return;
+        Voice& voice = voices[part.mono_voice];
+        if (part.held_notes.isEmpty()) {
+            allocator.noteOff(monoKey(p));
+            voice.noteOff();
+            return;
+        }
+        // Fall back to a key that is still held
+        uint8_t target = (uint8_t)part.held_notes.select(part.note_priority);
+        if (target != voice.midiNote) {
+            if (part.voice_mode == VoiceMode::MONO) retriggerMonoVoice(part, voice, voice.velocity);
+            glideTo(part, voice, target);
+        }
+    }
+    
+    // Helper to update a voice with the part's current envelope parameters (for new notes)
+    void updateVoiceEnvelopeParams(const Part& part, Voice& voice) {
+        voice.envelope.setAttackTime(part.value(PartParam::ATTACK));
+        voice.envelope.setDecayTime(part.value(PartParam::DECAY));
+        voice.envelope.setSustainLevel(part.value(PartParam::SUSTAIN));
+        voice.envelope.setReleaseTime(part.value(PartParam::RELEASE));
+    }
+    
+    // Returns the voice that will play the note
+    Voice* AUDIO_RAM_FUNC(handleNoteOn)(int p, uint8_t note, fix15 velocity) {
+        Part& part = parts[p];
+        if (part.voice_mode != VoiceMode::POLY) return handleMonoNoteOn(p, note, velocity);
+        
+        auto allocation = allocator.noteOn(VoiceAllocator::key((uint8_t)p, note),
+                                           [this](int v) { return voices[v].envelope.getCurrentLevel(); },
+                                           part.max_voices);
+        if (allocation.voice == VoiceAllocator::NONE) return nullptr;
+        if (allocation.released != VoiceAllocator::NONE) {
+            voices[allocation.released].noteOff();  // Same note stacked on a new voice
         }
+        
+        Voice& voice = voices[allocation.voice];
+        voice.part = (uint8_t)p;
+        updateVoiceEnvelopeParams(part, voice);  // Update envelope params for the new or stolen note
+        voice.noteOn(note, velocity, part.pitch_state, part.sample); // Envelope StealFade handles a still sounding voice
+        traceEvent(allocation.stolen ? TraceEvent::VOICE_STEAL : TraceEvent::VOICE_ALLOCATE,
+                   (uint32_t)(allocation.voice << 8) | note);
+        return &voice;
+    }
+    
+    void AUDIO_RAM_FUNC(handleNoteOff)(int p, uint8_t note) {
+        if (parts[p].voice_mode != VoiceMode::POLY) {
+            handleMonoNoteOff(p, note);
+            return;
+        }
+        int8_t voice = allocator.noteOff(VoiceAllocator::key((uint8_t)p, note));
+        if (voice != VoiceAllocator::NONE) {
+            voices[voice].noteOff();
+        }
+    }
+    
+    // Releases the part's notes; in the mono modes that is its single keyed voice
+    void handleAllNotesOff(int p) {
+        parts[p].held_notes.clear();
+        allocator.releaseGroup(p, [this](int v) { voices[v].noteOff(); });
     }
 };
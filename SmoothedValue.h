@@ -6,6 +6,7 @@
 #include <cmath>
 #include <algorithm>
 #include "Fix15.h"
+#include "MemoryPlacement.h"
 #include "pico/multicore.h" // For memory barriers
 
 /**
@@ -166,7 +167,7 @@ public:
 
     /// Advances the smoothed value by one sample and returns it.
     /// LOCKLESS: Called from audio thread, never blocks
-    fix15 getNextValue() noexcept
+    fix15 AUDIO_RAM_FUNC(getNextValue)() noexcept
     {
         // Check for new target from control thread (lockless read)
         if (hasNewTarget)
@@ -0,0 +1,225 @@
+/**
+ * StepSequencer.h - 16-step pattern sequencer clocked by the audio sample counter
+ *
+ * The pattern (g_sequencer_pattern) is edited from Core 0 by the SEQ_ serial
+ * commands; the transport runs on Core 1 inside the synth's process(). Step
+ * times are counted in samples on a Q16 grid, so tempo never drifts, and the
+ * synth applies each note at its exact frame within the block instead of at
+ * the block start. Timing does not depend on USB or the browser at all.
+ *
+ * Per track: note, MIDI channel (which multitimbral part plays it), gate length
+ * and chance; per step: velocity (0 = rest) and
+ * its own chance. A step plays when a roll of the audio-core PRNG passes
+ * track chance x step chance. Swing delays every odd step by up to half a step.
+ *
+ * Core 1 never reads a pattern Core 0 is writing: g_sequencer_pattern keeps
+ * Core 0's working copy plus two published slots (SequencerPatternBuffer).
+ * Edits are copied into the slot Core 1 is not using and made current with
+ * one index store, and Core 1 takes the current slot once per block, so a
+ * multi-field edit (a track's note and gate, a whole PATTERN: line) lands
+ * all at once on a block boundary.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "MemoryPlacement.h"
+#include "pico/multicore.h" // For memory barriers
+
+struct SequencerTrack {
+    static constexpr int NUM_STEPS = 16;
+
+    uint8_t note = 60;
+    uint8_t channel = 0;           // 0-15
+    uint8_t chance = 100;          // Percent, applies to every step of the track
+    uint16_t gate_ms = 150;        // Note length
+    uint8_t velocity[NUM_STEPS] = {};  // 0 = rest
+    uint8_t step_chance[NUM_STEPS] = {100, 100, 100, 100, 100, 100, 100, 100,
+                                      100, 100, 100, 100, 100, 100, 100, 100};
+};
+
+struct SequencerPattern {
+    static constexpr int MAX_TRACKS = 8;
+
+    SequencerTrack tracks[MAX_TRACKS];
+    uint8_t num_tracks = 1;
+    uint8_t length = SequencerTrack::NUM_STEPS;   // Steps before the pattern wraps
+};
+
+class SequencerPatternBuffer {
+public:
+    // === Core 0 interface ===
+    // The working copy; edits reach Core 1 on the next publish()
+    SequencerPattern& edit() {
+        dirty = true;
+        return editing;
+    }
+
+    // Copies the working copy into the slot Core 1 is not using and makes it current.
+    // Returns false while Core 1 still holds that slot (it moves off within one block);
+    // the Core 0 loop calls this again until it succeeds.
+    bool publish() {
+        if (!dirty) return true;
+        uint8_t back = published ^ 1;
+        __dmb();
+        if (in_use == back) return false;
+        slots[back] = editing;
+        __dmb(); // Slot contents must be visible before the index
+        published = back;
+        dirty = false;
+        return true;
+    }
+
+    // === Core 1 interface ===
+    // The newest published pattern, valid until the next acquire() (call once per block)
+    const SequencerPattern& acquire() {
+        uint8_t slot;
+        do {
+            slot = published;
+            in_use = slot;
+            __dmb();
+        } while (published != slot); // Core 0 flipped in between: take the newer slot
+        return slots[slot];
+    }
+
+private:
+    SequencerPattern editing;           // Core 0 only
+    SequencerPattern slots[2];
+    volatile uint8_t published = 0;     // Written by Core 0
+    volatile uint8_t in_use = 0;        // Written by Core 1
+    bool dirty = false;                 // Core 0 only
+};
+
+// Edited by Core 0 (SEQ_ commands), read by Core 1 once per block
+inline SequencerPatternBuffer g_sequencer_pattern;
+
+// Transport requests from Core 0: run flag, and a counter bumped for every SEQ_RESET
+inline volatile bool g_sequencer_running = false;
+inline volatile uint32_t g_sequencer_reset_requests = 0;
+
+// Published by Core 1: the step that fired last (-1 before the first), reported as SEQ_POS
+inline volatile int8_t g_sequencer_position = -1;
+
+class StepSequencer {
+public:
+    static constexpr uint8_t NOTE_ON = 0x90;
+    static constexpr uint8_t NOTE_OFF = 0x80;
+    static constexpr int NO_EVENT = -1;
+
+    void setSampleRate(float sample_rate) { sampleRate = sample_rate; }
+
+    // Once per block, before the frame loop: applies transport requests, step length (Q16 samples) and swing.
+    // emit(command, note, velocity, channel) plays the sequencer's notes.
+    template <typename EmitFn>
+    void AUDIO_RAM_FUNC(beginBlock)(uint64_t new_step_length_q16, float swing, EmitFn&& emit) {
+        step_length_q16 = new_step_length_q16 > 0 ? new_step_length_q16 : 1;
+        if (swing < 0.0f) swing = 0.0f;
+        if (swing > 1.0f) swing = 1.0f;
+        swing_delay = (uint32_t)((step_length_q16 >> 17) * swing);
+
+        if (g_sequencer_reset_requests != seen_resets) {
+            seen_resets = g_sequencer_reset_requests;
+            step = 0;
+            grid_q16 = clock << 16;
+            g_sequencer_position = -1;
+        }
+        pattern = &g_sequencer_pattern.acquire();
+        if (g_sequencer_running != running) {
+            running = g_sequencer_running;
+            if (running) grid_q16 = clock << 16;   // Resume with the current step at this block's first frame
+            else releaseAll(emit);
+        }
+        if (step >= pattern->length) step = 0;
+        next_step_time = (grid_q16 >> 16) + ((step & 1) ? swing_delay : 0);
+    }
+
+    // Frame within a block of block_frames where the next event is due, or NO_EVENT
+    int nextEventFrame(uint32_t block_frames) const {
+        uint64_t next = UINT64_MAX;
+        if (running) next = next_step_time;
+        for (int t = 0; t < SequencerPattern::MAX_TRACKS; ++t) {
+            if (sounding[t] && note_off_time[t] < next) next = note_off_time[t];
+        }
+        if (next == UINT64_MAX) return NO_EVENT;
+        if (next <= clock) return 0;
+        return (next - clock < block_frames) ? (int)(next - clock) : NO_EVENT;
+    }
+
+    // Plays everything due at or before the given frame of the current block
+    template <typename EmitFn>
+    void AUDIO_RAM_FUNC(processEvents)(uint32_t frame, EmitFn&& emit) {
+        uint64_t now = clock + frame;
+        for (int t = 0; t < SequencerPattern::MAX_TRACKS; ++t) {
+            if (sounding[t] && note_off_time[t] <= now) {
+                emit(NOTE_OFF, sounding_note[t], 0, sounding_channel[t]);
+                sounding[t] = false;
+            }
+        }
+        if (running && next_step_time <= now) fireStep(now, emit);
+    }
+
+    void endBlock(uint32_t block_frames) { clock += block_frames; }
+
+private:
+    template <typename EmitFn>
+    void AUDIO_RAM_FUNC(fireStep)(uint64_t now, EmitFn&& emit) {
+        uint32_t gate_scale = (uint32_t)(sampleRate / 1000.0f * 65536.0f);   // Q16 samples per ms
+        int num_tracks = pattern->num_tracks;
+        if (num_tracks > SequencerPattern::MAX_TRACKS) num_tracks = SequencerPattern::MAX_TRACKS;
+
+        for (int t = 0; t < num_tracks; ++t) {
+            const SequencerTrack& track = pattern->tracks[t];
+            uint8_t velocity = track.velocity[step];
+            if (velocity == 0) continue;
+            uint32_t chance = (uint32_t)track.chance * track.step_chance[step];   // Percent squared
+            if (chance < 10000 && nextRandom() % 10000 >= chance) continue;
+
+            // A track is monophonic: its previous note ends before the next starts
+            if (sounding[t]) emit(NOTE_OFF, sounding_note[t], 0, sounding_channel[t]);
+            sounding_note[t] = track.note & 0x7F;
+            sounding_channel[t] = track.channel & 0x0F;
+            emit(NOTE_ON, sounding_note[t], velocity & 0x7F, sounding_channel[t]);
+            uint64_t gate = ((uint64_t)track.gate_ms * gate_scale) >> 16;
+            note_off_time[t] = now + (gate > 0 ? gate : 1);
+            sounding[t] = true;
+        }
+
+        g_sequencer_position = (int8_t)step;
+        grid_q16 += step_length_q16;
+        if (++step >= pattern->length) step = 0;
+        next_step_time = (grid_q16 >> 16) + ((step & 1) ? swing_delay : 0);
+    }
+
+    template <typename EmitFn>
+    void releaseAll(EmitFn& emit) {
+        for (int t = 0; t < SequencerPattern::MAX_TRACKS; ++t) {
+            if (sounding[t]) emit(NOTE_OFF, sounding_note[t], 0, sounding_channel[t]);
+            sounding[t] = false;
+        }
+    }
+
+    // xorshift32: deterministic, so a pattern with chances replays the same way from boot
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    float sampleRate = 44100.0f;
+    const SequencerPattern* pattern = nullptr;  // Taken from g_sequencer_pattern in beginBlock()
+    uint64_t clock = 0;                 // Samples rendered before the current block
+    uint64_t grid_q16 = 0;              // Unswung time of the next step, Q16 samples
+    uint64_t step_length_q16 = 0;
+    uint64_t next_step_time = 0;        // Sample the next step fires on (swing applied)
+    uint32_t swing_delay = 0;           // Samples odd steps are late
+    uint8_t step = 0;                   // Next step to fire
+    bool running = false;
+    uint32_t seen_resets = 0;
+    uint32_t rng = 0x2545F491u;
+
+    bool sounding[SequencerPattern::MAX_TRACKS] = {};
+    uint8_t sounding_note[SequencerPattern::MAX_TRACKS] = {};
+    uint8_t sounding_channel[SequencerPattern::MAX_TRACKS] = {};   // A note ends where it started
+    uint64_t note_off_time[SequencerPattern::MAX_TRACKS] = {};
+};
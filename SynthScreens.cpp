@@ -1,34 +1,38 @@
 #include "SynthScreens.h"
 #include "ParameterStore.h"
+#include "AudioCapture.h"
+#include "EngineTelemetry.h"
 #include <cmath>
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
 
 SynthScreenManager::SynthScreenManager() 
     : current_screen_(SynthScreen::WAVEFORM)
     , last_auto_screen_(SynthScreen::PARAM_ONLY)
+    , home_screen_(SynthScreen::WAVEFORM)
     , screen_switch_time_(0)
     , screen_timeout_ms_(500)  // Show parameter screen for 1 second
     , last_update_time_(0)
     , update_interval_ms_(100)  // 10fps for smooth graphics
     , has_pending_update_(false)
     , waveform_write_pos_(0)
-    , waveform_scale_(1.0f)
-    , display_(nullptr) {
+    , waveform_scale_(FIX15_ONE) {
     
-    display_ = new OledDisplay();
-    display_->init();
+    finishBootOled();
+    display_.init();
     
     // Initialize waveform buffer to zero
     for (int i = 0; i < WAVEFORM_BUFFER_SIZE; i++) {
-        waveform_buffer_[i] = 0.0f;
+        waveform_buffer_[i] = 0;
     }
     
     // Load actual parameter values from the synth instead of using defaults
     loadParameterValuesFromStore();
 }
 
-void SynthScreenManager::showParameter(const std::string& name, float value) {
+void SynthScreenManager::showParameter(std::string_view name, float value) {
     // Store the parameter value
     storeParameterValue(name, value);
     
@@ -64,31 +68,27 @@ void SynthScreenManager::showParameter(const std::string& name, float value) {
 void SynthScreenManager::update() {
     uint32_t now = to_ms_since_boot(get_absolute_time());
     
-    // Handle screen timeout - return to waveform view  
-    if (current_screen_ != SynthScreen::WAVEFORM && 
+    // Handle screen timeout - return to home view (waveform or spectrum)
+    if (current_screen_ != home_screen_ && 
         (now - screen_switch_time_) > screen_timeout_ms_) {
-        current_screen_ = SynthScreen::WAVEFORM;
+        current_screen_ = home_screen_;
     }
     
-    // Simple update logic: parameter screens when needed, waveform continuously
-    if (has_pending_update_) {
-        // Immediate update for parameter changes
-        drawCurrentScreen();
-        has_pending_update_ = false;
-        last_update_time_ = now;
-    } else if (current_screen_ == SynthScreen::WAVEFORM && 
-               (now - last_update_time_) >= update_interval_ms_) {
-        // Continuous updates for waveform screen only
-        drawCurrentScreen();
-        last_update_time_ = now;
+    // Widgets are only recreated when the screen changes
+    if (!layout_valid_ || layout_screen_ != current_screen_) {
+        buildCurrentScreen();
     }
     
-    // Also update parameter screens periodically when active (for fader animation)
-    else if (current_screen_ != SynthScreen::WAVEFORM && 
-             (now - last_update_time_) >= update_interval_ms_) {
-        drawCurrentScreen();
+    // Parameter changes refresh immediately, everything else at the update rate
+    if (has_pending_update_ || (now - last_update_time_) >= update_interval_ms_) {
+        refreshWidgets();
+        canvas_.render(display_);
+        has_pending_update_ = false;
         last_update_time_ = now;
     }
+    
+    // Push whatever changed; retried on later calls while the I2C DMA is busy
+    canvas_.flush(display_);
 }
 
 void SynthScreenManager::switchToScreen(SynthScreen screen) {
@@ -105,12 +105,24 @@ void SynthScreenManager::nextScreen() {
         case SynthScreen::FILTER: switchToScreen(SynthScreen::PWM); break;
         case SynthScreen::PWM: switchToScreen(SynthScreen::MASTER); break;
         case SynthScreen::MASTER: switchToScreen(SynthScreen::WAVEFORM); break;
-        case SynthScreen::WAVEFORM: switchToScreen(SynthScreen::PARAM_ONLY); break;
+        case SynthScreen::WAVEFORM: switchToScreen(SynthScreen::SPECTRUM); break;
+        case SynthScreen::SPECTRUM: switchToScreen(SynthScreen::PERFORMANCE); break;
+        case SynthScreen::PERFORMANCE: switchToScreen(SynthScreen::PARAM_ONLY); break;
+    }
+}
+
+void SynthScreenManager::setHomeScreen(SynthScreen screen) {
+    home_screen_ = screen;
+    switchToScreen(screen);
+    
+    // Start the first capture right away so the spectrum has data on its first frame
+    if (screen == SynthScreen::SPECTRUM) {
+        g_audio_capture.request();
     }
 }
 
 // Parameter type detection
-SynthScreen SynthScreenManager::detectScreenFromParameter(const std::string& name) {
+SynthScreen SynthScreenManager::detectScreenFromParameter(std::string_view name) {
     if (isADSRParam(name)) return SynthScreen::ADSR;
     if (isMixerParam(name)) return SynthScreen::MIXER;
     if (isFilterParam(name)) return SynthScreen::FILTER;
@@ -119,21 +131,21 @@ SynthScreen SynthScreenManager::detectScreenFromParameter(const std::string& nam
     return SynthScreen::PARAM_ONLY;
 }
 
-bool SynthScreenManager::isADSRParam(const std::string& name) {
+bool SynthScreenManager::isADSRParam(std::string_view name) {
     return name == "attack" ||
            name == "decay" ||
            name == "sustain" ||
            name == "release";
 }
 
-bool SynthScreenManager::isMixerParam(const std::string& name) {
+bool SynthScreenManager::isMixerParam(std::string_view name) {
     return name == "sawLevel" ||
            name == "pulseLevel" ||
            name == "subLevel" ||
            name == "noiseLevel";
 }
 
-bool SynthScreenManager::isFilterParam(const std::string& name) {
+bool SynthScreenManager::isFilterParam(std::string_view name) {
     return name == "filterCutoff" ||
            name == "filterResonance" ||
            name == "filterEnvAmount" ||
@@ -141,182 +153,301 @@ bool SynthScreenManager::isFilterParam(const std::string& name) {
 }
 
 
-bool SynthScreenManager::isPWMParam(const std::string& name) {
+bool SynthScreenManager::isPWMParam(std::string_view name) {
     return name == "pulseWidth" ||
            name == "pwmLfoAmount" ||
            name == "pwmLfoRate" ||
            name == "pwmEnvAmount";
 }
 
-bool SynthScreenManager::isMasterParam(const std::string& name) {
+bool SynthScreenManager::isMasterParam(std::string_view name) {
     return name == "masterVol";
 }
 
-void SynthScreenManager::storeParameterValue(const std::string& name, float value) {
+void SynthScreenManager::storeParameterValue(std::string_view name, float value) {
+    // Convert once here so drawing never touches floats
+    fix15 v = float2fix15(value);
+    
     // Use exact parameter names for reliable matching
     
     // ADSR parameters
-    if (name == "attack") adsr_attack_ = value;
-    else if (name == "decay") adsr_decay_ = value;
-    else if (name == "sustain") adsr_sustain_ = value;
-    else if (name == "release") adsr_release_ = value;
+    if (name == "attack") adsr_attack_ = v;
+    else if (name == "decay") adsr_decay_ = v;
+    else if (name == "sustain") adsr_sustain_ = v;
+    else if (name == "release") adsr_release_ = v;
     
     // Mixer parameters
-    else if (name == "sawLevel") mixer_saw_ = value;
-    else if (name == "pulseLevel") mixer_pulse_ = value;
-    else if (name == "subLevel") mixer_sub_ = value;
-    else if (name == "noiseLevel") mixer_noise_ = value;
-    else if (name == "masterVol") mixer_master_ = value;
+    else if (name == "sawLevel") mixer_saw_ = v;
+    else if (name == "pulseLevel") mixer_pulse_ = v;
+    else if (name == "subLevel") mixer_sub_ = v;
+    else if (name == "noiseLevel") mixer_noise_ = v;
+    else if (name == "masterVol") mixer_master_ = v;
     
     // Filter parameters  
-    else if (name == "filterCutoff") filter_cutoff_ = value;
-    else if (name == "filterResonance") filter_resonance_ = value;
-    else if (name == "filterEnvAmount") filter_envelope_ = value;
-    else if (name == "filterKeyboardTracking") filter_keyboard_ = value;
+    else if (name == "filterCutoff") filter_cutoff_ = v;
+    else if (name == "filterResonance") filter_resonance_ = v;
+    else if (name == "filterEnvAmount") filter_envelope_ = v;
+    else if (name == "filterKeyboardTracking") filter_keyboard_ = v;
     
     // PWM parameters
-    else if (name == "pulseWidth") pulse_width_ = value;
-    else if (name == "pwmLfoAmount") pwm_lfo_amount_ = value;
-    else if (name == "pwmLfoRate") pwm_lfo_rate_ = value;
-    else if (name == "pwmEnvAmount") pwm_env_amount_ = value;
+    else if (name == "pulseWidth") pulse_width_ = v;
+    else if (name == "pwmLfoAmount") pwm_lfo_amount_ = v;
+    else if (name == "pwmLfoRate") pwm_lfo_rate_ = v;
+    else if (name == "pwmEnvAmount") pwm_env_amount_ = v;
     
     // Waveform display parameters
-    else if (name == "waveformToggle") waveform_scale_ = 1.0f + (value * 9.0f);  // Scale from 1x to 10x
+    else if (name == "waveformToggle") waveform_scale_ = FIX15_ONE + v * 9;  // Scale from 1x to 10x
 }
 
-void SynthScreenManager::drawCurrentScreen() {
+void SynthScreenManager::buildCurrentScreen() {
+    canvas_.clear();
+    num_faders_ = 0;
+    scope_id_ = -1;
+    param_name_id_ = -1;
+    param_value_id_ = -1;
+    
     switch (current_screen_) {
-        case SynthScreen::ADSR: drawADSRScreen(); break;
-        case SynthScreen::MIXER: drawMixerScreen(); break;
-        case SynthScreen::FILTER: drawFilterScreen(); break;
-        case SynthScreen::PWM: drawPWMScreen(); break;
-        case SynthScreen::MASTER: drawMasterScreen(); break;
-        case SynthScreen::WAVEFORM: drawWaveformScreen(); break;
-        case SynthScreen::PARAM_ONLY: drawParamOnlyScreen(); break;
+        case SynthScreen::ADSR: {
+            const FaderSpec faders[] = {
+                {15, "A", &adsr_attack_}, {40, "D", &adsr_decay_},
+                {65, "S", &adsr_sustain_}, {90, "R", &adsr_release_}
+            };
+            buildFaderScreen(faders, 4);
+            break;
+        }
+        case SynthScreen::MIXER: {
+            const FaderSpec faders[] = {
+                {15, "S", &mixer_saw_}, {40, "P", &mixer_pulse_},
+                {65, "SB", &mixer_sub_}, {90, "NS", &mixer_noise_}
+            };
+            buildFaderScreen(faders, 4);
+            break;
+        }
+        case SynthScreen::FILTER: {
+            const FaderSpec faders[] = {
+                {15, "CUT", &filter_cutoff_}, {40, "RES", &filter_resonance_},
+                {65, "ENV", &filter_envelope_}, {90, "KBD", &filter_keyboard_}
+            };
+            buildFaderScreen(faders, 4);
+            break;
+        }
+        case SynthScreen::PWM: {
+            const FaderSpec faders[] = {
+                {15, "PW", &pulse_width_}, {40, "LFO", &pwm_lfo_amount_},
+                {65, "RT", &pwm_lfo_rate_}, {90, "ENV", &pwm_env_amount_}
+            };
+            buildFaderScreen(faders, 4);
+            break;
+        }
+        case SynthScreen::MASTER: {
+            // Single master volume fader, centered horizontally
+            const FaderSpec faders[] = { {64 - 18 / 2, "MST", &mixer_master_} };
+            buildFaderScreen(faders, 1);
+            break;
+        }
+        case SynthScreen::WAVEFORM: buildScopeScreen(renderWaveform, "WAVEFORM"); break;
+        case SynthScreen::SPECTRUM: buildScopeScreen(renderSpectrum, "SPECTRUM"); break;
+        case SynthScreen::PERFORMANCE: buildPerformanceScreen(); break;
+        case SynthScreen::PARAM_ONLY: buildParamOnlyScreen(); break;
     }
+    
+    layout_screen_ = current_screen_;
+    layout_valid_ = true;
+    has_pending_update_ = true; // Populate the new widgets right away
 }
 
-void SynthScreenManager::drawADSRScreen() {
-    clearScreen();
-    
-    // Four ADSR faders - same as all other screens
+void SynthScreenManager::buildFaderScreen(const FaderSpec* specs, int count) {
+    // All faders same size - no title
     const int bar_width = 18;
     const int bar_height = 40;
     const int bar_y = 4;
     
-    // Draw faders with centered labels
-    drawFader(15, bar_y, bar_width, bar_height, adsr_attack_, "A");
-    drawFader(40, bar_y, bar_width, bar_height, adsr_decay_, "D");
-    drawFader(65, bar_y, bar_width, bar_height, adsr_sustain_, "S");
-    drawFader(90, bar_y, bar_width, bar_height, adsr_release_, "R");
-    
-    updateDisplay();
+    for (int i = 0; i < count && i < MAX_FADERS; i++) {
+        fader_ids_[i] = canvas_.addFader(specs[i].x, bar_y, bar_width, bar_height, specs[i].label);
+        fader_sources_[i] = specs[i].source;
+        num_faders_++;
+    }
 }
 
-void SynthScreenManager::drawMixerScreen() {
-    clearScreen();
-    
-    // All faders same width - no title
-    const int bar_width = 18;
-    const int bar_height = 40;
-    const int bar_y = 4;
-    
-    // Draw faders with centered labels - now only 4 oscillator levels
-    drawFader(15, bar_y, bar_width, bar_height, mixer_saw_, "S");
-    drawFader(40, bar_y, bar_width, bar_height, mixer_pulse_, "P");
-    drawFader(65, bar_y, bar_width, bar_height, mixer_sub_, "SB");
-    drawFader(90, bar_y, bar_width, bar_height, mixer_noise_, "NS");
-    
-    updateDisplay();
+void SynthScreenManager::buildScopeScreen(ScopeRenderer renderer, const char* title) {
+    // Scope area above a label at the bottom
+    scope_id_ = canvas_.addScope(0, 4, 128, 50, renderer, this);
+    canvas_.addLabel(35, 58, title, 8);
 }
 
-void SynthScreenManager::drawFilterScreen() {
-    clearScreen();
-    
-    // Four faders - same width, no title, no percentages
-    const int bar_width = 18;
-    const int bar_height = 40;
-    const int bar_y = 4;
-    
-    // Draw faders with centered labels
-    drawFader(15, bar_y, bar_width, bar_height, filter_cutoff_, "CUT");
-    drawFader(40, bar_y, bar_width, bar_height, filter_resonance_, "RES");
-    drawFader(65, bar_y, bar_width, bar_height, filter_envelope_, "ENV");
-    drawFader(90, bar_y, bar_width, bar_height, filter_keyboard_, "KBD");
-    
-    updateDisplay();
+void SynthScreenManager::buildParamOnlyScreen() {
+    param_name_id_ = canvas_.addLabel(0, 20, "PICO SYNTH");
+    param_value_id_ = canvas_.addLabel(0, 35, "Ready");
 }
 
-void SynthScreenManager::drawPWMScreen() {
-    clearScreen();
+void SynthScreenManager::buildPerformanceScreen() {
+    // Text rows are page aligned (8px); the font only has letters and digits
+    load_label_id_ = canvas_.addLabel(0, 0, "");
+    load_meter_id_ = canvas_.addMeter(0, 9, 128, 6);   // Current block load
+    peak_meter_id_ = canvas_.addMeter(0, 17, 128, 6);  // Peak block load
+    voices_label_id_ = canvas_.addLabel(0, 32, "");
+    xrun_label_id_ = canvas_.addLabel(0, 40, "");
+    midi_label_id_ = canvas_.addLabel(0, 48, "");
     
-    // Four PWM faders - same width
-    const int bar_width = 18;
-    const int bar_height = 40;
-    const int bar_y = 4;
-    
-    // Draw faders with centered labels
-    drawFader(15, bar_y, bar_width, bar_height, pulse_width_, "PW");
-    drawFader(40, bar_y, bar_width, bar_height, pwm_lfo_amount_, "LFO");
-    drawFader(65, bar_y, bar_width, bar_height, pwm_lfo_rate_, "RT");
-    drawFader(90, bar_y, bar_width, bar_height, pwm_env_amount_, "ENV");
-    
-    updateDisplay();
+    // Peak and MIDI rate restart whenever the page is opened
+    g_engine_telemetry.resetPeak();
+    midi_rate_window_start_ = to_ms_since_boot(get_absolute_time());
+    midi_rate_window_events_ = g_engine_telemetry.read().midi_event_count;
+    midi_events_per_sec_ = 0;
 }
 
-void SynthScreenManager::drawMasterScreen() {
-    clearScreen();
+void SynthScreenManager::refreshPerformanceWidgets() {
+    EngineTelemetrySnapshot t = g_engine_telemetry.read();
+    if (t.block_budget_us == 0) return; // Audio not running yet
     
-    // Single large master volume fader
-    const int bar_width = 18;
-    const int bar_height = 40;
-    const int bar_x = 64 - bar_width/2; // Center horizontally
-    const int bar_y = 4;
+    // Load as fix15 fraction of the block budget (integer divide, once per frame)
+    fix15 load = (fix15)(((uint64_t)t.block_us << 15) / t.block_budget_us);
+    fix15 peak = (fix15)(((uint64_t)t.peak_block_us << 15) / t.block_budget_us);
+    canvas_.setValue(load_meter_id_, load);
+    canvas_.setValue(peak_meter_id_, peak);
     
-    // Draw centered master volume fader
-    drawFader(bar_x, bar_y, bar_width, bar_height, mixer_master_, "MST");
+    // MIDI events per second over a one second window
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    uint32_t elapsed = now - midi_rate_window_start_;
+    if (elapsed >= 1000) {
+        midi_events_per_sec_ = (t.midi_event_count - midi_rate_window_events_) * 1000 / elapsed;
+        midi_rate_window_start_ = now;
+        midi_rate_window_events_ = t.midi_event_count;
+    }
     
-    updateDisplay();
+    // Three digits each, so an overloaded block cannot overflow the label
+    int load_percent = std::clamp(fix152int(load * 100), 0, 999);
+    int peak_percent = std::clamp(fix152int(peak * 100), 0, 999);
+    char text[20];
+    snprintf(text, sizeof(text), "LOAD %d PK %d", load_percent, peak_percent);
+    canvas_.setText(load_label_id_, text);
+    snprintf(text, sizeof(text), "VOICES %d", t.active_voices);
+    canvas_.setText(voices_label_id_, text);
+    snprintf(text, sizeof(text), "XRUNS %lu", (unsigned long)t.xrun_count);
+    canvas_.setText(xrun_label_id_, text);
+    snprintf(text, sizeof(text), "MIDI %lu", (unsigned long)midi_events_per_sec_);
+    canvas_.setText(midi_label_id_, text);
+}
+
+void SynthScreenManager::refreshWidgets() {
+    switch (current_screen_) {
+        case SynthScreen::WAVEFORM:
+            // Redraw the scope only when Core 1 delivered new samples
+            if (waveform_has_new_samples_) {
+                canvas_.invalidate(scope_id_);
+                waveform_has_new_samples_ = false;
+            }
+            break;
+            
+        case SynthScreen::SPECTRUM:
+            if (updateSpectrum()) {
+                canvas_.invalidate(scope_id_);
+            }
+            break;
+            
+        case SynthScreen::PERFORMANCE:
+            refreshPerformanceWidgets();
+            break;
+            
+        case SynthScreen::PARAM_ONLY:
+            if (!pending_param_name_.empty()) {
+                // Simple parameter display
+                char text[20];
+                snprintf(text, sizeof(text), "%.*s", (int)std::min<size_t>(pending_param_name_.size(), 16),
+                         pending_param_name_.data());
+                canvas_.setText(param_name_id_, text);
+                snprintf(text, sizeof(text), "%d%%", (int)(pending_param_value_ * 100));
+                canvas_.setText(param_value_id_, text);
+            }
+            break;
+            
+        default:
+            // Fader screens: unchanged values do not invalidate anything
+            for (int i = 0; i < num_faders_; i++) {
+                canvas_.setValue(fader_ids_[i], *fader_sources_[i]);
+            }
+            break;
+    }
 }
 
-void SynthScreenManager::drawWaveformScreen() {
-    clearScreen();
+bool SynthScreenManager::updateSpectrum() {
+    // Run the FFT only when Core 1 has delivered a fresh block
+    if (!g_audio_capture.isReady()) {
+        g_audio_capture.request();
+        return false;
+    }
     
-    // Draw oscilloscope-style waveform
-    const int scope_x = 0;
-    const int scope_y = 4;
-    const int scope_w = 128;
-    const int scope_h = 50;
-    const int center_y = scope_y + scope_h / 2;
+    fft_.process(g_audio_capture.getSamples());
+    g_audio_capture.release();
+    g_audio_capture.request();
+    
+    // Map log2(power) in Q8 onto bar height: ~4 (noise) .. ~26 (full scale) octaves of power
+    // covers ~66dB over 50 pixels
+    const int floor_q8 = 4 << 8;
+    const int range_q8 = 22 << 8;
+    const int max_h = 50;
+    bool changed = false;
+    for (int bin = 0; bin < Fix15FFT::NUM_BINS; bin++) {
+        int level = (int)fft_.getLog2PowerQ8(bin) - floor_q8;
+        int h = level <= 0 ? 0 : (level * max_h) / range_q8;
+        if (h > max_h) h = max_h;
+        
+        // Fast attack, slow fall for a readable display
+        uint8_t old_h = spectrum_heights_[bin];
+        if (h >= old_h) {
+            spectrum_heights_[bin] = (uint8_t)h;
+        } else {
+            spectrum_heights_[bin] = (uint8_t)(old_h - ((old_h - h + 3) >> 2));
+        }
+        changed |= spectrum_heights_[bin] != old_h;
+    }
+    return changed;
+}
+
+void SynthScreenManager::renderWaveform(void* context, OledDisplay& display, int x, int y, int w, int h) {
+    auto* self = static_cast<SynthScreenManager*>(context);
+    const int center_y = y + h / 2;
     
     // No center line - cleaner waveform display
     
+    // Full-scale sample maps to 2 * h pixels at 1x, times the user scale (fix15)
+    const int gain_px = fix152int(multfix15(int2fix15(h * 2), self->waveform_scale_));
+    
     // Draw waveform samples starting from current write position for most recent data
-    // Use interpolation to make waveform look smoother despite lower sample rate
-    for (int x = 0; x < scope_w - 1; x++) {
+    for (int col = 0; col < w - 1; col++) {
         // Calculate buffer indices for circular buffer
-        int idx1 = (waveform_write_pos_ - scope_w + x + WAVEFORM_BUFFER_SIZE) % WAVEFORM_BUFFER_SIZE;
-        int idx2 = (waveform_write_pos_ - scope_w + x + 1 + WAVEFORM_BUFFER_SIZE) % WAVEFORM_BUFFER_SIZE;
+        int idx1 = (self->waveform_write_pos_ - w + col + WAVEFORM_BUFFER_SIZE) % WAVEFORM_BUFFER_SIZE;
+        int idx2 = (self->waveform_write_pos_ - w + col + 1 + WAVEFORM_BUFFER_SIZE) % WAVEFORM_BUFFER_SIZE;
         
         // Scale samples to display height using adjustable scale factor (oscilloscope-like scaling)
-        int y1 = center_y - (int)(waveform_buffer_[idx1] * scope_h * waveform_scale_ * 2.0f);
-        int y2 = center_y - (int)(waveform_buffer_[idx2] * scope_h * waveform_scale_ * 2.0f);
+        // 16-bit sample * pixel gain (<= 1000) fits in 32 bits, so no 64-bit multiply is needed
+        int y1 = center_y - ((self->waveform_buffer_[idx1] * gain_px) >> 15);
+        int y2 = center_y - ((self->waveform_buffer_[idx2] * gain_px) >> 15);
         
-        // Clamp to screen bounds  
-        y1 = std::max(scope_y, std::min(y1, scope_y + scope_h - 1));
-        y2 = std::max(scope_y, std::min(y2, scope_y + scope_h - 1));
+        // Clamp to scope bounds
+        y1 = std::max(y, std::min(y1, y + h - 1));
+        y2 = std::max(y, std::min(y2, y + h - 1));
         
-        // Draw line segment
-        drawLine(scope_x + x, y1, scope_x + x + 1, y2);
+        // Connect adjacent samples with a single vertical span (byte-wise fill)
+        int top = std::min(y1, y2);
+        display.drawVLine(x + col, top, std::max(y1, y2) - top + 1);
     }
+}
+
+void SynthScreenManager::renderSpectrum(void* context, OledDisplay& display, int x, int y, int w, int h) {
+    auto* self = static_cast<SynthScreenManager*>(context);
     
-    // Add label at bottom
-    drawText("WAVEFORM", 35, 58);
-    
-    updateDisplay();
+    // One bin per 2 pixel column pair, DC on the left, Nyquist on the right
+    const int baseline = y + h - 1;
+    for (int bin = 0; bin < Fix15FFT::NUM_BINS && bin * 2 < w; bin++) {
+        int bar_h = std::min((int)self->spectrum_heights_[bin], h);
+        if (bar_h > 0) {
+            display.drawVLine(x + bin * 2, baseline - bar_h + 1, bar_h);
+        }
+    }
 }
 
-void SynthScreenManager::feedAudioSamples(const float* samples, int num_samples) {
+void SynthScreenManager::feedAudioSamples(const int16_t* samples, int num_samples) {
     // Simply copy samples into circular buffer
     for (int i = 0; i < num_samples; i++) {
         waveform_buffer_[waveform_write_pos_] = samples[i];
@@ -327,93 +458,26 @@ void SynthScreenManager::feedAudioSamples(const float* samples, int num_samples)
             waveform_write_pos_ = 0;
         }
     }
-}
-
-void SynthScreenManager::drawParamOnlyScreen() {
-    clearScreen();
-    
-    if (has_pending_update_ || !pending_param_name_.empty()) {
-        // Simple parameter display
-        std::string name = pending_param_name_.length() > 16 ? pending_param_name_.substr(0, 16) : pending_param_name_;
-        drawText(name, 0, 20);
-        drawText(std::to_string((int)(pending_param_value_ * 100)) + "%", 0, 35);
-    } else {
-        // Show default message when no parameter is active
-        drawText("PICO SYNTH", 0, 20);
-        drawText("Ready", 0, 35);
-    }
     
-    updateDisplay();
+    if (num_samples > 0) {
+        waveform_has_new_samples_ = true;
+    }
 }
 
 void SynthScreenManager::loadParameterValuesFromStore() {
     // Load all parameter values from the global parameter store
-    for (auto* param : g_synth_parameters) {
-        if (param) {
-            storeParameterValue(param->getID(), param->getNormalizedValue());
-        }
+    for (auto& param : g_synth_parameters) {
+        storeParameterValue(param.getID(), param.getNormalizedValue());
     }
 }
 
-// Drawing helpers
-void SynthScreenManager::clearScreen() {
-    display_->clear();
-}
-
-void SynthScreenManager::drawText(const std::string& text, int x, int y) {
-    display_->writeText(text, x, y);
-}
-
-void SynthScreenManager::drawLine(int x0, int y0, int x1, int y1) {
-    display_->drawLine(x0, y0, x1, y1);
-}
-
-void SynthScreenManager::drawRect(int x, int y, int w, int h, bool filled) {
-    for (int i = 0; i < w; i++) {
-        for (int j = 0; j < h; j++) {
-            if (filled || i == 0 || i == w-1 || j == 0 || j == h-1) {
-                display_->setPixel(x + i, y + j);
-            }
-        }
-    }
-}
-
-void SynthScreenManager::drawBar(int x, int y, int w, int h, float level) {
-    // Draw outline
-    drawRect(x, y, w, h, false);
-    
-    // Fill vertically from bottom based on level
-    int fill_h = (int)(level * (h - 2));
-    if (fill_h > 0) {
-        drawRect(x + 1, y + h - 1 - fill_h, w - 2, fill_h, true);
-    }
-}
-
-// Helper to draw a labeled fader with proper alignment
-void SynthScreenManager::drawFader(int x, int y, int w, int h, float level, const std::string& label) {
-    drawBar(x, y, w, h, level);
-    
-    // Center the label under the fader
-    int text_width = label.length() * 6; // Approximate character width
-    int label_x = x + (w - text_width) / 2;
-    int label_y = y + h + 4; // 1 pixel below fader
-    
-    drawText(label, label_x, label_y);
-}
-
-void SynthScreenManager::updateDisplay() {
-    // Try non-blocking display update first, fallback to blocking if DMA unavailable
-    if (!display_->displayAsync()) {
-        display_->display(); // Fallback to blocking
-    }
-}
-
-// Global interface
+// Global interface: the manager is built on the first parameter change, in static storage
 static SynthScreenManager* global_screen_manager = nullptr;
 
-void showSynthParameter(const std::string& name, float value) {
+void showSynthParameter(std::string_view name, float value) {
     if (!global_screen_manager) {
-        global_screen_manager = new SynthScreenManager();
+        static SynthScreenManager manager;
+        global_screen_manager = &manager;
     }
     global_screen_manager->showParameter(name, value);
 }
@@ -436,7 +500,13 @@ void nextSynthScreen() {
     }
 }
 
-void feedSynthWaveform(const float* samples, int num_samples) {
+void setSynthHomeScreen(SynthScreen screen) {
+    if (global_screen_manager) {
+        global_screen_manager->setHomeScreen(screen);
+    }
+}
+
+void feedSynthWaveform(const int16_t* samples, int num_samples) {
     if (global_screen_manager) {
         global_screen_manager->feedAudioSamples(samples, num_samples);
     }
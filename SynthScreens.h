@@ -2,7 +2,9 @@
 
 #include "pico/stdlib.h"
 #include "OledDisplay.h"
-#include <string>
+#include "WidgetCanvas.h"
+#include "Fix15FFT.h"
+#include <string_view>
 
 enum class SynthScreen {
     ADSR,
@@ -11,6 +13,8 @@ enum class SynthScreen {
     PWM,  // Pulse Width Modulation screen with 4 faders
     MASTER,  // Master volume screen
     WAVEFORM,  // Oscilloscope view of current audio
+    SPECTRUM,  // FFT magnitude view of current audio
+    PERFORMANCE,  // DSP load, voice count, xruns and MIDI rate from engine telemetry
     PARAM_ONLY  // Just show parameter name/value
 };
 
@@ -19,16 +23,19 @@ public:
     SynthScreenManager();
     
     // Main interface - shows parameter and switches screens intelligently
-    void showParameter(const std::string& name, float value);
+    void showParameter(std::string_view name, float value);
     void update();
     
-    // Audio data for oscilloscope
-    void feedAudioSamples(const float* samples, int num_samples);
+    // Audio data for oscilloscope (fix15 samples truncated to 16 bits, +/-32768 = full scale)
+    void feedAudioSamples(const int16_t* samples, int num_samples);
     
     // Manual screen switching
     void switchToScreen(SynthScreen screen);
     void nextScreen();
     
+    // Screen shown continuously when no parameter is being edited (WAVEFORM, SPECTRUM or PERFORMANCE)
+    void setHomeScreen(SynthScreen screen);
+    
     // Screen timeout settings
     void setScreenTimeout(uint32_t timeout_ms) { screen_timeout_ms_ = timeout_ms; }
     void setUpdateRate(uint32_t ms) { update_interval_ms_ = ms; }
@@ -36,80 +43,112 @@ public:
 private:
     SynthScreen current_screen_;
     SynthScreen last_auto_screen_;
+    SynthScreen home_screen_;
     uint32_t screen_switch_time_;
     uint32_t screen_timeout_ms_;
     uint32_t last_update_time_;
     uint32_t update_interval_ms_;
     
-    std::string pending_param_name_;
+    std::string_view pending_param_name_;  // Parameter IDs are literals (Parameter.h)
     float pending_param_value_;
     bool has_pending_update_;
     
-    // Parameter values for different screens
-    float adsr_attack_ = 0.1f;
-    float adsr_decay_ = 0.3f;
-    float adsr_sustain_ = 0.7f;
-    float adsr_release_ = 0.5f;
+    // Parameter values for different screens (normalized 0-1 as fix15, converted once per change)
+    fix15 adsr_attack_ = float2fix15(0.1f);
+    fix15 adsr_decay_ = float2fix15(0.3f);
+    fix15 adsr_sustain_ = float2fix15(0.7f);
+    fix15 adsr_release_ = float2fix15(0.5f);
     
-    float mixer_saw_ = 0.8f;
-    float mixer_pulse_ = 0.6f;
-    float mixer_sub_ = 0.4f;
-    float mixer_noise_ = 0.1f;
-    float mixer_master_ = 0.75f;
+    fix15 mixer_saw_ = float2fix15(0.8f);
+    fix15 mixer_pulse_ = float2fix15(0.6f);
+    fix15 mixer_sub_ = float2fix15(0.4f);
+    fix15 mixer_noise_ = float2fix15(0.1f);
+    fix15 mixer_master_ = float2fix15(0.75f);
     
-    float filter_cutoff_ = 0.6f;
-    float filter_resonance_ = 0.3f;
-    float filter_envelope_ = 0.4f;
-    float filter_keyboard_ = 0.3f;
+    fix15 filter_cutoff_ = float2fix15(0.6f);
+    fix15 filter_resonance_ = float2fix15(0.3f);
+    fix15 filter_envelope_ = float2fix15(0.4f);
+    fix15 filter_keyboard_ = float2fix15(0.3f);
     
-    float pulse_width_ = 0.5f;
-    float pwm_lfo_amount_ = 0.1f;
-    float pwm_lfo_rate_ = 0.5f;
-    float pwm_env_amount_ = 0.2f;
+    fix15 pulse_width_ = float2fix15(0.5f);
+    fix15 pwm_lfo_amount_ = float2fix15(0.1f);
+    fix15 pwm_lfo_rate_ = float2fix15(0.5f);
+    fix15 pwm_env_amount_ = float2fix15(0.2f);
     
     // Waveform display buffer for oscilloscope
     static const int WAVEFORM_BUFFER_SIZE = 128;  // 128 pixels wide
-    float waveform_buffer_[WAVEFORM_BUFFER_SIZE];
+    int16_t waveform_buffer_[WAVEFORM_BUFFER_SIZE];
     int waveform_write_pos_ = 0;
-    float waveform_scale_ = 1.0f;  // Scaling factor for waveform display
+    fix15 waveform_scale_ = FIX15_ONE;  // Scaling factor for waveform display (1x to 10x)
+    
+    // Spectrum analyzer (fed by full-rate block capture from Core 1)
+    Fix15FFT fft_;
+    uint8_t spectrum_heights_[Fix15FFT::NUM_BINS] = {};
     
-    OledDisplay* display_;
+    OledDisplay display_;
     
     // Screen detection
-    SynthScreen detectScreenFromParameter(const std::string& name);
-    bool isADSRParam(const std::string& name);
-    bool isMixerParam(const std::string& name);
-    bool isFilterParam(const std::string& name);
-    bool isPWMParam(const std::string& name);
-    bool isMasterParam(const std::string& name);
-    
-    // Screen drawing methods
-    void drawCurrentScreen();
-    void drawADSRScreen();
-    void drawMixerScreen();
-    void drawFilterScreen();
-    void drawPWMScreen();
-    void drawMasterScreen();
-    void drawWaveformScreen();
-    void drawParamOnlyScreen();
-    
-    // Drawing helpers
-    void clearScreen();
-    void drawText(const std::string& text, int x, int y);
-    void drawLine(int x0, int y0, int x1, int y1);
-    void drawRect(int x, int y, int w, int h, bool filled = false);
-    void drawBar(int x, int y, int w, int h, float level);
-    void drawFader(int x, int y, int w, int h, float level, const std::string& label);
-    void updateDisplay();
+    SynthScreen detectScreenFromParameter(std::string_view name);
+    bool isADSRParam(std::string_view name);
+    bool isMixerParam(std::string_view name);
+    bool isFilterParam(std::string_view name);
+    bool isPWMParam(std::string_view name);
+    bool isMasterParam(std::string_view name);
+    
+    // Retained widget layout for the current screen - rebuilt only on screen switches
+    struct FaderSpec {
+        int x;
+        const char* label;
+        const fix15* source;
+    };
+    static const int MAX_FADERS = 4;
+    WidgetCanvas canvas_;
+    SynthScreen layout_screen_;
+    bool layout_valid_ = false;
+    int fader_ids_[MAX_FADERS];
+    const fix15* fader_sources_[MAX_FADERS];
+    int num_faders_ = 0;
+    int scope_id_ = -1;
+    int param_name_id_ = -1;
+    int param_value_id_ = -1;
+    bool waveform_has_new_samples_ = false;
+    
+    // Performance screen widgets and MIDI rate window
+    int load_meter_id_ = -1;
+    int peak_meter_id_ = -1;
+    int load_label_id_ = -1;
+    int voices_label_id_ = -1;
+    int xrun_label_id_ = -1;
+    int midi_label_id_ = -1;
+    uint32_t midi_rate_window_start_ = 0;
+    uint32_t midi_rate_window_events_ = 0;
+    uint32_t midi_events_per_sec_ = 0;
+    
+    // Screen layout
+    void buildCurrentScreen();
+    void buildFaderScreen(const FaderSpec* specs, int count);
+    void buildScopeScreen(ScopeRenderer renderer, const char* title);
+    void buildParamOnlyScreen();
+    void buildPerformanceScreen();
+    
+    // Per-frame value refresh - widgets only redraw when a value actually changed
+    void refreshWidgets();
+    bool updateSpectrum();
+    void refreshPerformanceWidgets();
+    
+    // Scope renderers, called by the canvas only when the scope widget is invalidated
+    static void renderWaveform(void* context, OledDisplay& display, int x, int y, int w, int h);
+    static void renderSpectrum(void* context, OledDisplay& display, int x, int y, int w, int h);
     
     // Store parameter values
-    void storeParameterValue(const std::string& name, float value);
+    void storeParameterValue(std::string_view name, float value);
     void loadParameterValuesFromStore();
 };
 
 // Global interface functions
-void showSynthParameter(const std::string& name, float value);
+void showSynthParameter(std::string_view name, float value);
 void updateSynthScreens();
 void switchSynthScreen(SynthScreen screen);
 void nextSynthScreen();
-void feedSynthWaveform(const float* samples, int num_samples);
\ No newline at end of file
+void setSynthHomeScreen(SynthScreen screen);
+void feedSynthWaveform(const int16_t* samples, int num_samples);
\ No newline at end of file
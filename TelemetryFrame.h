@@ -0,0 +1,123 @@
+/**
+ * TelemetryFrame.h - Binary telemetry frame shared by the firmware and host tools
+ *
+ * One frame is a fixed-layout little-endian record of engine metrics. Counters
+ * are cumulative since boot, so the receiver derives rates from the difference
+ * between two frames and a dropped frame only lowers the time resolution.
+ *
+ * Layout (TelemetryFrame::ENCODED_SIZE bytes):
+ *   magic(1) version(1) sequence(2) timestamp_ms(4) block_count(4)
+ *   block_us(2) peak_block_us(2) block_budget_us(2)
+ *   xrun_count(4) midi_event_count(4) param_change_count(4)
+ *   midi_queue_peak(1) num_modules(1) module_us(2 x MAX_MODULES)
+ *   num_voices(1) voice_states(MAX_VOICES / 2, one nibble per voice)
+ *   crc16(2) over everything before it
+ *
+ * No Pico SDK dependencies, so the host decoder includes this file unchanged.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct TelemetryFrame {
+    static constexpr uint8_t MAGIC = 0xA5;
+    static constexpr uint8_t VERSION = 1;
+    static constexpr int MAX_MODULES = 4;
+    static constexpr int MAX_VOICES = 8;
+    static constexpr size_t ENCODED_SIZE = 35 + 2 * MAX_MODULES + MAX_VOICES / 2;
+
+    uint16_t sequence = 0;
+    uint32_t timestamp_ms = 0;
+    uint32_t block_count = 0;
+    uint16_t block_us = 0;
+    uint16_t peak_block_us = 0;
+    uint16_t block_budget_us = 0;
+    uint32_t xrun_count = 0;
+    uint32_t midi_event_count = 0;
+    uint32_t param_change_count = 0;
+    uint8_t midi_queue_peak = 0;
+    uint8_t num_modules = 0;
+    uint16_t module_us[MAX_MODULES] = {};
+    uint8_t num_voices = 0;
+    uint8_t voice_states[MAX_VOICES] = {};  // Fix15VCAEnvelopeModule::State values
+
+    // Serializes into out (at least ENCODED_SIZE bytes), returns bytes written
+    size_t encode(uint8_t* out) const {
+        uint8_t* p = out;
+        *p++ = MAGIC;
+        *p++ = VERSION;
+        p = put16(p, sequence);
+        p = put32(p, timestamp_ms);
+        p = put32(p, block_count);
+        p = put16(p, block_us);
+        p = put16(p, peak_block_us);
+        p = put16(p, block_budget_us);
+        p = put32(p, xrun_count);
+        p = put32(p, midi_event_count);
+        p = put32(p, param_change_count);
+        *p++ = midi_queue_peak;
+        *p++ = num_modules;
+        for (int i = 0; i < MAX_MODULES; ++i) p = put16(p, module_us[i]);
+        *p++ = num_voices;
+        for (int i = 0; i < MAX_VOICES; i += 2) {
+            *p++ = (uint8_t)((voice_states[i] & 0x0F) | (voice_states[i + 1] << 4));
+        }
+        p = put16(p, crc16(out, (size_t)(p - out)));
+        return (size_t)(p - out);
+    }
+
+    // Parses a frame, returns false on wrong size, magic, version or checksum
+    bool decode(const uint8_t* in, size_t length) {
+        if (length != ENCODED_SIZE || in[0] != MAGIC || in[1] != VERSION) return false;
+        if (crc16(in, ENCODED_SIZE - 2) != get16(in + ENCODED_SIZE - 2)) return false;
+
+        const uint8_t* p = in + 2;
+        sequence = get16(p); p += 2;
+        timestamp_ms = get32(p); p += 4;
+        block_count = get32(p); p += 4;
+        block_us = get16(p); p += 2;
+        peak_block_us = get16(p); p += 2;
+        block_budget_us = get16(p); p += 2;
+        xrun_count = get32(p); p += 4;
+        midi_event_count = get32(p); p += 4;
+        param_change_count = get32(p); p += 4;
+        midi_queue_peak = *p++;
+        num_modules = *p++;
+        for (int i = 0; i < MAX_MODULES; ++i) { module_us[i] = get16(p); p += 2; }
+        num_voices = *p++;
+        for (int i = 0; i < MAX_VOICES; i += 2) {
+            voice_states[i] = *p & 0x0F;
+            voice_states[i + 1] = *p >> 4;
+            p++;
+        }
+        return num_modules <= MAX_MODULES && num_voices <= MAX_VOICES;
+    }
+
+    // CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise - frames are tiny
+    static uint16_t crc16(const uint8_t* data, size_t length) {
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < length; ++i) {
+            crc ^= (uint16_t)(data[i] << 8);
+            for (int b = 0; b < 8; ++b) {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+private:
+    static uint8_t* put16(uint8_t* p, uint16_t v) {
+        p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+        return p + 2;
+    }
+    static uint8_t* put32(uint8_t* p, uint32_t v) {
+        p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+        return p + 4;
+    }
+    static uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    static uint32_t get32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+};
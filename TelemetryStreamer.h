@@ -0,0 +1,91 @@
+/**
+ * TelemetryStreamer.h - Periodic engine telemetry frames over USB serial
+ *
+ * Samples the EngineTelemetry snapshot on Core 0 at a configurable rate and
+ * writes it as a TelemetryFrame. The serial link is shared with the line-based
+ * HTML protocol, so each binary frame is sent hex-encoded on its own line:
+ *
+ *   TLM:<2 * TelemetryFrame::ENCODED_SIZE hex digits>\n
+ *
+ * Other consumers ignore the unknown prefix. Streaming is off until the host
+ * sends "TLM_RATE:<hz>" (0 stops it). Decode with host/TelemetryDecode.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "EngineTelemetry.h"
+#include "ParameterStore.h"
+#include "TelemetryFrame.h"
+
+static_assert(EngineTelemetrySnapshot::MAX_MODULES == TelemetryFrame::MAX_MODULES, "Telemetry module count mismatch");
+static_assert(EngineTelemetrySnapshot::MAX_VOICES == TelemetryFrame::MAX_VOICES, "Telemetry voice count mismatch");
+
+class TelemetryStreamer {
+public:
+    static constexpr uint32_t MAX_RATE_HZ = 50;
+
+    // Frames per second, 0 disables streaming
+    void setRate(uint32_t hz) {
+        rate_hz_ = hz > MAX_RATE_HZ ? MAX_RATE_HZ : hz;
+        interval_ms_ = rate_hz_ ? 1000 / rate_hz_ : 0;
+        last_frame_ms_ = to_ms_since_boot(get_absolute_time());
+    }
+
+    uint32_t getRate() const { return rate_hz_; }
+
+    // Call from the Core 0 main loop; sends at most one frame per call
+    void update() {
+        if (rate_hz_ == 0) return;
+
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+        if (now - last_frame_ms_ < interval_ms_) return;
+        last_frame_ms_ = now;
+
+        EngineTelemetrySnapshot snapshot = g_engine_telemetry.read();
+
+        TelemetryFrame frame;
+        frame.sequence = sequence_++;
+        frame.timestamp_ms = now;
+        frame.block_count = snapshot.block_count;
+        frame.block_us = (uint16_t)snapshot.block_us;
+        frame.peak_block_us = (uint16_t)snapshot.peak_block_us;
+        frame.block_budget_us = (uint16_t)snapshot.block_budget_us;
+        frame.xrun_count = snapshot.xrun_count;
+        frame.midi_event_count = snapshot.midi_event_count;
+        frame.param_change_count = g_parameter_change_count;
+        frame.midi_queue_peak = snapshot.midi_queue_peak;
+        frame.num_modules = snapshot.num_modules;
+        for (int i = 0; i < TelemetryFrame::MAX_MODULES; ++i) frame.module_us[i] = snapshot.module_us[i];
+        frame.num_voices = snapshot.num_voices;
+        for (int i = 0; i < TelemetryFrame::MAX_VOICES; ++i) frame.voice_states[i] = snapshot.voice_states[i];
+
+        uint8_t bytes[TelemetryFrame::ENCODED_SIZE];
+        size_t length = frame.encode(bytes);
+
+        // Hex-encode into one line and write it with a single call
+        static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+        char line[4 + 2 * TelemetryFrame::ENCODED_SIZE + 2];
+        char* out = line;
+        *out++ = 'T'; *out++ = 'L'; *out++ = 'M'; *out++ = ':';
+        for (size_t i = 0; i < length; ++i) {
+            *out++ = HEX_DIGITS[bytes[i] >> 4];
+            *out++ = HEX_DIGITS[bytes[i] & 0x0F];
+        }
+        *out++ = '\n';
+        *out = '\0';
+        fputs(line, stdout);
+        fflush(stdout);
+    }
+
+private:
+    uint32_t rate_hz_ = 0;
+    uint32_t interval_ms_ = 0;
+    uint32_t last_frame_ms_ = 0;
+    uint16_t sequence_ = 0;
+};
+
+// Single streamer driven from the Core 0 main loop
+inline TelemetryStreamer g_telemetry_streamer;
@@ -0,0 +1,36 @@
+/**
+ * TraceEvent.h - Event types recorded in the trace rings
+ *
+ * Shared by the firmware (TraceRing.h) and host/TraceToChrome, so it has no
+ * Pico SDK dependencies. The numeric values are part of the TRACE_DUMP format.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Payload layout (24 bits) in the comment
+enum class TraceEvent : uint8_t {
+    BLOCK_START = 1,    // Buffer index being filled
+    BLOCK_END = 2,      // Render time in us
+    MIDI_RECEIVE = 3,   // status << 16 | data1 << 8 | data2 (Core 0)
+    MIDI_APPLY = 4,     // command << 16 | data1 << 8 | data2 (Core 1)
+    VOICE_ALLOCATE = 5, // voice << 8 | note
+    VOICE_STEAL = 6,    // voice << 8 | note
+    DMA_IRQ = 7,        // Buffer index handed to the DMA
+    PARAM_SNAPSHOT = 8  // Parameter change count seen by the snapshot (low 24 bits)
+};
+
+inline const char* traceEventName(uint8_t event) {
+    switch ((TraceEvent)event) {
+        case TraceEvent::BLOCK_START: return "BlockStart";
+        case TraceEvent::BLOCK_END: return "BlockEnd";
+        case TraceEvent::MIDI_RECEIVE: return "MidiReceive";
+        case TraceEvent::MIDI_APPLY: return "MidiApply";
+        case TraceEvent::VOICE_ALLOCATE: return "VoiceAllocate";
+        case TraceEvent::VOICE_STEAL: return "VoiceSteal";
+        case TraceEvent::DMA_IRQ: return "DmaIrq";
+        case TraceEvent::PARAM_SNAPSHOT: return "ParamSnapshot";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,84 @@
+/**
+ * TraceRing.h - Per-core hot-path event trace for post-mortem glitch analysis
+ *
+ * Each core owns a fixed ring of 8-byte records: a 32-bit microsecond timestamp
+ * and one word holding the event type (top 8 bits) and a 24-bit payload.
+ * Recording is a timer read, an index increment and two stores, so it can stay
+ * enabled in the audio path. The ring silently overwrites its oldest entries.
+ *
+ * Dumping ("TRACE_DUMP" on the serial link) pauses recording, prints both rings
+ * oldest-first as "TRC:<core>:<timestamp hex>:<word hex>" lines between
+ * TRACE_BEGIN and TRACE_END, then resumes. host/TraceToChrome turns a capture
+ * of that output into Chrome trace JSON (chrome://tracing, Perfetto).
+ *
+ * Core 1 records from both its audio loop and the DMA IRQ; if the IRQ lands
+ * between the index load and store of the loop, one of the two events is lost.
+ * That is acceptable for a diagnostic trace and keeps the fast path lock-free.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "pico/multicore.h" // For get_core_num() and memory barriers
+#include "TraceEvent.h"
+
+struct TraceRecord {
+    uint32_t timestamp;
+    uint32_t word;      // event << 24 | payload
+};
+
+class TraceRing {
+public:
+    static constexpr uint32_t SIZE = 256;   // Power of two
+    static constexpr uint32_t MASK = SIZE - 1;
+
+    inline void record(TraceEvent event, uint32_t payload) {
+        if (paused) return;
+        uint32_t index = head++ & MASK;
+        records[index].timestamp = time_us_32();
+        records[index].word = ((uint32_t)event << 24) | (payload & 0xFFFFFF);
+    }
+
+    // Called from Core 0 while the rings are paused
+    void dump(unsigned core) const {
+        uint32_t end = head;
+        uint32_t count = end < SIZE ? end : SIZE;
+        for (uint32_t i = end - count; i != end; ++i) {
+            const TraceRecord& r = records[i & MASK];
+            printf("TRC:%u:%08lX:%08lX\n", core, (unsigned long)r.timestamp, (unsigned long)r.word);
+        }
+    }
+
+    volatile bool paused = false;
+
+private:
+    TraceRecord records[SIZE] = {};
+    volatile uint32_t head = 0;
+};
+
+// One ring per core, indexed by get_core_num()
+inline TraceRing g_trace_rings[2];
+
+// Records an event on the calling core's ring
+inline void traceEvent(TraceEvent event, uint32_t payload = 0) {
+    g_trace_rings[get_core_num()].record(event, payload);
+}
+
+// Prints both rings over serial (Core 0, on demand)
+inline void dumpTraceRings() {
+    for (auto& ring : g_trace_rings) ring.paused = true;
+    __dmb();
+    sleep_us(50); // Let an in-flight record() on Core 1 finish
+
+    printf("TRACE_BEGIN\n");
+    for (unsigned core = 0; core < 2; ++core) {
+        g_trace_rings[core].dump(core);
+    }
+    printf("TRACE_END\n");
+    fflush(stdout);
+
+    __dmb();
+    for (auto& ring : g_trace_rings) ring.paused = false;
+}
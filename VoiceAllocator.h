@@ -0,0 +1,319 @@
+/**
+ * VoiceAllocator.h - Age-ordered polyphonic voice allocation
+ *
+ * Every voice sits on exactly one of three intrusive lists:
+ * - FREE:      envelope idle, ready for a new note
+ * - HELD:      key down, ordered by note-on time (head = oldest)
+ * - RELEASING: key up, envelope still sounding, ordered by note-off time
+ *
+ * Notes are keyed by group (the synth's multitimbral part) and MIDI note:
+ * key(group, note). A key -> voice map and a held-key bitmap make note-on (with
+ * a free voice), note-off and same-note retrigger constant time. Stealing is
+ * constant time for the OLDEST policy (releasing voices first, then the oldest
+ * held); QUIETEST scans the candidates once with a caller-supplied level
+ * function, which must not advance the envelopes
+ * (Fix15VCAEnvelopeModule::getCurrentLevel). Lowest/highest protection compares
+ * notes within a group. A group at its voice limit steals from itself only.
+ *
+ * The allocator only does bookkeeping: the synth starts and releases the
+ * envelopes it is told about and reports voices whose release has finished via
+ * voiceFinished(). No Pico SDK dependencies, so it also builds on the host.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "MemoryPlacement.h"
+
+class VoiceAllocator {
+public:
+    static constexpr int MAX_VOICES = 32;
+    static constexpr int MAX_GROUPS = 4;
+    static constexpr int NUM_KEYS = 128 * MAX_GROUPS;
+    static constexpr int8_t NONE = -1;
+
+    static constexpr uint16_t key(uint8_t group, uint8_t note) { return (uint16_t)((group << 7) | (note & 0x7F)); }
+
+    enum class StealMode : uint8_t { OLDEST, QUIETEST };
+
+    struct Policy {
+        StealMode steal = StealMode::OLDEST;
+        bool retrigger_same_note = true;    // Reuse the voice already playing the note
+        bool protect_lowest = false;        // Never steal the lowest held note (bass line)
+        bool protect_highest = false;       // Never steal the highest held note (melody)
+
+        // Packed into one byte so Core 0 can hand it to Core 1 with a single store
+        uint8_t pack() const {
+            return (uint8_t)((uint8_t)steal | (retrigger_same_note ? 0x02 : 0) |
+                             (protect_lowest ? 0x04 : 0) | (protect_highest ? 0x08 : 0));
+        }
+        static Policy unpack(uint8_t bits) {
+            Policy policy;
+            policy.steal = (bits & 0x01) ? StealMode::QUIETEST : StealMode::OLDEST;
+            policy.retrigger_same_note = (bits & 0x02) != 0;
+            policy.protect_lowest = (bits & 0x04) != 0;
+            policy.protect_highest = (bits & 0x08) != 0;
+            return policy;
+        }
+    };
+
+    struct Allocation {
+        int8_t voice = NONE;        // Voice that plays the new note
+        int8_t released = NONE;     // Older voice on the same note to release (retrigger off)
+        bool stolen = false;        // The voice was still sounding another note
+        bool retriggered = false;   // The voice was already playing this note
+    };
+
+    explicit VoiceAllocator(int num_voices = 0) { reset(num_voices); }
+
+    // All voices free, in index order
+    void reset(int num_voices) {
+        if (num_voices > MAX_VOICES) num_voices = MAX_VOICES;
+        if (num_voices < 0) num_voices = 0;
+        voice_count = (uint8_t)num_voices;
+        for (auto& list : lists) list = List{};
+        for (auto& v : key_voice) v = NONE;
+        for (auto& word : held_keys) word = 0;
+        for (auto& count : group_voices) count = 0;
+        for (int i = 0; i < voice_count; ++i) {
+            nodes[i].key = 0;
+            append(i, ListId::FREE);
+        }
+    }
+
+    void setPolicy(const Policy& new_policy) { policy = new_policy; }
+    const Policy& getPolicy() const { return policy; }
+
+    // level(voice) returns the voice's current envelope level (only used by QUIETEST).
+    // group_limit caps the voices (held or releasing) of the key's group, 0 = no cap.
+    // A free preferred voice is taken before the head of the free list.
+    template <typename LevelFn>
+    Allocation AUDIO_RAM_FUNC(noteOn)(uint16_t key, LevelFn&& level, uint8_t group_limit = 0, int8_t preferred = NONE) {
+        key %= NUM_KEYS;
+        Allocation allocation;
+        if (voice_count == 0) return allocation;
+
+        int8_t current = key_voice[key];
+        if (current != NONE && policy.retrigger_same_note) {
+            moveTo(current, ListId::HELD);
+            setHeld(key, true);
+            allocation.voice = current;
+            allocation.retriggered = true;
+            return allocation;
+        }
+        if (current != NONE && nodes[current].list == ListId::HELD) {
+            // Stacking the same note: the older voice lets go
+            moveTo(current, ListId::RELEASING);
+            setHeld(key, false);
+            allocation.released = current;
+        }
+
+        int group = key >> 7;
+        int8_t voice = NONE;
+        if (group_limit == 0 || group_voices[group] < group_limit) {
+            bool preferred_free = preferred >= 0 && preferred < voice_count && nodes[preferred].list == ListId::FREE;
+            voice = preferred_free ? preferred : lists[(int)ListId::FREE].head;
+        }
+        if (voice == NONE) {
+            voice = (group_limit != 0 && group_voices[group] >= group_limit) ? chooseVictim(level, group) : NONE;
+            if (voice == NONE) voice = chooseVictim(level, -1);
+            detachNote(voice);
+            allocation.stolen = true;
+        }
+
+        nodes[voice].key = key;
+        moveTo(voice, ListId::HELD);
+        group_voices[group]++;
+        key_voice[key] = voice;
+        setHeld(key, true);
+        allocation.voice = voice;
+        return allocation;
+    }
+
+    // Returns the voice to release, or NONE if the key is not held
+    int8_t AUDIO_RAM_FUNC(noteOff)(uint16_t key) {
+        key %= NUM_KEYS;
+        int8_t voice = key_voice[key];
+        if (voice == NONE || nodes[voice].list != ListId::HELD) return NONE;
+        moveTo(voice, ListId::RELEASING);
+        setHeld(key, false);
+        return voice;
+    }
+
+    // Releases every held voice, oldest first, calling release(voice) for each
+    template <typename ReleaseFn>
+    void releaseAll(ReleaseFn&& release) {
+        while (lists[(int)ListId::HELD].head != NONE) {
+            int8_t voice = lists[(int)ListId::HELD].head;
+            moveTo(voice, ListId::RELEASING);
+            setHeld(nodes[voice].key, false);
+            release(voice);
+        }
+    }
+
+    // Releases the held voices of one group, oldest first
+    template <typename ReleaseFn>
+    void releaseGroup(int group, ReleaseFn&& release) {
+        int8_t voice = lists[(int)ListId::HELD].head;
+        while (voice != NONE) {
+            int8_t next = nodes[voice].next;
+            if ((nodes[voice].key >> 7) == group) {
+                moveTo(voice, ListId::RELEASING);
+                setHeld(nodes[voice].key, false);
+                release(voice);
+            }
+            voice = next;
+        }
+    }
+
+    // The voice's envelope went idle: it becomes free again
+    void voiceFinished(int voice) {
+        if (voice < 0 || voice >= voice_count || nodes[voice].list == ListId::FREE) return;
+        detachNote((int8_t)voice);
+        moveTo((int8_t)voice, ListId::FREE);
+    }
+
+    bool isReleasing(int voice) const { return nodes[voice].list == ListId::RELEASING; }
+    bool isHeld(int voice) const { return nodes[voice].list == ListId::HELD; }
+    uint16_t getKey(int voice) const { return nodes[voice].key; }
+    uint8_t getNote(int voice) const { return nodes[voice].key & 0x7F; }
+    int getNumVoices() const { return voice_count; }
+    int getNumHeld() const { return lists[(int)ListId::HELD].count; }
+    int getNumReleasing() const { return lists[(int)ListId::RELEASING].count; }
+    int getNumFree() const { return lists[(int)ListId::FREE].count; }
+    int getGroupVoices(int group) const { return group_voices[group]; }
+
+    // Lowest/highest held note of a group, or -1 when it holds nothing
+    int lowestHeldNote(int group = 0) const {
+        for (int w = group * 4; w < group * 4 + 4; ++w) {
+            if (held_keys[w]) return (w & 3) * 32 + __builtin_ctz(held_keys[w]);
+        }
+        return -1;
+    }
+    int highestHeldNote(int group = 0) const {
+        for (int w = group * 4 + 3; w >= group * 4; --w) {
+            if (held_keys[w]) return (w & 3) * 32 + 31 - __builtin_clz(held_keys[w]);
+        }
+        return -1;
+    }
+
+private:
+    enum class ListId : uint8_t { FREE, HELD, RELEASING };
+
+    struct Node {
+        int8_t prev = NONE;
+        int8_t next = NONE;
+        uint16_t key = 0;
+        ListId list = ListId::FREE;
+    };
+
+    struct List {
+        int8_t head = NONE;
+        int8_t tail = NONE;
+        uint8_t count = 0;
+    };
+
+    void append(int8_t voice, ListId id) {
+        List& list = lists[(int)id];
+        Node& node = nodes[voice];
+        node.list = id;
+        node.prev = list.tail;
+        node.next = NONE;
+        if (list.tail != NONE) nodes[list.tail].next = voice;
+        else list.head = voice;
+        list.tail = voice;
+        list.count++;
+    }
+
+    void unlink(int8_t voice) {
+        List& list = lists[(int)nodes[voice].list];
+        Node& node = nodes[voice];
+        if (node.prev != NONE) nodes[node.prev].next = node.next;
+        else list.head = node.next;
+        if (node.next != NONE) nodes[node.next].prev = node.prev;
+        else list.tail = node.prev;
+        node.prev = node.next = NONE;
+        list.count--;
+    }
+
+    // Moves to the tail (newest end) of a list, also when already on it
+    void moveTo(int8_t voice, ListId id) {
+        unlink(voice);
+        append(voice, id);
+    }
+
+    void setHeld(uint16_t key, bool held) {
+        uint32_t bit = 1u << (key & 31);
+        if (held) held_keys[key >> 5] |= bit;
+        else held_keys[key >> 5] &= ~bit;
+    }
+
+    // Forgets the voice's current key before it is reused
+    void detachNote(int8_t voice) {
+        uint16_t key = nodes[voice].key;
+        if (nodes[voice].list == ListId::HELD) setHeld(key, false);
+        if (nodes[voice].list != ListId::FREE) group_voices[key >> 7]--;
+        if (key_voice[key] == voice) key_voice[key] = NONE;
+    }
+
+    // Protection compares notes within the voice's own group
+    bool isProtected(int8_t voice) const {
+        if (!policy.protect_lowest && !policy.protect_highest) return false;
+        int group = nodes[voice].key >> 7;
+        int note = nodes[voice].key & 0x7F;
+        return (policy.protect_lowest && note == lowestHeldNote(group)) ||
+               (policy.protect_highest && note == highestHeldNote(group));
+    }
+
+    bool inGroup(int8_t voice, int group) const { return group < 0 || (nodes[voice].key >> 7) == group; }
+
+    // Picks a sounding voice to steal (from one group, or any with group -1): releasing voices first,
+    // then unprotected held voices. Returns NONE only when the group has no sounding voice.
+    template <typename LevelFn>
+    int8_t AUDIO_RAM_FUNC(chooseVictim)(LevelFn& level, int group) {
+        const List& releasing = lists[(int)ListId::RELEASING];
+        const List& held = lists[(int)ListId::HELD];
+        int8_t oldest_held = NONE;
+        for (int8_t v = held.head; v != NONE && oldest_held == NONE; v = nodes[v].next) {
+            if (inGroup(v, group)) oldest_held = v;
+        }
+
+        if (policy.steal == StealMode::OLDEST) {
+            for (int8_t v = releasing.head; v != NONE; v = nodes[v].next) {
+                if (inGroup(v, group)) return v;
+            }
+            for (int8_t v = held.head; v != NONE; v = nodes[v].next) {
+                if (inGroup(v, group) && !isProtected(v)) return v;    // At most two protected voices per group
+            }
+            return oldest_held;
+        }
+
+        // QUIETEST: ties go to the older voice
+        int8_t best = NONE;
+        int32_t best_level = INT32_MAX;
+        for (int8_t v = releasing.head; v != NONE; v = nodes[v].next) {
+            if (!inGroup(v, group)) continue;
+            int32_t l = level(v);
+            if (l < best_level) { best = v; best_level = l; }
+        }
+        if (best != NONE) return best;
+
+        for (int8_t v = held.head; v != NONE; v = nodes[v].next) {
+            if (!inGroup(v, group) || isProtected(v)) continue;
+            int32_t l = level(v);
+            if (l < best_level) { best = v; best_level = l; }
+        }
+        return best != NONE ? best : oldest_held;
+    }
+
+    Policy policy;
+    uint8_t voice_count = 0;
+    Node nodes[MAX_VOICES];
+    List lists[3];
+    int8_t key_voice[NUM_KEYS];             // Newest voice holding or releasing each key
+    uint32_t held_keys[NUM_KEYS / 32];      // Bitmap of held keys for lowest/highest protection
+    uint8_t group_voices[MAX_GROUPS];       // Held or releasing voices per group
+};
+
+// Allocation policy requested from Core 0 ("VOICE_POLICY:" command), applied by Core 1 once per block
+inline volatile uint8_t g_voice_policy = VoiceAllocator::Policy{}.pack();
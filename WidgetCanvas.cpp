@@ -0,0 +1,186 @@
+#include "WidgetCanvas.h"
+#include <algorithm>
+#include <cstring>
+
+void DirtyRect::add(int x, int y, int w, int h) {
+    int ax0 = std::max(x, 0);
+    int ay0 = std::max(y, 0);
+    int ax1 = std::min(x + w - 1, OledDisplay::SCREEN_WIDTH - 1);
+    int ay1 = std::min(y + h - 1, OledDisplay::SCREEN_HEIGHT - 1);
+    if (ax1 < ax0 || ay1 < ay0) return;
+
+    if (isEmpty()) {
+        x0 = ax0; y0 = ay0; x1 = ax1; y1 = ay1;
+    } else {
+        x0 = std::min(x0, ax0);
+        y0 = std::min(y0, ay0);
+        x1 = std::max(x1, ax1);
+        y1 = std::max(y1, ay1);
+    }
+}
+
+void WidgetCanvas::clear() {
+    num_widgets_ = 0;
+    full_clear_ = true;
+}
+
+int WidgetCanvas::addWidget(WidgetType type, int x, int y, int w, int h) {
+    if (num_widgets_ >= MAX_WIDGETS) return -1;
+
+    Widget& widget = widgets_[num_widgets_];
+    widget.type = type;
+    widget.x = x; widget.y = y; widget.w = w; widget.h = h;
+    widget.bx = x; widget.by = y; widget.bw = w; widget.bh = h;
+    widget.value = FIX15_ZERO;
+    widget.text[0] = '\0';
+    widget.renderer = nullptr;
+    widget.context = nullptr;
+    widget.dirty = true;
+    return num_widgets_++;
+}
+
+int WidgetCanvas::addFader(int x, int y, int w, int h, const char* label) {
+    int id = addWidget(WidgetType::FADER, x, y, w, h);
+    if (id < 0) return id;
+
+    Widget& widget = widgets_[id];
+    strncpy(widget.text, label, MAX_TEXT);
+    widget.text[MAX_TEXT] = '\0';
+
+    // Grow the bounding box to cover the label row (font is 8px per glyph, page aligned)
+    int text_width = (int)strlen(widget.text) * 8;
+    int label_x = x + (w - (int)strlen(widget.text) * 6) / 2;
+    int label_page_y = ((y + h + 4) / 8) * 8;
+    int left = std::min(x, label_x);
+    int right = std::max(x + w, label_x + text_width);
+    widget.bx = left;
+    widget.bw = right - left;
+    widget.bh = label_page_y + 8 - y;
+    return id;
+}
+
+int WidgetCanvas::addMeter(int x, int y, int w, int h) {
+    return addWidget(WidgetType::METER, x, y, w, h);
+}
+
+int WidgetCanvas::addLabel(int x, int y, const char* text, int max_chars) {
+    // Text rows are page aligned in the framebuffer, so the box is too
+    int page_y = (y / 8) * 8;
+    int id = addWidget(WidgetType::LABEL, x, page_y, max_chars * 8, 8);
+    if (id < 0) return id;
+
+    Widget& widget = widgets_[id];
+    widget.y = y;
+    strncpy(widget.text, text, MAX_TEXT);
+    widget.text[MAX_TEXT] = '\0';
+    return id;
+}
+
+int WidgetCanvas::addScope(int x, int y, int w, int h, ScopeRenderer renderer, void* context) {
+    int id = addWidget(WidgetType::SCOPE, x, y, w, h);
+    if (id < 0) return id;
+
+    widgets_[id].renderer = renderer;
+    widgets_[id].context = context;
+    return id;
+}
+
+void WidgetCanvas::setValue(int id, fix15 value) {
+    if (id < 0 || id >= num_widgets_) return;
+    Widget& widget = widgets_[id];
+    if (widget.value != value) {
+        widget.value = value;
+        widget.dirty = true;
+    }
+}
+
+void WidgetCanvas::setText(int id, const char* text) {
+    if (id < 0 || id >= num_widgets_) return;
+    Widget& widget = widgets_[id];
+    if (strncmp(widget.text, text, MAX_TEXT) != 0) {
+        strncpy(widget.text, text, MAX_TEXT);
+        widget.text[MAX_TEXT] = '\0';
+        widget.dirty = true;
+    }
+}
+
+void WidgetCanvas::invalidate(int id) {
+    if (id < 0 || id >= num_widgets_) return;
+    widgets_[id].dirty = true;
+}
+
+void WidgetCanvas::render(OledDisplay& display) {
+    if (full_clear_) {
+        display.clear();
+        pending_.add(0, 0, OledDisplay::SCREEN_WIDTH, OledDisplay::SCREEN_HEIGHT);
+        for (int i = 0; i < num_widgets_; i++) {
+            widgets_[i].dirty = true;
+        }
+        full_clear_ = false;
+    }
+
+    for (int i = 0; i < num_widgets_; i++) {
+        Widget& widget = widgets_[i];
+        if (!widget.dirty) continue;
+
+        display.fillRect(widget.bx, widget.by, widget.bw, widget.bh, false);
+        drawWidget(display, widget);
+        pending_.add(widget.bx, widget.by, widget.bw, widget.bh);
+        widget.dirty = false;
+    }
+}
+
+void WidgetCanvas::flush(OledDisplay& display) {
+    if (pending_.isEmpty()) return;
+
+    // The panel is addressed in 8-pixel pages vertically
+    if (display.displayRegionAsync(pending_.x0, pending_.x1, pending_.y0 / 8, pending_.y1 / 8)) {
+        pending_.reset();
+    }
+}
+
+void WidgetCanvas::drawWidget(OledDisplay& display, const Widget& widget) {
+    switch (widget.type) {
+        case WidgetType::FADER: {
+            // Outline, then fill from the bottom (fix15 0-1 times small int fits in 32 bits)
+            display.drawHLine(widget.x, widget.y, widget.w);
+            display.drawHLine(widget.x, widget.y + widget.h - 1, widget.w);
+            display.drawVLine(widget.x, widget.y, widget.h);
+            display.drawVLine(widget.x + widget.w - 1, widget.y, widget.h);
+
+            int fill_h = (clampfix15(widget.value, FIX15_ZERO, FIX15_ONE) * (widget.h - 2)) >> 15;
+            if (fill_h > 0) {
+                display.fillRect(widget.x + 1, widget.y + widget.h - 1 - fill_h, widget.w - 2, fill_h);
+            }
+
+            // Center the label under the fader
+            int text_width = (int)strlen(widget.text) * 6; // Approximate character width
+            int label_x = widget.x + (widget.w - text_width) / 2;
+            display.writeText(widget.text, label_x, widget.y + widget.h + 4);
+            break;
+        }
+
+        case WidgetType::METER: {
+            display.drawHLine(widget.x, widget.y, widget.w);
+            display.drawHLine(widget.x, widget.y + widget.h - 1, widget.w);
+            display.drawVLine(widget.x, widget.y, widget.h);
+            display.drawVLine(widget.x + widget.w - 1, widget.y, widget.h);
+
+            int fill_w = (clampfix15(widget.value, FIX15_ZERO, FIX15_ONE) * (widget.w - 2)) >> 15;
+            if (fill_w > 0) {
+                display.fillRect(widget.x + 1, widget.y + 1, fill_w, widget.h - 2);
+            }
+            break;
+        }
+
+        case WidgetType::LABEL:
+            display.writeText(widget.text, widget.x, widget.y);
+            break;
+
+        case WidgetType::SCOPE:
+            if (widget.renderer) {
+                widget.renderer(widget.context, display, widget.x, widget.y, widget.w, widget.h);
+            }
+            break;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "OledDisplay.h"
+#include "Fix15.h"
+#include <cstdint>
+
+// Pixel rectangle accumulated from redrawn widgets (inclusive bounds, empty when x1 < x0)
+struct DirtyRect {
+    int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+
+    bool isEmpty() const { return x1 < x0; }
+    void reset() { x0 = y0 = 0; x1 = y1 = -1; }
+    void add(int x, int y, int w, int h);
+};
+
+enum class WidgetType : uint8_t {
+    FADER,  // Vertical bar with a centered label underneath
+    LABEL,  // Single line of text
+    SCOPE,  // Custom area drawn by a callback (waveform, spectrum)
+    METER   // Horizontal level bar
+};
+
+// Draws scope contents into the framebuffer inside the given area
+using ScopeRenderer = void (*)(void* context, OledDisplay& display, int x, int y, int w, int h);
+
+struct Widget {
+    WidgetType type;
+    int16_t x, y, w, h;         // Content area
+    int16_t bx, by, bw, bh;     // Bounding box cleared before each redraw
+    fix15 value;                // Fader/meter level (0-1)
+    char text[17];              // Label text or fader caption
+    ScopeRenderer renderer;
+    void* context;
+    bool dirty;
+};
+
+/**
+ * WidgetCanvas - Retained-mode widget list for the OLED
+ *
+ * Screens register their widgets once, then only push new values. A widget is
+ * redrawn only when its value or text actually changed (or it was invalidated),
+ * and only the union of redrawn bounding boxes is sent to the panel. When nothing
+ * changed, a UI frame costs a handful of flag checks.
+ */
+class WidgetCanvas {
+public:
+    static constexpr int MAX_WIDGETS = 12;
+    static constexpr int MAX_TEXT = 16;
+
+    // Removes all widgets and schedules a full-screen clear on the next render
+    void clear();
+
+    // Widget creation - returns an id, or -1 if the canvas is full
+    int addFader(int x, int y, int w, int h, const char* label);
+    int addMeter(int x, int y, int w, int h);
+    int addLabel(int x, int y, const char* text, int max_chars = MAX_TEXT);
+    int addScope(int x, int y, int w, int h, ScopeRenderer renderer, void* context);
+
+    // Updates only invalidate when the value differs from what is on screen
+    void setValue(int id, fix15 value);
+    void setText(int id, const char* text);
+    void invalidate(int id);
+
+    // Redraws invalidated widgets into the framebuffer and grows the pending region
+    void render(OledDisplay& display);
+
+    // Sends the pending region to the panel; keeps it pending while the bus is busy
+    void flush(OledDisplay& display);
+
+    bool hasPendingTransfer() const { return !pending_.isEmpty(); }
+
+private:
+    int addWidget(WidgetType type, int x, int y, int w, int h);
+    void drawWidget(OledDisplay& display, const Widget& widget);
+
+    Widget widgets_[MAX_WIDGETS];
+    int num_widgets_ = 0;
+    bool full_clear_ = true;
+    DirtyRect pending_;
+};
@@ -0,0 +1,174 @@
+//==============================================================================
+// PicoSynthBench: on-target benchmark firmware
+//
+// Runs the DspBench.h kernel benchmarks and full-engine renders of the
+// BenchScenarios.h workloads with the CPU cycle counter, then prints a
+// machine-readable report over USB serial. Needs no DAC or OLED; everything
+// runs on Core 0 with the same clock setup as the synth firmware.
+//
+// Report:
+//   BENCH_BEGIN
+//   BENCH_INFO:<chip>,<sys clock kHz>,<git revision>
+//   BENCH:<kernel>,cycles,<min per sample>,<mean per sample>
+//   BENCH_RENDER:<scenario>,cycles,<blocks>,<min per block>,<mean per block>,<max per block>,<budget per block>
+//   BENCH_END
+//
+// The report repeats whenever a character is received.
+//==============================================================================
+
+#include "hardware/vreg.h"
+#include "hardware/clocks.h"
+#include "pico/stdlib.h"
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <string>
+
+#include "AudioEngine.h"
+#include "GainModule.h"
+#include "ParameterStore.h"
+#include "Sh101StyleSynth.h"
+#include "DrumModule.h"
+#include "BenchScenarios.h"
+#include "CycleCounter.h"
+#include "DspBench.h"
+
+#ifndef PICO_SYNTH_GIT_REV
+#define PICO_SYNTH_GIT_REV "unknown"
+#endif
+
+// Parameter.h reports edits to the OLED; the bench has no display
+void showSynthParameter(std::string_view, float) {}
+
+using namespace bench_scenarios;
+
+static constexpr int NUM_CHANNELS = 2;
+
+// Notes go straight to the synth (there is no second core feeding the FIFO), CCs to the parameters
+// (per-part ones on the parts listening on the channel)
+static void applyEvent(Sh101StyleSynth& synth, const ScriptEvent& event) {
+  uint8_t command = event.status & 0xF0;
+  uint8_t channel = event.status & 0x0F;
+  if (command == 0x90 || command == 0x80 || command == 0xE0 || (command == 0xB0 && event.data1 == 123)) {
+    synth.handleMidiPacket((uint32_t)(command << 24) | (event.data1 << 16) | (event.data2 << 8) | (channel << 4));
+    return;
+  }
+  if (command == 0xB0) {
+    for (auto& p : g_synth_parameters) {
+      if (p.getCcNumber() != event.data1) continue;
+      if (!p.isPartParameter()) p.setNormalizedValue(event.data2 / 127.0f);
+      for (int part = 0; part < MAX_PARTS && p.isPartParameter(); ++part) {
+        if (g_part_config[part].listensTo(channel)) p.setNormalizedValue(event.data2 / 127.0f, part);
+      }
+      break;
+    }
+  }
+}
+
+// The module chain of main_core1()
+struct RenderChain {
+  AudioEngine engine;
+  Sh101StyleSynth synth;
+  DrumModule drums;
+  GainModule master_gain;
+
+  RenderChain()
+      : engine(NUM_CHANNELS, BLOCK_SIZE), synth((float)SAMPLE_RATE), drums((float)SAMPLE_RATE),
+        master_gain((float)SAMPLE_RATE) {
+    synth.setDrumModule(&drums);
+    engine.addModule(&synth);
+    engine.addModule(&drums);
+    engine.addModule(&master_gain);
+  }
+};
+
+// The synth alone is several KB, more than Core 0's stack, so every scenario
+// builds a fresh chain in this one static slot instead
+alignas(RenderChain) static uint8_t render_chain_slot[sizeof(RenderChain)];
+
+// Renders one scenario through the same module chain as main_core1(), timing each block
+static void benchScenario(const Scenario &scenario) {
+  initialize_parameters();
+  g_sequencer_running = false; // Only a scenario's setup() starts the sequencer
+  if (scenario.setup) scenario.setup();
+
+  RenderChain *chain = new (render_chain_slot) RenderChain();
+  AudioEngine &engine = chain->engine;
+  Sh101StyleSynth &synth = chain->synth;
+
+  static fix15 buffer[BLOCK_SIZE * NUM_CHANNELS];
+  auto view = choc::buffer::createInterleavedView<fix15>(buffer, NUM_CHANNELS, BLOCK_SIZE);
+
+  uint32_t num_blocks = (scenario.length_frames + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  uint32_t min_ticks = UINT32_MAX, max_ticks = 0;
+  uint64_t total_ticks = 0;
+  size_t next_event = 0;
+
+  for (uint32_t block = 0; block < num_blocks; ++block) {
+    uint32_t block_end = (block + 1) * BLOCK_SIZE;
+    while (next_event < scenario.events.size() && scenario.events[next_event].frame < block_end) {
+      applyEvent(synth, scenario.events[next_event++]);
+    }
+
+    uint32_t start = CycleCounter::now();
+    engine.processNextBlock(view);
+    uint32_t ticks = CycleCounter::elapsed(start, CycleCounter::now());
+
+    if (ticks < min_ticks) min_ticks = ticks;
+    if (ticks > max_ticks) max_ticks = ticks;
+    total_ticks += ticks;
+  }
+  chain->~RenderChain();
+
+  // Cycles available per block in real time at the current clock
+  uint32_t budget = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * BLOCK_SIZE / SAMPLE_RATE);
+  printf("BENCH_RENDER:%s,%s,%lu,%lu,%lu,%lu,%lu\n", scenario.name, CycleCounter::UNIT,
+         (unsigned long)num_blocks, (unsigned long)min_ticks,
+         (unsigned long)(total_ticks / num_blocks), (unsigned long)max_ticks, (unsigned long)budget);
+}
+
+static void runReport() {
+#if PICO_RP2350
+  const char *chip = "rp2350";
+#else
+  const char *chip = "rp2040";
+#endif
+  printf("BENCH_BEGIN\n");
+  printf("BENCH_INFO:%s,%lu,%s\n", chip, (unsigned long)(clock_get_hz(clk_sys) / 1000), PICO_SYNTH_GIT_REV);
+
+  initialize_parameters();
+  dsp_bench::runKernelBenchmarks();
+
+  for (const auto &scenario : buildScenarios()) {
+    benchScenario(scenario);
+  }
+  printf("BENCH_END\n");
+  fflush(stdout);
+}
+
+int main() {
+  stdio_init_all();
+
+  // Same clock configuration as the synth firmware so cycle counts transfer
+  vreg_set_voltage(VREG_VOLTAGE_1_15);
+  sleep_ms(2);
+  set_sys_clock_khz(250000, true);
+  sleep_ms(2);
+
+  CycleCounter::init();
+
+  // Wait for the host to open the port so the first report is not lost
+  while (!stdio_usb_connected()) {
+    sleep_ms(10);
+  }
+  sleep_ms(100);
+
+  while (true) {
+    runReport();
+    // Any received character triggers another run
+    while (getchar_timeout_us(100000) == PICO_ERROR_TIMEOUT) {
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+/**
+ * DspBenchHost.cpp - Runs the DspBench.h kernel microbenchmarks natively
+ *
+ * Same benchmark source as the on-target bench firmware; here the ticks are
+ * steady_clock nanoseconds. Build in Release for meaningful numbers.
+ *
+ * Usage: DspBenchHost > baseline.txt
+ */
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "DspBench.h"
+
+#include <string>
+
+// Parameter.h reports edits to the OLED; there is no display on the host
+void showSynthParameter(std::string_view, float) {}
+
+int main() {
+    initialize_parameters();
+    CycleCounter::init();
+    dsp_bench::runKernelBenchmarks();
+    return 0;
+}
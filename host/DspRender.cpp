@@ -0,0 +1,252 @@
+/**
+ * DspRender.cpp - Deterministic host renders of the DSP chain for regression checks
+ *
+ * Drives Sh101StyleSynth + DrumModule + GainModule (the same chain main.cpp builds on Core 1)
+ * through the scripted note/CC scenarios in BenchScenarios.h, block by block,
+ * with virtual time. The raw fix15 output can be stored as golden renders and
+ * later compared bit-exactly (or within a tolerance) after DSP changes, so a
+ * faster inner loop can be shown to still produce the same audio.
+ *
+ * Usage:
+ *   DspRender --list
+ *   DspRender --write <dir> [scenario...]              store <dir>/<scenario>.raw
+ *   DspRender --check <dir> [--tolerance N] [scenario...]
+ *
+ * Golden files are interleaved stereo int32 fix15, little-endian. The goldens
+ * for every scenario are checked in under host/goldens; regenerate them only
+ * in a commit that means to change the output. Host time per block is printed
+ * for each scenario; it tracks relative cost, not RP2040 cycles.
+ */
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+#include "AudioEngine.h"
+#include "GainModule.h"
+#include "ParameterStore.h"
+#include "Sh101StyleSynth.h"
+#include "DrumModule.h"
+#include "BenchScenarios.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Parameter.h reports edits to the OLED; there is no display on the host
+void showSynthParameter(std::string_view, float) {}
+
+namespace {
+
+using namespace bench_scenarios;
+
+constexpr int NUM_CHANNELS = 2;
+
+// Mirrors MidiSerialListener: notes and bends go through the Core 1 FIFO, CCs set parameters directly
+// (per-part ones on the parts listening on the channel)
+void applyEvent(const ScriptEvent& event) {
+    uint8_t command = event.status & 0xF0;
+    uint8_t channel = event.status & 0x0F;
+    if (command == 0x90 || command == 0x80 || command == 0xE0 || (command == 0xB0 && event.data1 == 123)) {
+        host_sdk::fifoInject(1, (uint32_t)(command << 24) | (event.data1 << 16) | (event.data2 << 8) | (channel << 4));
+        return;
+    }
+    if (command == 0xB0) {
+        for (auto& p : g_synth_parameters) {
+            if (p.getCcNumber() != event.data1) continue;
+            if (!p.isPartParameter()) p.setNormalizedValue(event.data2 / 127.0f);
+            for (int part = 0; part < MAX_PARTS && p.isPartParameter(); ++part) {
+                if (g_part_config[part].listensTo(channel)) p.setNormalizedValue(event.data2 / 127.0f, part);
+            }
+            break;
+        }
+    }
+}
+
+struct RenderResult {
+    std::vector<fix15> samples;
+    double mean_block_ns = 0;
+    double max_block_ns = 0;
+};
+
+RenderResult render(const Scenario& scenario) {
+    // Fresh parameters, FIFOs and modules per scenario so renders are order independent
+    initialize_parameters();
+    g_sequencer_running = false;   // Only a scenario's setup() starts the sequencer
+    if (scenario.setup) scenario.setup();
+    host_sdk::fifoClear(0);
+    host_sdk::fifoClear(1);
+    host_sdk::g_time_us = 0;
+    host_sdk::setCurrentCore(1);
+
+    AudioEngine engine(NUM_CHANNELS, BLOCK_SIZE);
+    Sh101StyleSynth synth((float)SAMPLE_RATE);
+    DrumModule drums((float)SAMPLE_RATE);
+    GainModule master_gain((float)SAMPLE_RATE);
+    synth.setDrumModule(&drums);
+    engine.addModule(&synth);
+    engine.addModule(&drums);
+    engine.addModule(&master_gain);
+
+    RenderResult result;
+    uint32_t num_blocks = (scenario.length_frames + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    result.samples.resize((size_t)num_blocks * BLOCK_SIZE * NUM_CHANNELS);
+
+    size_t next_event = 0;
+    double total_ns = 0;
+    for (uint32_t block = 0; block < num_blocks; ++block) {
+        uint32_t block_end = (block + 1) * BLOCK_SIZE;
+        while (next_event < scenario.events.size() && scenario.events[next_event].frame < block_end) {
+            applyEvent(scenario.events[next_event++]);
+        }
+
+        fix15* block_data = result.samples.data() + (size_t)block * BLOCK_SIZE * NUM_CHANNELS;
+        auto view = choc::buffer::createInterleavedView<fix15>(block_data, NUM_CHANNELS, BLOCK_SIZE);
+
+        auto start = std::chrono::steady_clock::now();
+        engine.processNextBlock(view);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        total_ns += ns;
+        result.max_block_ns = std::max(result.max_block_ns, ns);
+
+        // Waveform samples pushed for the display are not part of the render
+        host_sdk::fifoClear(0);
+        host_sdk::advanceTime((uint64_t)BLOCK_SIZE * 1000000 / SAMPLE_RATE);
+    }
+    result.mean_block_ns = num_blocks ? total_ns / num_blocks : 0;
+    return result;
+}
+
+std::string goldenPath(const std::string& dir, const Scenario& scenario) {
+    return dir + "/" + scenario.name + ".raw";
+}
+
+bool writeGolden(const std::string& path, const std::vector<fix15>& samples) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    for (fix15 sample : samples) {
+        uint32_t v = (uint32_t)sample;
+        uint8_t bytes[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+        std::fwrite(bytes, 1, 4, file);
+    }
+    return std::fclose(file) == 0;
+}
+
+bool readGolden(const std::string& path, std::vector<fix15>& samples) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    uint8_t bytes[4];
+    while (std::fread(bytes, 1, 4, file) == 4) {
+        samples.push_back((fix15)((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+                                  ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24)));
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Returns true when every sample is within tolerance of the golden render
+bool compare(const Scenario& scenario, const std::vector<fix15>& rendered,
+             const std::vector<fix15>& golden, int32_t tolerance) {
+    if (rendered.size() != golden.size()) {
+        std::printf("  %s: length %zu differs from golden %zu\n", scenario.name, rendered.size(), golden.size());
+        return false;
+    }
+
+    int64_t max_diff = 0;
+    size_t first_bad = rendered.size(), bad_count = 0;
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        int64_t diff = std::llabs((int64_t)rendered[i] - golden[i]);
+        max_diff = std::max(max_diff, diff);
+        if (diff > tolerance) {
+            if (first_bad == rendered.size()) first_bad = i;
+            bad_count++;
+        }
+    }
+
+    if (bad_count == 0) {
+        std::printf("  %s: match (max difference %lld)\n", scenario.name, (long long)max_diff);
+        return true;
+    }
+    size_t frame = first_bad / NUM_CHANNELS;
+    std::printf("  %s: %zu samples differ, first at frame %zu (block %zu, %.1f ms), max difference %lld\n",
+                scenario.name, bad_count, frame, frame / BLOCK_SIZE, frame * 1000.0 / SAMPLE_RATE,
+                (long long)max_diff);
+    return false;
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr, "Usage: %s --list\n"
+                         "       %s --write <dir> [scenario...]\n"
+                         "       %s --check <dir> [--tolerance N] [scenario...]\n",
+                 program, program, program);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<Scenario> scenarios = buildScenarios();
+    if (argc < 2) return usage(argv[0]);
+
+    std::string mode = argv[1];
+    if (mode == "--list") {
+        for (const auto& s : scenarios) {
+            std::printf("%-14s %6.2f s  %s\n", s.name, s.length_frames / (double)SAMPLE_RATE, s.description);
+        }
+        return 0;
+    }
+    if ((mode != "--write" && mode != "--check") || argc < 3) return usage(argv[0]);
+
+    std::string dir = argv[2];
+    int32_t tolerance = 0;
+    std::vector<const Scenario*> selected;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atoi(argv[++i]);
+            continue;
+        }
+        auto it = std::find_if(scenarios.begin(), scenarios.end(),
+                               [&](const Scenario& s) { return std::strcmp(s.name, argv[i]) == 0; });
+        if (it == scenarios.end()) {
+            std::fprintf(stderr, "Unknown scenario %s (see --list)\n", argv[i]);
+            return 2;
+        }
+        selected.push_back(&*it);
+    }
+    if (selected.empty()) {
+        for (const auto& s : scenarios) selected.push_back(&s);
+    }
+
+    int failures = 0;
+    for (const Scenario* scenario : selected) {
+        RenderResult result = render(*scenario);
+        std::printf("%s: %zu blocks, %.0f ns/block mean, %.0f ns/block max\n", scenario->name,
+                    result.samples.size() / (BLOCK_SIZE * NUM_CHANNELS), result.mean_block_ns, result.max_block_ns);
+
+        std::string path = goldenPath(dir, *scenario);
+        if (mode == "--write") {
+            if (!writeGolden(path, result.samples)) {
+                std::fprintf(stderr, "  cannot write %s\n", path.c_str());
+                failures++;
+            }
+            continue;
+        }
+
+        std::vector<fix15> golden;
+        if (!readGolden(path, golden)) {
+            std::fprintf(stderr, "  cannot read %s\n", path.c_str());
+            failures++;
+        } else if (!compare(*scenario, result.samples, golden, tolerance)) {
+            failures++;
+        }
+    }
+
+    if (mode == "--check") {
+        std::printf("%zu scenarios, %d failed\n", selected.size(), failures);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * FirmwareHost.cpp - Runs the unmodified firmware (main.cpp) as a Linux process
+ *
+ * main.cpp is compiled with main renamed to firmware_main against the SDK shim
+ * in sdk_shim/: Core 0 is this process's main thread, Core 1 a second thread,
+ * and the inter-core FIFOs are 8-deep bounded queues. DMA, the PIO I2S state
+ * machine and the I2C OLED are modelled in sdk_shim/HostDevices.h and paced in
+ * emulated time, so FIFO back-pressure, display stalls and late audio blocks
+ * show up as they would on the board, relative to host CPU speed.
+ *
+ * The serial port is a pseudo-terminal by default (its path is printed on
+ * stderr; point MidiSerialListener clients at it), or the terminal with --stdio.
+ *
+ * Usage:
+ *   FirmwareHost [--stdio] [--speed X] [--duration S] [--wav FILE] [--frames DIR]
+ *
+ *   --speed X      emulated time runs X times faster than the wall clock (default 1)
+ *   --duration S   stop after S emulated seconds and print the load report
+ *   --wav FILE     record the I2S output as 16-bit stereo WAV
+ *   --frames DIR   save the OLED as DIR/oled_NNNNN.pbm whenever it changes (at most
+ *                  every 100 ms of emulated time) and DIR/oled_last.pbm at exit
+ *
+ * Ctrl-C also stops with a report. Report lines go to stderr.
+ */
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/dma.h"
+
+#include "EngineTelemetry.h"
+#include "I2sAudioOutput.h"
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+int firmware_main();
+
+namespace {
+
+constexpr int SAMPLE_RATE = I2sAudioOutput::SAMPLE_RATE;
+constexpr uint64_t FRAME_INTERVAL_US = 100000;
+
+std::atomic<bool> g_stop{false};
+
+// Streams 16-bit stereo PCM to a WAV file; sizes are patched in by finish()
+class WavWriter {
+public:
+    bool open(const char* path) {
+        file = std::fopen(path, "wb");
+        if (!file) return false;
+        writeHeader(0);
+        return true;
+    }
+
+    // I2S word: left in the low half, right in the high half (I2sFramePack.h)
+    void write(uint32_t word) {
+        int16_t frame[2] = {(int16_t)(word & 0xFFFF), (int16_t)(word >> 16)};
+        std::fwrite(frame, sizeof(frame), 1, file);
+        frames++;
+    }
+
+    void finish() {
+        if (!file) return;
+        std::fseek(file, 0, SEEK_SET);
+        writeHeader(frames * 4);
+        std::fclose(file);
+        file = nullptr;
+    }
+
+private:
+    void writeHeader(uint32_t data_bytes) {
+        auto u32 = [&](uint32_t v) { std::fwrite(&v, 4, 1, file); };
+        auto u16 = [&](uint16_t v) { std::fwrite(&v, 2, 1, file); };
+        std::fwrite("RIFF", 1, 4, file);
+        u32(36 + data_bytes);
+        std::fwrite("WAVEfmt ", 1, 8, file);
+        u32(16);
+        u16(1);                     // PCM
+        u16(2);
+        u32(SAMPLE_RATE);
+        u32(SAMPLE_RATE * 4);
+        u16(4);
+        u16(16);
+        std::fwrite("data", 1, 4, file);
+        u32(data_bytes);
+    }
+
+    FILE* file = nullptr;
+    uint32_t frames = 0;
+};
+
+WavWriter g_wav;
+
+// Creates the pseudo-terminal that stands in for USB CDC and routes stdout to it
+bool openSerialPty() {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) return false;
+    const char* slave_path = ptsname(master);
+    if (!slave_path) return false;
+
+    // Holding the slave open keeps the master from hanging up between client connections
+    int slave = open(slave_path, O_RDWR | O_NOCTTY);
+    if (slave < 0) return false;
+    termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    // Output nobody reads is dropped instead of blocking Core 0, like the SDK's USB stdio
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    std::fflush(stdout);
+    dup2(master, STDOUT_FILENO);
+    std::fprintf(stderr, "Serial port: %s\n", slave_path);
+    host_sdk::g_serial_fd = master;
+    return true;
+}
+
+// Runs while the firmware's heap is locked (HeapGuard.h), so the path is built without allocating
+void saveFrame(const std::string& dir, const char* name) {
+    char path[4096];
+    std::snprintf(path, sizeof(path), "%s/%s", dir.c_str(), name);
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    if (!host_sdk::g_devices.i2c.display.writePbm(path)) {
+        std::fprintf(stderr, "Cannot write %s\n", path);
+    }
+}
+
+void printFifo(const char* name, const host_sdk::FifoStats& stats) {
+    std::fprintf(stderr, "fifo %s: %llu pushes, peak depth %u/%zu, %llu blocked, %llu dropped\n", name,
+                 (unsigned long long)stats.pushes, stats.peak.load(), host_sdk::FIFO_DEPTH,
+                 (unsigned long long)stats.blocked, (unsigned long long)stats.dropped);
+}
+
+void printReport(double speed) {
+    double seconds = host_sdk::nowUs() / 1e6;
+    EngineTelemetrySnapshot engine = g_engine_telemetry.read();
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    const host_sdk::Devices& d = host_sdk::g_devices;
+
+    // Played blocks beyond the rendered ones were replayed stale by the DMA: Core 1 fell behind.
+    // The firmware's xrun count only sees a single missed IRQ per render.
+    std::fprintf(stderr, "emulated %.3f s at speed %.2f\n", seconds, speed);
+    std::fprintf(stderr, "audio: %u blocks rendered, %llu played, %u xruns, peak block %u us of %u us budget\n",
+                 (unsigned)engine.block_count, (unsigned long long)(d.pio_words / I2sAudioOutput::BUFFER_SIZE),
+                 (unsigned)engine.xrun_count, (unsigned)engine.peak_block_us, (unsigned)engine.block_budget_us);
+    std::fprintf(stderr, "i2s: %llu frames out, %llu PIO stalls\n",
+                 (unsigned long long)d.pio_words, (unsigned long long)d.pio_stalls);
+    printFifo("core0->core1", host_sdk::g_fifo_stats[1]);
+    printFifo("core1->core0", host_sdk::g_fifo_stats[0]);
+    std::fprintf(stderr, "oled: %llu DMA updates, %llu blocking writes, %llu bytes, bus busy %.3f s (%.1f%%)\n",
+                 (unsigned long long)d.i2c.dma_transfers, (unsigned long long)d.i2c.blocking_writes,
+                 (unsigned long long)d.i2c.bytes, d.i2c.busy_us / 1e6,
+                 seconds > 0.0 ? 100.0 * d.i2c.busy_us / 1e6 / seconds : 0.0);
+}
+
+int usage(const char* argv0) {
+    std::fprintf(stderr, "Usage: %s [--stdio] [--speed X] [--duration S] [--wav FILE] [--frames DIR]\n", argv0);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool use_stdio = false;
+    double speed = 1.0;
+    double duration_s = 0.0;
+    std::string wav_path, frames_dir;
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--stdio") == 0) {
+            use_stdio = true;
+        } else if (std::strcmp(argv[i], "--speed") == 0 && has_value) {
+            speed = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--duration") == 0 && has_value) {
+            duration_s = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--wav") == 0 && has_value) {
+            wav_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            frames_dir = argv[++i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (speed <= 0.0) return usage(argv[0]);
+
+    if (use_stdio) {
+        host_sdk::g_serial_fd = STDIN_FILENO;
+    } else if (!openSerialPty()) {
+        std::fprintf(stderr, "Cannot create a pseudo-terminal; use --stdio\n");
+        return 1;
+    }
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    if (!wav_path.empty()) {
+        if (!g_wav.open(wav_path.c_str())) {
+            std::fprintf(stderr, "Cannot write %s\n", wav_path.c_str());
+            return 1;
+        }
+        host_sdk::g_pio_sink = [](unsigned, uint32_t word) { g_wav.write(word); };
+    }
+
+    std::signal(SIGINT, [](int) { g_stop = true; });
+    host_sdk::useRealTime(speed);
+
+    // Supervisor: OLED snapshots, the duration limit and the final report
+    std::thread([=] {
+        uint64_t last_generation = 0, last_frame_us = 0;
+        unsigned frame_index = 0;
+        uint64_t end_us = (uint64_t)(duration_s * 1e6);
+        while (!g_stop && (!end_us || host_sdk::nowUs() < end_us)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            uint64_t now = host_sdk::nowUs();
+            if (frames_dir.empty() || now - last_frame_us < FRAME_INTERVAL_US) continue;
+            uint64_t generation;
+            {
+                std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+                generation = host_sdk::g_devices.i2c.display.generation;
+            }
+            if (generation == last_generation) continue;
+            char name[32];
+            std::snprintf(name, sizeof(name), "oled_%05u.pbm", frame_index++);
+            saveFrame(frames_dir, name);
+            last_generation = generation;
+            last_frame_us = now;
+        }
+
+        std::fflush(stdout);
+        printReport(speed);
+        if (!frames_dir.empty()) saveFrame(frames_dir, "oled_last.pbm");
+        {
+            std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+            g_wav.finish();
+            host_sdk::g_pio_sink = nullptr;
+        }
+        std::_Exit(0);      // The emulated cores never return
+    }).detach();
+
+    return firmware_main();
+}
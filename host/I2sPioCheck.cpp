@@ -0,0 +1,616 @@
+/**
+ * I2sPioCheck.cpp - Runs audio_i2s.pio in a PIO interpreter and checks the I2S waveform
+ *
+ * Assembles the programs in audio_i2s.pio (a pioasm subset: out, set, jmp with
+ * all conditions, mov between x/y/osr/null, nop, pull, side-set, delays, wrap)
+ * and steps one state machine cycle by cycle, configured like
+ * I2sAudioOutput::init: 1 out pin, 2 side-set pins (BCLK at the base), shift
+ * left with autopull at 32 bits, started at the public entry_point. Its FIFO
+ * is fed with words from packI2sFrames (what fillAndConvertNextBuffer sends).
+ *
+ * The pin trace is then checked against the Philips I2S format:
+ * - BCLK is a steady square wave
+ * - DATA and LRCLK only change while BCLK is low (receivers latch on the rising edge)
+ * - LRCLK slots are 16 BCLKs each; the MSB follows the LRCLK edge by one BCLK
+ * - Decoding the slots (LRCLK low = left) gives back every input frame
+ *
+ * Usage:
+ *   I2sPioCheck [--pio FILE] [--vcd FILE]
+ *
+ * --vcd writes the audio_i2s pin trace for a waveform viewer. Exits non-zero
+ * if any program fails, so it can be run after editing the PIO program.
+ */
+
+#include "I2sFramePack.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifndef AUDIO_I2S_PIO_PATH
+#define AUDIO_I2S_PIO_PATH "audio_i2s.pio"
+#endif
+
+namespace {
+
+constexpr int SLOT_BITS = 16;       // packI2sFrames sends 16-bit samples
+constexpr int TEST_FRAMES = 256;
+constexpr int OSR_BITS = 32;        // Autopull threshold set by I2sAudioOutput
+
+//==============================================================================
+// Assembler
+//==============================================================================
+
+enum class Op { JMP, OUT, SET, MOV, PULL };
+
+// Operand codes shared by out/set/mov destinations and mov sources
+enum Operand { PINS, X, Y, NUL, OSR, ISR, PINDIRS };
+
+struct Instr {
+    Op op;
+    int cond = 0;           // jmp: 0 always, 1 !x, 2 x--, 3 !y, 4 y--, 5 x!=y, 6 pin, 7 !osre
+    int dest = 0;
+    int src = 0;
+    bool invert = false;    // mov with ! or ~
+    uint32_t value = 0;     // out bit count, set value, jmp target
+    bool block = true;      // pull
+    bool if_empty = false;  // pull
+    int side = -1;          // -1 = none (only legal with .side_set opt)
+    int delay = 0;
+    int line = 0;
+    std::string target;     // jmp label, resolved after the program is read
+};
+
+struct Program {
+    std::string name;
+    std::vector<Instr> code;
+    std::map<std::string, int> labels;
+    std::map<std::string, int> public_labels;
+    int side_bits = 0;
+    bool side_opt = false;
+    int wrap_target = 0;
+    int wrap = -1;
+};
+
+bool parseNumber(const std::string& text, uint32_t& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    if (text.rfind("0b", 0) == 0) value = (uint32_t)std::strtoul(text.c_str() + 2, &end, 2);
+    else value = (uint32_t)std::strtoul(text.c_str(), &end, 0);
+    return *end == '\0';
+}
+
+bool parseOperand(const std::string& text, int& operand) {
+    static const std::map<std::string, int> names = {
+        {"pins", PINS}, {"x", X}, {"y", Y}, {"null", NUL}, {"osr", OSR}, {"isr", ISR}, {"pindirs", PINDIRS},
+    };
+    auto it = names.find(text);
+    if (it == names.end()) return false;
+    operand = it->second;
+    return true;
+}
+
+std::vector<std::string> tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string token;
+    for (char c : text) {
+        if (std::isspace((unsigned char)c) || c == ',') {
+            if (!token.empty()) tokens.push_back(token);
+            token.clear();
+        } else {
+            token += (char)std::tolower((unsigned char)c);
+        }
+    }
+    if (!token.empty()) tokens.push_back(token);
+    return tokens;
+}
+
+// Parses one instruction (labels already removed); returns an error message or ""
+std::string parseInstr(const std::string& text, const Program& program, Instr& instr) {
+    std::string body = text;
+
+    // Trailing [delay]
+    size_t bracket = body.find('[');
+    if (bracket != std::string::npos) {
+        size_t close = body.find(']', bracket);
+        uint32_t delay;
+        if (close == std::string::npos || !parseNumber(body.substr(bracket + 1, close - bracket - 1), delay)) {
+            return "bad delay";
+        }
+        instr.delay = (int)delay;
+        body.erase(bracket);
+    }
+
+    std::vector<std::string> tokens = tokenize(body);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (tokens[i] != "side" && tokens[i] != "sideset") continue;
+        uint32_t side;
+        if (i + 1 >= tokens.size() || !parseNumber(tokens[i + 1], side)) return "bad side-set value";
+        instr.side = (int)side;
+        tokens.erase(tokens.begin() + i, tokens.begin() + i + 2);
+        break;
+    }
+    if (tokens.empty()) return "missing instruction";
+    if (instr.side < 0 && program.side_bits && !program.side_opt) return "side-set required";
+    if (instr.side >= (1 << program.side_bits)) return "side-set value too wide";
+    int delay_bits = 5 - program.side_bits - (program.side_opt ? 1 : 0);
+    if (instr.delay >= (1 << delay_bits)) return "delay too long for the side-set width";
+
+    const std::string& op = tokens[0];
+    auto operands = [&](size_t n) { return tokens.size() == n + 1; };
+    if (op == "out" && operands(2)) {
+        instr.op = Op::OUT;
+        if (!parseOperand(tokens[1], instr.dest) || !parseNumber(tokens[2], instr.value)) return "bad out";
+        if (instr.value < 1 || instr.value > 32) return "out bit count must be 1-32";
+    } else if (op == "set" && operands(2)) {
+        instr.op = Op::SET;
+        if (!parseOperand(tokens[1], instr.dest) || !parseNumber(tokens[2], instr.value)) return "bad set";
+        if (instr.value > 31) return "set value must be 0-31";
+    } else if (op == "jmp" && (operands(1) || operands(2))) {
+        static const std::map<std::string, int> conds = {
+            {"!x", 1}, {"x--", 2}, {"!y", 3}, {"y--", 4}, {"x!=y", 5}, {"pin", 6}, {"!osre", 7},
+        };
+        instr.op = Op::JMP;
+        if (operands(2)) {
+            auto it = conds.find(tokens[1]);
+            if (it == conds.end()) return "bad jmp condition";
+            instr.cond = it->second;
+        }
+        instr.target = tokens.back();
+    } else if (op == "mov" && operands(2)) {
+        instr.op = Op::MOV;
+        std::string src = tokens[2];
+        if (!src.empty() && (src[0] == '!' || src[0] == '~')) {
+            instr.invert = true;
+            src.erase(0, 1);
+        }
+        if (!parseOperand(tokens[1], instr.dest) || !parseOperand(src, instr.src)) return "bad mov";
+    } else if (op == "nop" && operands(0)) {
+        instr.op = Op::MOV;         // Assembles to mov y, y
+        instr.dest = instr.src = Y;
+    } else if (op == "pull") {
+        instr.op = Op::PULL;
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            if (tokens[i] == "ifempty") instr.if_empty = true;
+            else if (tokens[i] == "noblock") instr.block = false;
+            else if (tokens[i] != "block") return "bad pull";
+        }
+    } else {
+        return "unsupported instruction '" + op + "'";
+    }
+    return "";
+}
+
+bool assemble(const std::string& path, std::vector<Program>& programs) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    bool in_code_block = false;
+    auto fail = [&](const std::string& message) {
+        std::fprintf(stderr, "%s:%d: %s\n", path.c_str(), line_number, message.c_str());
+        return false;
+    };
+
+    while (std::getline(in, line)) {
+        line_number++;
+        if (in_code_block) {
+            if (line.find("%}") != std::string::npos) in_code_block = false;
+            continue;
+        }
+        if (line.rfind("%", 0) == 0) {
+            in_code_block = true;
+            continue;
+        }
+        line = line.substr(0, line.find(';'));
+        line = line.substr(0, line.find("//"));
+
+        std::vector<std::string> tokens = tokenize(line);
+        if (tokens.empty()) continue;
+
+        if (tokens[0][0] == '.') {
+            const std::string& directive = tokens[0];
+            if (directive == ".program" && tokens.size() == 2) {
+                programs.push_back({});
+                programs.back().name = tokens[1];
+                continue;
+            }
+            if (programs.empty()) return fail("directive before .program");
+            Program& program = programs.back();
+            uint32_t bits;
+            if (directive == ".side_set" && tokens.size() >= 2 && parseNumber(tokens[1], bits)) {
+                program.side_bits = (int)bits;
+                for (size_t i = 2; i < tokens.size(); ++i) {
+                    if (tokens[i] == "opt") program.side_opt = true;
+                    else return fail("unsupported .side_set option " + tokens[i]);
+                }
+            } else if (directive == ".wrap_target") {
+                program.wrap_target = (int)program.code.size();
+            } else if (directive == ".wrap") {
+                program.wrap = (int)program.code.size() - 1;
+            } else if (directive != ".origin" && directive != ".lang_opt") {
+                return fail("unsupported directive " + directive);
+            }
+            continue;
+        }
+        if (programs.empty()) return fail("instruction before .program");
+        Program& program = programs.back();
+
+        // Labels: "name:" or "public name:", possibly followed by an instruction
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            std::vector<std::string> label = tokenize(line.substr(0, colon));
+            bool is_public = label.size() == 2 && label[0] == "public";
+            if (label.size() != 1 && !is_public) return fail("bad label");
+            program.labels[label.back()] = (int)program.code.size();
+            if (is_public) program.public_labels[label.back()] = (int)program.code.size();
+            line = line.substr(colon + 1);
+            if (tokenize(line).empty()) continue;
+        }
+
+        Instr instr;
+        instr.line = line_number;
+        std::string error = parseInstr(line, program, instr);
+        if (!error.empty()) return fail(error);
+        program.code.push_back(instr);
+        if (program.code.size() > 32) return fail("program longer than 32 instructions");
+    }
+
+    for (Program& program : programs) {
+        if (program.wrap < 0) program.wrap = (int)program.code.size() - 1;
+        for (Instr& instr : program.code) {
+            if (instr.op != Op::JMP) continue;
+            uint32_t address;
+            auto it = program.labels.find(instr.target);
+            if (it != program.labels.end()) instr.value = (uint32_t)it->second;
+            else if (parseNumber(instr.target, address)) instr.value = address;
+            else {
+                line_number = instr.line;
+                return fail("unknown label " + instr.target);
+            }
+        }
+    }
+    return true;
+}
+
+//==============================================================================
+// State machine
+//==============================================================================
+
+struct PinSample {
+    uint8_t data, bclk, lrclk;
+};
+
+// One state machine, wired like I2sAudioOutput: out pin = DATA, side-set pins from CLOCK_PIN_BASE
+class StateMachine {
+public:
+    StateMachine(const Program& program, int bclk_bit, int lrclk_bit)
+        : program(program), bclk_bit(bclk_bit), lrclk_bit(lrclk_bit) {}
+
+    std::deque<uint32_t> fifo;
+    std::vector<PinSample> trace;
+
+    // Runs until the FIFO is drained and the state machine stalls on it
+    bool run(int start_pc, size_t max_cycles) {
+        pc = start_pc;
+        record();       // Pins are low until the state machine starts
+        while (trace.size() < max_cycles) {
+            if (!step()) return true;
+        }
+        std::fprintf(stderr, "%s: no stall after %zu cycles\n", program.name.c_str(), max_cycles);
+        return false;
+    }
+
+private:
+    // Executes one cycle; false once it stalls with nothing left to pull
+    bool step() {
+        if (delay_left) {
+            delay_left--;
+            record();
+            return true;
+        }
+        const Instr& instr = program.code[pc];
+        if (instr.side >= 0) side_pins = (uint32_t)instr.side;     // Asserted even while stalled
+
+        int next_pc = pc == program.wrap ? program.wrap_target : pc + 1;
+        switch (instr.op) {
+            case Op::OUT: {
+                if (osr_count >= OSR_BITS) {                        // Autopull
+                    if (fifo.empty()) return false;
+                    osr = fifo.front();
+                    fifo.pop_front();
+                    osr_count = 0;
+                }
+                uint32_t n = instr.value;
+                uint32_t bits = n == 32 ? osr : osr >> (32 - n);   // Shift left: MSBs first
+                osr = n == 32 ? 0 : osr << n;
+                osr_count += (int)n;
+                write(instr.dest, bits);
+                break;
+            }
+            case Op::SET:
+                write(instr.dest, instr.value);
+                break;
+            case Op::MOV: {
+                uint32_t value = read(instr.src);
+                write(instr.dest, instr.invert ? ~value : value);
+                if (instr.dest == OSR) osr_count = 0;
+                break;
+            }
+            case Op::PULL:
+                if (!instr.if_empty || osr_count >= OSR_BITS) {
+                    if (fifo.empty()) {
+                        if (instr.block) return false;
+                        osr = x;                                    // Non-blocking pull of an empty FIFO copies X
+                    } else {
+                        osr = fifo.front();
+                        fifo.pop_front();
+                    }
+                    osr_count = 0;
+                }
+                break;
+            case Op::JMP: {
+                bool taken = true;
+                switch (instr.cond) {
+                    case 1: taken = x == 0; break;
+                    case 2: taken = x != 0; x--; break;
+                    case 3: taken = y == 0; break;
+                    case 4: taken = y != 0; y--; break;
+                    case 5: taken = x != y; break;
+                    case 6: taken = false; break;                   // No jmp pin configured
+                    case 7: taken = osr_count < OSR_BITS; break;
+                }
+                if (taken) next_pc = (int)instr.value;
+                break;
+            }
+        }
+        pc = next_pc;
+        delay_left = instr.delay;
+        record();
+        return true;
+    }
+
+    uint32_t read(int operand) const {
+        switch (operand) {
+            case PINS: return out_pins;
+            case X: return x;
+            case Y: return y;
+            case OSR: return osr;
+            default: return 0;
+        }
+    }
+
+    void write(int operand, uint32_t value) {
+        switch (operand) {
+            case PINS: out_pins = value & 1; break;                 // One out pin (DATA)
+            case X: x = value; break;
+            case Y: y = value; break;
+            case OSR: osr = value; break;
+            default: break;
+        }
+    }
+
+    void record() {
+        trace.push_back({(uint8_t)(out_pins & 1), (uint8_t)((side_pins >> bclk_bit) & 1),
+                         (uint8_t)((side_pins >> lrclk_bit) & 1)});
+    }
+
+    const Program& program;
+    const int bclk_bit, lrclk_bit;
+    int pc = 0;
+    int delay_left = 0;
+    uint32_t x = 0, y = 0;          // Zero after reset; pio_sm_init does not touch them
+    uint32_t osr = 0;
+    int osr_count = OSR_BITS;       // pio_sm_init leaves the OSR empty
+    uint32_t out_pins = 0, side_pins = 0;
+};
+
+//==============================================================================
+// I2S checks
+//==============================================================================
+
+struct Frame {
+    int16_t left, right;
+};
+
+// Distinct left/right sequences: single-bit and alternating patterns, then pseudo-random values
+std::vector<Frame> testFrames() {
+    const int16_t patterns[] = {(int16_t)0x8000, 0x7FFF, 0x0001, -1, (int16_t)0xAAAA, 0x5555, 0, 0x1234};
+    std::vector<Frame> frames;
+    uint32_t seed = 12345;
+    for (int i = 0; i < TEST_FRAMES; ++i) {
+        int n = sizeof(patterns) / sizeof(patterns[0]);
+        if (i < n) {
+            frames.push_back({patterns[i], patterns[n - 1 - i]});
+            continue;
+        }
+        seed = seed * 1664525u + 1013904223u;
+        int16_t left = (int16_t)(seed >> 16);
+        seed = seed * 1664525u + 1013904223u;
+        frames.push_back({left, (int16_t)(seed >> 16)});
+    }
+    return frames;
+}
+
+struct Report {
+    std::vector<std::string> errors;
+    int bclk_period = 0;
+    int frames_decoded = 0;
+
+    void error(const char* fmt, int a = 0, int b = 0, int c = 0) {
+        if (errors.size() >= 8) return;
+        char text[160];
+        std::snprintf(text, sizeof(text), fmt, a, b, c);
+        errors.push_back(text);
+    }
+};
+
+Report checkTrace(const std::vector<PinSample>& trace, const std::vector<Frame>& sent) {
+    Report report;
+
+    // Rising edges of BCLK; the first cycles before the clock starts are ignored
+    std::vector<size_t> rising;
+    for (size_t i = 1; i < trace.size(); ++i) {
+        if (!trace[i - 1].bclk && trace[i].bclk) rising.push_back(i);
+    }
+    if (rising.size() < 3) {
+        report.error("BCLK does not toggle");
+        return report;
+    }
+
+    // Steady square wave between the first and last edge
+    report.bclk_period = (int)(rising[1] - rising[0]);
+    for (size_t k = 1; k < rising.size(); ++k) {
+        int period = (int)(rising[k] - rising[k - 1]);
+        if (period != report.bclk_period) report.error("BCLK period %d at cycle %d (expected %d)", period, (int)rising[k], report.bclk_period);
+    }
+    for (size_t k = 1; k < rising.size(); ++k) {
+        int high = 0;
+        for (size_t i = rising[k - 1]; i < rising[k]; ++i) high += trace[i].bclk;
+        if (2 * high != report.bclk_period) report.error("BCLK high for %d of %d cycles at cycle %d", high, report.bclk_period, (int)rising[k - 1]);
+    }
+    for (size_t i = rising[0] + 1; i < rising.back(); ++i) {
+        if ((trace[i].data != trace[i - 1].data || trace[i].lrclk != trace[i - 1].lrclk) && trace[i].bclk) {
+            report.error("DATA/LRCLK changes while BCLK is high at cycle %d", (int)i);
+        }
+    }
+
+    // Sample what a receiver latches on each rising edge, after the LRCLK level it starts with
+    std::vector<int> ws = {trace[rising[0] - 1].lrclk}, sd = {0};
+    for (size_t i : rising) {
+        ws.push_back(trace[i].lrclk);
+        sd.push_back(trace[i].data);
+    }
+
+    // A slot starts one BCLK after the LRCLK edge and ends with the bit latched on the next edge
+    std::vector<int16_t> left, right;
+    std::vector<size_t> changes;
+    for (size_t k = 1; k < ws.size(); ++k) {
+        if (ws[k] != ws[k - 1]) changes.push_back(k);
+    }
+    for (size_t c = 0; c + 1 < changes.size(); ++c) {
+        size_t first = changes[c] + 1, last = changes[c + 1];
+        int bits = (int)(last - first + 1);
+        if (bits != SLOT_BITS) {
+            report.error("slot of %d bits at BCLK %d (expected %d)", bits, (int)first, SLOT_BITS);
+            continue;
+        }
+        uint32_t word = 0;
+        for (size_t k = first; k <= last; ++k) word = (word << 1) | (uint32_t)sd[k];
+        (ws[changes[c]] ? right : left).push_back((int16_t)word);
+    }
+
+    // Every frame must come back, right then left in time, starting with the first one sent
+    int count = (int)std::min(left.size(), right.size());
+    for (int i = 0; i < count; ++i) {
+        if (left[i] != sent[i].left || right[i] != sent[i].right) {
+            report.error("frame %d decoded as L 0x%04x R 0x%04x", i, (uint16_t)left[i], (uint16_t)right[i]);
+        }
+    }
+    report.frames_decoded = count;
+    if (count < (int)sent.size()) report.error("only %d of %d frames decoded", count, (int)sent.size());
+    return report;
+}
+
+void writeVcd(const char* path, const std::vector<PinSample>& trace) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "Cannot write %s\n", path);
+        return;
+    }
+    // One PIO cycle at 44.1 kHz x 64 cycles per frame is 354 ns
+    const double ns_per_cycle = 1e9 / (44100.0 * 64.0);
+    std::fprintf(f, "$timescale 1 ns $end\n$scope module audio_i2s $end\n");
+    std::fprintf(f, "$var wire 1 b BCLK $end\n$var wire 1 l LRCLK $end\n$var wire 1 d DATA $end\n");
+    std::fprintf(f, "$upscope $end\n$enddefinitions $end\n");
+    PinSample previous{2, 2, 2};
+    for (size_t i = 0; i < trace.size(); ++i) {
+        const PinSample& s = trace[i];
+        if (s.bclk == previous.bclk && s.lrclk == previous.lrclk && s.data == previous.data) continue;
+        std::fprintf(f, "#%llu\n", (unsigned long long)(i * ns_per_cycle));
+        if (s.bclk != previous.bclk) std::fprintf(f, "%db\n", s.bclk);
+        if (s.lrclk != previous.lrclk) std::fprintf(f, "%dl\n", s.lrclk);
+        if (s.data != previous.data) std::fprintf(f, "%dd\n", s.data);
+        previous = s;
+    }
+    std::fclose(f);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string pio_path = AUDIO_I2S_PIO_PATH;
+    const char* vcd_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--pio") == 0 && i + 1 < argc) {
+            pio_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--vcd") == 0 && i + 1 < argc) {
+            vcd_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--pio FILE] [--vcd FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Program> programs;
+    if (!assemble(pio_path, programs)) return 1;
+
+    // Side-set pin order of each program (bit 0 is CLOCK_PIN_BASE)
+    struct Wiring {
+        const char* program;
+        int bclk_bit, lrclk_bit;
+    };
+    const Wiring wirings[] = {{"audio_i2s", 0, 1}, {"audio_i2s_swapped", 1, 0}};
+
+    std::vector<Frame> frames = testFrames();
+    std::vector<fix15> stereo;
+    for (const Frame& frame : frames) {
+        stereo.push_back((fix15)frame.left);
+        stereo.push_back((fix15)frame.right);
+    }
+    std::vector<uint32_t> words(frames.size());
+    packI2sFrames(stereo.data(), words.data(), (int)frames.size());
+
+    int checked = 0, failures = 0;
+    for (const Wiring& wiring : wirings) {
+        const Program* program = nullptr;
+        for (const Program& p : programs) {
+            if (p.name == wiring.program) program = &p;
+        }
+        if (!program) continue;
+        auto entry = program->public_labels.find("entry_point");
+        int start_pc = entry != program->public_labels.end() ? entry->second : 0;
+
+        StateMachine sm(*program, wiring.bclk_bit, wiring.lrclk_bit);
+        sm.fifo.assign(words.begin(), words.end());
+        bool ran = sm.run(start_pc, frames.size() * 64 * 4);
+        Report report = checkTrace(sm.trace, frames);
+        if (!ran) report.error("state machine never drained its FIFO");
+        checked++;
+
+        std::printf("%-18s %zu instructions, start %d, BCLK %d cycles, %d of %zu frames decoded  %s\n",
+                    program->name.c_str(), program->code.size(), start_pc, report.bclk_period,
+                    report.frames_decoded, frames.size(), report.errors.empty() ? "ok" : "FAILED");
+        for (const std::string& error : report.errors) std::printf("  %s\n", error.c_str());
+        if (!report.errors.empty()) failures++;
+        if (vcd_path && wiring.bclk_bit == 0) writeVcd(vcd_path, sm.trace);
+    }
+    if (!checked) {
+        std::fprintf(stderr, "%s has no audio_i2s program\n", pio_path.c_str());
+        return 1;
+    }
+    std::printf("%d programs, %d failed\n", checked, failures);
+    return failures ? 1 : 0;
+}
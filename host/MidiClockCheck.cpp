@@ -0,0 +1,118 @@
+/**
+ * MidiClockCheck.cpp - Drives MidiClockTracker with synthetic jittered clock streams
+ *
+ * Each scenario generates ideal 24 ppqn tick times from a tempo curve, then
+ * delays them the way USB serial does: uniform sender jitter, 1 ms USB frames
+ * and the Core 0 loop's polling delay, plus occasional late bursts. The tracker
+ * sees only the arrival times. After it locks, its tempo is compared with the
+ * true tempo on every tick.
+ *
+ * Usage:
+ *   MidiClockCheck [--verbose]
+ *
+ * Prints one line per scenario (lock time, RMS and max tempo error once
+ * settled) and exits non-zero if any scenario misses its limits, so it can be
+ * run after changing the loop gains.
+ */
+
+#include "MidiClockTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+
+namespace {
+
+struct Scenario {
+    const char* name;
+    double beats;
+    std::function<double(double beat)> bpm;    // True tempo at a beat position
+    double jitter_us;                           // Uniform sender jitter, +/-
+    double burst_chance;                        // Chance a tick is held back with the next one
+    double settle_beats;                        // Measured only after this (and after lock)
+    double max_rms_bpm;
+    double max_error_bpm;
+    bool tempo_jumps = false;                   // Re-seeding (briefly unlocked) is expected
+};
+
+struct Result {
+    double lock_beats = -1;
+    double rms_bpm = 0;
+    double max_bpm = 0;
+    bool lost_lock = false;
+};
+
+Result run(const Scenario& scenario, bool verbose) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> jitter(-scenario.jitter_us, scenario.jitter_us);
+    std::uniform_real_distribution<double> poll(0.0, 200.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    MidiClockTracker tracker;
+    Result result;
+    double t_us = 1000000.0, beat = 0.0, sum_sq = 0.0;
+    int measured = 0;
+    int total_ticks = (int)(scenario.beats * MidiClockTracker::TICKS_PER_BEAT);
+    double held_back_until = 0.0;
+
+    for (int i = 0; i < total_ticks; ++i) {
+        double bpm = scenario.bpm(beat);
+        double arrival = t_us + jitter(rng);
+        arrival = std::ceil(arrival / 1000.0) * 1000.0 + poll(rng);    // USB frame, then the poll loop
+        if (unit(rng) < scenario.burst_chance) {
+            held_back_until = arrival + 60.0e6 / (bpm * MidiClockTracker::TICKS_PER_BEAT);
+        }
+        arrival = std::max(arrival, held_back_until);
+
+        tracker.tick((uint64_t)arrival);
+        if (tracker.isLocked() && result.lock_beats < 0) result.lock_beats = beat;
+        if (!tracker.isLocked() && result.lock_beats >= 0) result.lost_lock = true;
+
+        if (tracker.isLocked() && beat >= scenario.settle_beats) {
+            double error = tracker.bpm() - bpm;
+            sum_sq += error * error;
+            result.max_bpm = std::max(result.max_bpm, std::fabs(error));
+            measured++;
+        }
+        if (verbose && i % MidiClockTracker::TICKS_PER_BEAT == 0) {
+            std::printf("  beat %6.1f  true %7.2f  estimate %7.2f  error %+6d us%s\n", beat, bpm, tracker.bpm(),
+                        tracker.lastErrorUs(), tracker.isLocked() ? "" : "  (acquiring)");
+        }
+
+        t_us += 60.0e6 / (bpm * MidiClockTracker::TICKS_PER_BEAT);
+        beat += 1.0 / MidiClockTracker::TICKS_PER_BEAT;
+    }
+    result.rms_bpm = measured ? std::sqrt(sum_sq / measured) : 0.0;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool verbose = argc > 1 && std::strcmp(argv[1], "--verbose") == 0;
+
+    const Scenario scenarios[] = {
+        {"steady_120", 64, [](double) { return 120.0; }, 300, 0.0, 4, 0.10, 0.30},
+        {"steady_174_jitter", 64, [](double) { return 174.0; }, 1500, 0.0, 4, 0.50, 1.50},
+        {"slow_70_bursts", 64, [](double) { return 70.0; }, 500, 0.02, 4, 0.15, 0.80},
+        {"ramp_100_140", 64, [](double b) { return b < 16 ? 100.0 : b < 48 ? 100.0 + (b - 16) * 40.0 / 32 : 140.0; },
+         500, 0.0, 4, 0.50, 1.00},
+        {"jump_90_150", 64, [](double b) { return b < 24 ? 90.0 : 150.0; }, 500, 0.0, 32, 0.20, 0.60, true},
+    };
+
+    int failures = 0;
+    for (const auto& scenario : scenarios) {
+        if (verbose) std::printf("%s:\n", scenario.name);
+        Result result = run(scenario, verbose);
+        bool ok = result.lock_beats >= 0 && result.lock_beats <= 2.0 && (!result.lost_lock || scenario.tempo_jumps) &&
+                  result.rms_bpm <= scenario.max_rms_bpm && result.max_bpm <= scenario.max_error_bpm;
+        std::printf("%-18s lock %.2f beats  rms %.3f BPM  max %.3f BPM%s  %s\n", scenario.name, result.lock_beats,
+                    result.rms_bpm, result.max_bpm, result.lost_lock ? "  lost lock" : "", ok ? "ok" : "FAILED");
+        if (!ok) failures++;
+    }
+    std::printf("%zu scenarios, %d failed\n", sizeof(scenarios) / sizeof(scenarios[0]), failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * ScreenRender.cpp - Golden images of every SynthScreen for regression checks
+ *
+ * Builds a SynthScreenManager against the SDK shim with fixed inputs (the
+ * default parameter values, a synthetic scope trace and capture, a fixed
+ * telemetry snapshot) and shows each SynthScreen in turn. Every frame goes
+ * from the OledDisplay framebuffer to the emulated SSD1306 over the same I2C
+ * DMA transfers as on the board, in virtual time, and the panel is compared
+ * pixel by pixel with a checked-in PBM, the format FirmwareHost --frames writes.
+ *
+ * Usage:
+ *   ScreenRender --list
+ *   ScreenRender --write <dir> [screen...]    store <dir>/<screen>.pbm
+ *   ScreenRender --check <dir> [screen...]
+ *
+ * The goldens for every screen are checked in under host/goldens/screens;
+ * regenerate them only in a commit that means to change what a screen shows.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+
+#include "AudioCapture.h"
+#include "EngineTelemetry.h"
+#include "ParameterStore.h"
+#include "SynthScreens.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int WIDTH = host_sdk::Ssd1306Model::WIDTH;
+constexpr int HEIGHT = host_sdk::Ssd1306Model::PAGES * 8;
+constexpr uint32_t FRAME_STEP_US = 5000;
+constexpr int SETTLE_FRAMES = 240;      // 1.2 s: past the MIDI rate window on PERFORMANCE
+
+struct ScreenCase {
+    const char* name;
+    SynthScreen screen;
+};
+
+const ScreenCase SCREENS[] = {
+    {"adsr", SynthScreen::ADSR},
+    {"mixer", SynthScreen::MIXER},
+    {"filter", SynthScreen::FILTER},
+    {"pwm", SynthScreen::PWM},
+    {"master", SynthScreen::MASTER},
+    {"waveform", SynthScreen::WAVEFORM},
+    {"spectrum", SynthScreen::SPECTRUM},
+    {"performance", SynthScreen::PERFORMANCE},
+    {"param_only", SynthScreen::PARAM_ONLY},
+};
+
+// Waits for the shim's engine thread to send every I2C byte due by now
+void waitForI2c() {
+    while (true) {
+        {
+            std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+            double now = (double)host_sdk::nowUs();
+            bool behind = false;
+            for (const auto& channel : host_sdk::g_devices.dma) {
+                behind |= channel.active && channel.dreq() == host_sdk::DREQ_I2C0_TX && channel.next_byte_us <= now;
+            }
+            if (!behind) return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+// Runs the Core 0 display loop in virtual time until every transfer has landed on the panel
+void settle(SynthScreenManager& screens, int frames = SETTLE_FRAMES) {
+    for (int i = 0; i < frames; ++i) {
+        screens.update();
+        host_sdk::advanceTime(FRAME_STEP_US);
+        waitForI2c();
+    }
+}
+
+// One period of a 16-sample saw; fills bins 8, 16, 24... of the 128-point spectrum
+void fillCapture() {
+    fix15 block[64 * 2];
+    for (int f = 0; f < 64; ++f) {
+        fix15 sample = ((f % 16) - 8) * (FIX15_ONE / 32);
+        block[f * 2] = block[f * 2 + 1] = sample;
+    }
+    auto view = choc::buffer::createInterleavedView(block, 2, 64);
+    while (!g_audio_capture.isReady()) g_audio_capture.captureBlock(view);
+}
+
+// A triangle for the scope, 32 samples per period
+void fillScope(SynthScreenManager& screens) {
+    int16_t samples[256];
+    for (int i = 0; i < 256; ++i) {
+        int phase = i % 32;
+        samples[i] = (int16_t)((phase < 16 ? phase : 32 - phase) * 1000 - 8000);
+    }
+    screens.feedAudioSamples(samples, 256);
+}
+
+// Two Core 1 blocks against a 64-frame budget: the peak is the first, the load the second
+void publishTelemetry() {
+    EngineTelemetrySnapshot& t = g_engine_telemetry.writer();
+    t.block_budget_us = 1451;
+    t.active_voices = 5;
+    t.xrun_count = 3;
+    t.midi_event_count += 24;
+    g_engine_telemetry.endBlock(1088);
+    g_engine_telemetry.endBlock(653);
+}
+
+void show(SynthScreenManager& screens, SynthScreen screen) {
+    // The home screen never times out, so each screen stays up while it settles
+    screens.setHomeScreen(screen);
+    switch (screen) {
+        case SynthScreen::WAVEFORM: fillScope(screens); break;
+        case SynthScreen::SPECTRUM: fillCapture(); break;
+        case SynthScreen::PERFORMANCE:
+            screens.update();       // Builds the page, which restarts the peak and MIDI rate
+            publishTelemetry();
+            break;
+        case SynthScreen::PARAM_ONLY: screens.showParameter("portamento", 0.25f); break;
+        default: break;
+    }
+    settle(screens);
+}
+
+std::vector<uint8_t> panelPixels() {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    std::vector<uint8_t> pixels(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) pixels[y * WIDTH + x] = host_sdk::g_devices.i2c.display.lit(x, y);
+    }
+    return pixels;
+}
+
+bool readPbm(const std::string& path, std::vector<uint8_t>& pixels) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    int width = 0, height = 0;
+    bool ok = std::fscanf(f, "P4 %d %d", &width, &height) == 2 && width == WIDTH && height == HEIGHT &&
+              std::fgetc(f) == '\n';
+    pixels.assign(WIDTH * HEIGHT, 0);
+    for (int y = 0; ok && y < HEIGHT; ++y) {
+        uint8_t row[WIDTH / 8];
+        ok = std::fread(row, 1, sizeof(row), f) == sizeof(row);
+        for (int x = 0; ok && x < WIDTH; ++x) pixels[y * WIDTH + x] = !(row[x / 8] & (0x80 >> (x % 8)));
+    }
+    std::fclose(f);
+    return ok;
+}
+
+bool compare(const std::vector<uint8_t>& pixels, const std::vector<uint8_t>& golden) {
+    int differing = 0;
+    int first = -1;
+    for (int i = 0; i < WIDTH * HEIGHT; ++i) {
+        if (pixels[i] == golden[i]) continue;
+        if (first < 0) first = i;
+        differing++;
+    }
+    if (differing) {
+        std::printf("  %d pixels differ, first at (%d, %d)\n", differing, first % WIDTH, first / WIDTH);
+    }
+    return differing == 0;
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr, "Usage: %s --list\n"
+                         "       %s --write <dir> [screen...]\n"
+                         "       %s --check <dir> [screen...]\n",
+                 program, program, program);
+    return 2;
+}
+
+int run(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+
+    std::string mode = argv[1];
+    if (mode == "--list") {
+        for (const auto& s : SCREENS) std::printf("%s\n", s.name);
+        return 0;
+    }
+    if ((mode != "--write" && mode != "--check") || argc < 3) return usage(argv[0]);
+
+    std::string dir = argv[2];
+    std::vector<const ScreenCase*> selected;
+    for (int i = 3; i < argc; ++i) {
+        const ScreenCase* found = nullptr;
+        for (const auto& s : SCREENS) {
+            if (std::strcmp(s.name, argv[i]) == 0) found = &s;
+        }
+        if (!found) {
+            std::fprintf(stderr, "Unknown screen %s (see --list)\n", argv[i]);
+            return 2;
+        }
+        selected.push_back(found);
+    }
+    if (selected.empty()) {
+        for (const auto& s : SCREENS) selected.push_back(&s);
+    }
+
+    initialize_parameters();
+    host_sdk::advanceTime(OledDisplay::POWER_UP_MS * 1000);    // OledDisplay::init() waits for it
+    SynthScreenManager screens;
+
+    int failures = 0;
+    for (const ScreenCase* s : selected) {
+        show(screens, s->screen);
+        std::string path = dir + "/" + s->name + ".pbm";
+        if (mode == "--write") {
+            std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+            if (!host_sdk::g_devices.i2c.display.writePbm(path.c_str())) {
+                std::fprintf(stderr, "  cannot write %s\n", path.c_str());
+                failures++;
+            }
+            continue;
+        }
+
+        std::vector<uint8_t> golden;
+        bool ok = readPbm(path, golden);
+        if (!ok) std::printf("  cannot read %s\n", path.c_str());
+        else ok = compare(panelPixels(), golden);
+        std::printf("%-12s %s\n", s->name, ok ? "ok" : "FAILED");
+        if (!ok) failures++;
+    }
+
+    if (mode == "--check") {
+        std::printf("%zu screens, %d failed\n", selected.size(), failures);
+    }
+    return failures ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int result = run(argc, argv);
+    std::fflush(stdout);
+    std::_Exit(result);     // The shim's DMA engine thread never returns
+}
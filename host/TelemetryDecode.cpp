@@ -0,0 +1,247 @@
+/**
+ * TelemetryDecode.cpp - Host decoder for Pico Synth telemetry frames
+ *
+ * Reads the synth's serial output (a live device or a capture recorded with
+ * e.g. `cat /dev/ttyACM0 > capture.txt`), picks out the TLM: lines and prints
+ * one decoded record per frame. Everything else on the link is ignored, so a
+ * capture can also contain LOG:/STATE: traffic.
+ *
+ * Usage: TelemetryDecode [--csv | --plot | --check expected.csv] [input]
+ *   input   capture file or serial device (stdin when omitted or "-")
+ *   --csv   one comma-separated row per frame, with a header
+ *   --plot  text bar graph of DSP load (current '#', peak '^')
+ *   --check decode to CSV and compare with expected.csv, whose last line is the
+ *           expected "# <summary>"; exits non-zero on the first difference
+ *
+ * Rates (MIDI events/s, parameter changes/s) are derived from consecutive
+ * frames; a summary of frame, checksum and sequence errors goes to stderr.
+ * host/captures/telemetry.txt is a recorded capture with one corrupted CRC,
+ * checked with --check host/captures/telemetry.csv.
+ */
+
+#include "TelemetryFrame.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class OutputMode { LOG, CSV, PLOT, CHECK };
+
+// Fix15VCAEnvelopeModule::State as one character: Idle, Attack, Decay, Sustain, Release, StealFade
+char voiceStateChar(uint8_t state) {
+    static constexpr char STATE_CHARS[] = "-ADSRF";
+    return state < sizeof(STATE_CHARS) - 1 ? STATE_CHARS[state] : '?';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Decodes the hex payload of a TLM: line, returns the number of bytes or -1
+int hexDecode(const std::string& hex, uint8_t* out, size_t capacity) {
+    if (hex.size() % 2 != 0 || hex.size() / 2 > capacity) return -1;
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        int hi = hexValue(hex[i]);
+        int lo = hexValue(hex[i + 1]);
+        if (hi < 0 || lo < 0) return -1;
+        out[i / 2] = (uint8_t)((hi << 4) | lo);
+    }
+    return (int)(hex.size() / 2);
+}
+
+int percentOfBudget(uint32_t us, uint32_t budget_us) {
+    return budget_us ? (int)(us * 100 / budget_us) : 0;
+}
+
+// Events per second between two cumulative counters
+double ratePerSecond(uint32_t count, uint32_t previous_count, uint32_t elapsed_ms) {
+    return elapsed_ms ? (double)(count - previous_count) * 1000.0 / elapsed_ms : 0.0;
+}
+
+std::string voiceString(const TelemetryFrame& frame) {
+    std::string voices;
+    for (int i = 0; i < frame.num_voices; ++i) voices += voiceStateChar(frame.voice_states[i]);
+    return voices;
+}
+
+std::string csvHeader() {
+    std::string header = "sequence,time_ms,block_count,block_us,peak_block_us,budget_us,load_pct,peak_pct,"
+                         "xruns,midi_per_s,params_per_s,midi_queue_peak";
+    for (int i = 0; i < TelemetryFrame::MAX_MODULES; ++i) header += ",module" + std::to_string(i) + "_us";
+    return header + ",voices";
+}
+
+std::string csvRow(const TelemetryFrame& frame, const TelemetryFrame* previous) {
+    uint32_t elapsed_ms = previous ? frame.timestamp_ms - previous->timestamp_ms : 0;
+    double midi_rate = previous ? ratePerSecond(frame.midi_event_count, previous->midi_event_count, elapsed_ms) : 0.0;
+    double param_rate = previous ? ratePerSecond(frame.param_change_count, previous->param_change_count, elapsed_ms) : 0.0;
+    char text[160];
+    std::snprintf(text, sizeof(text), "%u,%u,%u,%u,%u,%u,%d,%d,%u,%.1f,%.1f,%u",
+                  frame.sequence, frame.timestamp_ms, frame.block_count, frame.block_us,
+                  frame.peak_block_us, frame.block_budget_us,
+                  percentOfBudget(frame.block_us, frame.block_budget_us),
+                  percentOfBudget(frame.peak_block_us, frame.block_budget_us), frame.xrun_count,
+                  midi_rate, param_rate, frame.midi_queue_peak);
+    std::string row = text;
+    for (int i = 0; i < TelemetryFrame::MAX_MODULES; ++i) row += "," + std::to_string(frame.module_us[i]);
+    return row + "," + voiceString(frame);
+}
+
+void printFrame(OutputMode mode, const TelemetryFrame& frame, const TelemetryFrame* previous) {
+    uint32_t elapsed_ms = previous ? frame.timestamp_ms - previous->timestamp_ms : 0;
+    double midi_rate = previous ? ratePerSecond(frame.midi_event_count, previous->midi_event_count, elapsed_ms) : 0.0;
+    double param_rate = previous ? ratePerSecond(frame.param_change_count, previous->param_change_count, elapsed_ms) : 0.0;
+    uint32_t new_xruns = previous ? frame.xrun_count - previous->xrun_count : 0;
+    int load = percentOfBudget(frame.block_us, frame.block_budget_us);
+    int peak = percentOfBudget(frame.peak_block_us, frame.block_budget_us);
+
+    switch (mode) {
+        case OutputMode::CSV:
+            std::printf("%s\n", csvRow(frame, previous).c_str());
+            break;
+
+        case OutputMode::PLOT: {
+            // 50 columns = 100% of the block budget, anything beyond is clipped to the last column
+            static constexpr int WIDTH = 50;
+            char bar[WIDTH + 1];
+            int filled = load / 2 < WIDTH ? load / 2 : WIDTH;
+            int peak_col = peak / 2 < WIDTH ? peak / 2 : WIDTH - 1;
+            for (int i = 0; i < WIDTH; ++i) bar[i] = i < filled ? '#' : ' ';
+            bar[peak_col] = '^';
+            bar[WIDTH] = '\0';
+            std::printf("%9.3f |%s| %3d%% %s%s\n", frame.timestamp_ms / 1000.0, bar, load,
+                        voiceString(frame).c_str(), new_xruns ? " XRUN" : "");
+            break;
+        }
+
+        case OutputMode::CHECK:
+            break;
+
+        case OutputMode::LOG:
+            std::printf("t=%.3fs load=%d%% peak=%d%% xruns=%u(+%u) midi=%.1f/s params=%.1f/s queue=%u modules=[",
+                        frame.timestamp_ms / 1000.0, load, peak, frame.xrun_count, new_xruns,
+                        midi_rate, param_rate, frame.midi_queue_peak);
+            for (int i = 0; i < frame.num_modules; ++i) {
+                std::printf(i ? " %uus" : "%uus", frame.module_us[i]);
+            }
+            std::printf("] voices=%s\n", voiceString(frame).c_str());
+            break;
+    }
+}
+
+// Compares the decoded lines with the expected file and reports the first difference
+bool matchesExpected(const std::vector<std::string>& lines, const char* expected_path) {
+    std::ifstream expected_file(expected_path);
+    if (!expected_file) {
+        std::fprintf(stderr, "Cannot open %s\n", expected_path);
+        return false;
+    }
+    std::vector<std::string> expected;
+    std::string line;
+    while (std::getline(expected_file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        expected.push_back(line);
+    }
+    for (size_t i = 0; i < lines.size() || i < expected.size(); ++i) {
+        const char* got = i < lines.size() ? lines[i].c_str() : "(end of output)";
+        const char* want = i < expected.size() ? expected[i].c_str() : "(end of file)";
+        if (std::strcmp(got, want) == 0) continue;
+        std::printf("line %zu differs\n  expected: %s\n  decoded:  %s\n", i + 1, want, got);
+        return false;
+    }
+    std::printf("%zu lines match %s\n", lines.size(), expected_path);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    OutputMode mode = OutputMode::LOG;
+    const char* input_path = nullptr;
+    const char* expected_path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            mode = OutputMode::CSV;
+        } else if (std::strcmp(argv[i], "--plot") == 0) {
+            mode = OutputMode::PLOT;
+        } else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            mode = OutputMode::CHECK;
+            expected_path = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            std::fprintf(stderr, "Usage: %s [--csv | --plot | --check expected.csv] [capture-file | serial-device | -]\n", argv[0]);
+            return 2;
+        } else {
+            input_path = argv[i];
+        }
+    }
+
+    std::ifstream file;
+    if (input_path && std::strcmp(input_path, "-") != 0) {
+        file.open(input_path);
+        if (!file) {
+            std::fprintf(stderr, "Cannot open %s\n", input_path);
+            return 1;
+        }
+    }
+    std::istream& input = file.is_open() ? static_cast<std::istream&>(file) : std::cin;
+
+    if (mode == OutputMode::CSV) std::printf("%s\n", csvHeader().c_str());
+    std::vector<std::string> check_lines;
+    if (mode == OutputMode::CHECK) check_lines.push_back(csvHeader());
+
+    TelemetryFrame previous;
+    bool have_previous = false;
+    unsigned frames = 0, bad_frames = 0, missing_frames = 0;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t start = line.find("TLM:");
+        if (start == std::string::npos) continue;
+
+        uint8_t bytes[TelemetryFrame::ENCODED_SIZE];
+        int length = hexDecode(line.substr(start + 4), bytes, sizeof(bytes));
+        TelemetryFrame frame;
+        if (length < 0 || !frame.decode(bytes, (size_t)length)) {
+            bad_frames++;
+            continue;
+        }
+
+        // A device reset restarts the sequence at 0; don't count that as loss
+        if (have_previous && frame.sequence != 0) {
+            uint16_t gap = (uint16_t)(frame.sequence - previous.sequence);
+            if (gap > 1) missing_frames += gap - 1u;
+        }
+
+        const TelemetryFrame* rate_base = have_previous && frame.sequence != 0 ? &previous : nullptr;
+        if (mode == OutputMode::CHECK) {
+            check_lines.push_back(csvRow(frame, rate_base));
+        } else {
+            printFrame(mode, frame, rate_base);
+            std::fflush(stdout);
+        }
+        previous = frame;
+        have_previous = true;
+        frames++;
+    }
+
+    char summary[96];
+    std::snprintf(summary, sizeof(summary), "%u frames decoded, %u corrupt, %u missing", frames, bad_frames,
+                  missing_frames);
+    if (mode == OutputMode::CHECK) {
+        check_lines.push_back(std::string("# ") + summary);
+        return matchesExpected(check_lines, expected_path) ? 0 : 1;
+    }
+    std::fprintf(stderr, "%s\n", summary);
+    return bad_frames ? 1 : 0;
+}
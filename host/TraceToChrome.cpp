@@ -0,0 +1,145 @@
+/**
+ * TraceToChrome.cpp - Converts a TRACE_DUMP capture to Chrome trace JSON
+ *
+ * Reads the synth's serial output (device or recorded capture), takes the last
+ * TRACE_BEGIN..TRACE_END dump and writes a JSON trace loadable in
+ * chrome://tracing or ui.perfetto.dev. Each core becomes a thread; audio blocks
+ * are duration slices, every other event is an instant marker with its decoded
+ * payload as arguments.
+ *
+ * Usage: TraceToChrome [input] > trace.json
+ *   input   capture file or serial device (stdin when omitted or "-")
+ */
+
+#include "TraceEvent.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ParsedRecord {
+    unsigned core;
+    uint32_t timestamp;
+    uint32_t word;
+};
+
+// Decoded payload as JSON object members (without braces)
+std::string payloadArgs(uint8_t event, uint32_t payload) {
+    char args[96];
+    switch ((TraceEvent)event) {
+        case TraceEvent::BLOCK_START:
+        case TraceEvent::DMA_IRQ:
+            std::snprintf(args, sizeof(args), "\"buffer\":%u", (unsigned)payload);
+            break;
+        case TraceEvent::BLOCK_END:
+            std::snprintf(args, sizeof(args), "\"render_us\":%u", (unsigned)payload);
+            break;
+        case TraceEvent::MIDI_RECEIVE:
+        case TraceEvent::MIDI_APPLY:
+            std::snprintf(args, sizeof(args), "\"status\":\"0x%02X\",\"data1\":%u,\"data2\":%u",
+                          (unsigned)(payload >> 16) & 0xFF, (unsigned)(payload >> 8) & 0xFF, (unsigned)payload & 0xFF);
+            break;
+        case TraceEvent::VOICE_ALLOCATE:
+        case TraceEvent::VOICE_STEAL:
+            std::snprintf(args, sizeof(args), "\"voice\":%u,\"note\":%u",
+                          (unsigned)(payload >> 8) & 0xFFFF, (unsigned)payload & 0xFF);
+            break;
+        case TraceEvent::PARAM_SNAPSHOT:
+            std::snprintf(args, sizeof(args), "\"param_changes\":%u", (unsigned)payload);
+            break;
+        default:
+            std::snprintf(args, sizeof(args), "\"payload\":%u", (unsigned)payload);
+            break;
+    }
+    return args;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* input_path = argc > 1 ? argv[1] : nullptr;
+    if (argc > 2 || (input_path && input_path[0] == '-' && input_path[1] != '\0')) {
+        std::fprintf(stderr, "Usage: %s [capture-file | serial-device | -] > trace.json\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream file;
+    if (input_path && std::strcmp(input_path, "-") != 0) {
+        file.open(input_path);
+        if (!file) {
+            std::fprintf(stderr, "Cannot open %s\n", input_path);
+            return 1;
+        }
+    }
+    std::istream& input = file.is_open() ? static_cast<std::istream&>(file) : std::cin;
+
+    // Keep only the most recent complete dump
+    std::vector<ParsedRecord> records, current;
+    bool in_dump = false;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line == "TRACE_BEGIN") {
+            current.clear();
+            in_dump = true;
+        } else if (line == "TRACE_END") {
+            if (in_dump) records.swap(current);
+            in_dump = false;
+        } else if (in_dump) {
+            ParsedRecord r;
+            if (std::sscanf(line.c_str(), "TRC:%u:%" SCNx32 ":%" SCNx32, &r.core, &r.timestamp, &r.word) == 3) {
+                current.push_back(r);
+            }
+        }
+    }
+    if (records.empty()) {
+        std::fprintf(stderr, "No complete TRACE_BEGIN/TRACE_END dump found\n");
+        return 1;
+    }
+
+    // Timestamps are a wrapping 32-bit microsecond counter: measure relative to the earliest
+    int32_t earliest = 0;
+    for (const auto& r : records) {
+        int32_t offset = (int32_t)(r.timestamp - records[0].timestamp);
+        if (offset < earliest) earliest = offset;
+    }
+    uint32_t base = records[0].timestamp + (uint32_t)earliest;
+
+    std::printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Core 0 (control)\"}},\n");
+    std::printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Core 1 (audio)\"}}");
+
+    bool block_open[2] = {false, false};
+    for (const auto& r : records) {
+        uint8_t event = (uint8_t)(r.word >> 24);
+        uint32_t payload = r.word & 0xFFFFFF;
+        uint32_t ts = r.timestamp - base;
+        unsigned core = r.core & 1;
+
+        if ((TraceEvent)event == TraceEvent::BLOCK_START) {
+            std::printf(",\n{\"name\":\"Block\",\"ph\":\"B\",\"ts\":%u,\"pid\":0,\"tid\":%u,\"args\":{%s}}",
+                        ts, core, payloadArgs(event, payload).c_str());
+            block_open[core] = true;
+        } else if ((TraceEvent)event == TraceEvent::BLOCK_END) {
+            // The ring may start in the middle of a block; drop its unmatched end
+            if (!block_open[core]) continue;
+            std::printf(",\n{\"name\":\"Block\",\"ph\":\"E\",\"ts\":%u,\"pid\":0,\"tid\":%u,\"args\":{%s}}",
+                        ts, core, payloadArgs(event, payload).c_str());
+            block_open[core] = false;
+        } else {
+            std::printf(",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u,\"pid\":0,\"tid\":%u,\"args\":{%s}}",
+                        traceEventName(event), ts, core, payloadArgs(event, payload).c_str());
+        }
+    }
+    std::printf("\n]}\n");
+
+    std::fprintf(stderr, "%zu trace records converted\n", records.size());
+    return 0;
+}
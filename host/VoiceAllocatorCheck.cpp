@@ -0,0 +1,233 @@
+/**
+ * VoiceAllocatorCheck.cpp - Scripted note sequences against VoiceAllocator's policies
+ *
+ * Each case plays notes on a small voice pool and checks which voice every
+ * note-on gets or steals: oldest and quietest stealing, same-note retrigger
+ * against stacking, lowest/highest note protection and the per-part voice
+ * limit. The list order is checked through the same allocations: the free
+ * list hands out voices in the order they finished, and OLDEST steals
+ * releasing voices in note-off order, then held voices in note-on order (a
+ * stolen voice becomes the newest held one).
+ *
+ * Usage:
+ *   VoiceAllocatorCheck [--verbose]
+ *
+ * Prints one line per case and exits non-zero if any check fails.
+ */
+
+#include "VoiceAllocator.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+
+using Allocation = VoiceAllocator::Allocation;
+using Policy = VoiceAllocator::Policy;
+using StealMode = VoiceAllocator::StealMode;
+
+bool g_verbose = false;
+int g_case_failures = 0;
+
+void expect(bool condition, const char* what) {
+    if (condition) return;
+    g_case_failures++;
+    std::printf("  failed: %s\n", what);
+}
+
+// Envelope levels for QUIETEST, indexed by voice; zero unless a case sets them
+struct Levels {
+    int32_t level[VoiceAllocator::MAX_VOICES] = {};
+    int32_t operator()(int voice) const { return level[voice]; }
+};
+
+Allocation on(VoiceAllocator& allocator, uint8_t note, const Levels& levels = Levels{}, uint8_t group = 0,
+              uint8_t group_limit = 0) {
+    Allocation allocation = allocator.noteOn(VoiceAllocator::key(group, note), levels, group_limit);
+    if (g_verbose) {
+        std::printf("  on  %u/%3u -> voice %2d%s%s\n", group, note, allocation.voice,
+                    allocation.stolen ? " (stolen)" : "", allocation.retriggered ? " (retriggered)" : "");
+    }
+    return allocation;
+}
+
+int8_t off(VoiceAllocator& allocator, uint8_t note, uint8_t group = 0) {
+    int8_t voice = allocator.noteOff(VoiceAllocator::key(group, note));
+    if (g_verbose) std::printf("  off %u/%3u -> voice %2d\n", group, note, voice);
+    return voice;
+}
+
+Policy makePolicy(StealMode steal, bool retrigger = true, bool protect_lowest = false, bool protect_highest = false) {
+    Policy policy;
+    policy.steal = steal;
+    policy.retrigger_same_note = retrigger;
+    policy.protect_lowest = protect_lowest;
+    policy.protect_highest = protect_highest;
+    return policy;
+}
+
+void oldestSteal() {
+    VoiceAllocator allocator(4);
+    for (uint8_t note : {60, 62, 64, 65}) on(allocator, note);
+
+    Allocation a = on(allocator, 67);
+    expect(a.voice == 0 && a.stolen, "full pool steals the oldest held voice");
+    off(allocator, 64);
+    a = on(allocator, 69);
+    expect(a.voice == 2 && a.stolen, "a releasing voice is stolen before any held one");
+    a = on(allocator, 71);
+    expect(a.voice == 1, "then the oldest held voice again");
+    expect(allocator.getNumHeld() == 4 && allocator.getNumReleasing() == 0, "all four voices held");
+}
+
+void quietestSteal() {
+    VoiceAllocator allocator(4);
+    allocator.setPolicy(makePolicy(StealMode::QUIETEST));
+    Levels levels;
+    for (uint8_t note : {60, 62, 64, 65}) on(allocator, note);
+
+    levels.level[0] = 30000;
+    levels.level[1] = 12000;
+    levels.level[2] = 500;
+    levels.level[3] = 8000;
+    Allocation a = on(allocator, 67, levels);
+    expect(a.voice == 2 && a.stolen, "the quietest held voice is stolen");
+
+    levels.level[2] = 30000;
+    levels.level[1] = 8000;    // Ties with voice 3: voice 1 is older
+    a = on(allocator, 69, levels);
+    expect(a.voice == 1, "a tie goes to the older voice");
+
+    off(allocator, 60);        // Voice 0, still the loudest
+    a = on(allocator, 71, levels);
+    expect(a.voice == 0, "a releasing voice is stolen before quieter held ones");
+}
+
+void retriggerAndStack() {
+    VoiceAllocator allocator(4);
+    Allocation first = on(allocator, 60);
+    Allocation again = on(allocator, 60);
+    expect(again.voice == first.voice && again.retriggered && !again.stolen, "retrigger reuses the note's voice");
+    expect(allocator.getNumHeld() == 1 && allocator.getNumFree() == 3, "retrigger takes no second voice");
+
+    allocator.setPolicy(makePolicy(StealMode::OLDEST, false));
+    Allocation stacked = on(allocator, 60);
+    expect(stacked.voice != first.voice && !stacked.retriggered, "stack plays the repeat on a new voice");
+    expect(stacked.released == first.voice && allocator.isReleasing(first.voice), "stack releases the older voice");
+    expect(off(allocator, 60) == stacked.voice, "note-off releases the newest voice of the note");
+    expect(off(allocator, 60) == VoiceAllocator::NONE, "a second note-off finds nothing held");
+}
+
+void protectNotes() {
+    {
+        VoiceAllocator allocator(4);
+        allocator.setPolicy(makePolicy(StealMode::OLDEST, true, true, false));
+        for (uint8_t note : {36, 60, 64, 67}) on(allocator, note);
+        Allocation a = on(allocator, 72);
+        expect(a.voice == 1, "oldest: the lowest held note is kept");
+    }
+    {
+        VoiceAllocator allocator(4);
+        allocator.setPolicy(makePolicy(StealMode::OLDEST, true, false, true));
+        for (uint8_t note : {84, 60, 64, 67}) on(allocator, note);
+        Allocation a = on(allocator, 50);
+        expect(a.voice == 1, "oldest: the highest held note is kept");
+    }
+    {
+        VoiceAllocator allocator(4);
+        allocator.setPolicy(makePolicy(StealMode::QUIETEST, true, true, true));
+        Levels levels;
+        for (uint8_t note : {36, 96, 60, 64}) on(allocator, note);
+        levels.level[0] = 10;
+        levels.level[1] = 20;
+        levels.level[2] = 9000;
+        levels.level[3] = 8000;
+        Allocation a = on(allocator, 72, levels);
+        expect(a.voice == 3, "quietest: lowest and highest are skipped however quiet");
+        expect(allocator.lowestHeldNote() == 36 && allocator.highestHeldNote() == 96, "held note range");
+    }
+}
+
+void partVoiceLimit() {
+    VoiceAllocator allocator(8);
+    on(allocator, 48, Levels{}, 0);                     // Part 0, the oldest note
+    on(allocator, 60, Levels{}, 1, 2);
+    on(allocator, 62, Levels{}, 1, 2);
+    Allocation a = on(allocator, 64, Levels{}, 1, 2);
+    expect(a.voice == 1 && a.stolen, "a part at its limit steals its own oldest voice");
+    expect(allocator.getGroupVoices(1) == 2 && allocator.getGroupVoices(0) == 1, "per-part voice counts");
+    expect(allocator.getNumFree() == 5, "free voices are left alone while the part is at its limit");
+    expect(allocator.getKey(0) == VoiceAllocator::key(0, 48), "the other part's older note keeps its voice");
+
+    off(allocator, 64, 1);
+    allocator.voiceFinished(1);
+    a = on(allocator, 65, Levels{}, 1, 2);
+    expect(!a.stolen && allocator.getGroupVoices(1) == 2, "a finished voice frees room in its part");
+}
+
+void listOrder() {
+    VoiceAllocator allocator(4);
+    bool order_ok = true;
+    int8_t expected_on[] = {0, 1, 2, 3};
+    for (int i = 0; i < 4; ++i) order_ok &= on(allocator, (uint8_t)(60 + i)).voice == expected_on[i];
+    expect(order_ok, "free voices are handed out in index order");
+
+    // Each steal moves the victim to the newest end of the held list
+    order_ok = true;
+    int8_t expected_steals[] = {0, 1, 2, 3, 0, 1};
+    for (int i = 0; i < 6; ++i) order_ok &= on(allocator, (uint8_t)(70 + i)).voice == expected_steals[i];
+    expect(order_ok, "held voices are stolen in note-on order, stolen voices last");
+
+    // Held now: 2 (72), 3 (73), 0 (74), 1 (75). Release out of order.
+    off(allocator, 74);
+    off(allocator, 72);
+    off(allocator, 75);
+    order_ok = true;
+    int8_t expected_releasing[] = {0, 2, 1};
+    for (int i = 0; i < 3; ++i) order_ok &= on(allocator, (uint8_t)(80 + i)).voice == expected_releasing[i];
+    expect(order_ok, "releasing voices are stolen in note-off order");
+    expect(allocator.getNumHeld() == 4 && allocator.getNumReleasing() == 0, "every voice held again");
+
+    // Finished voices rejoin the free list in the order they finished
+    allocator.releaseAll([](int8_t) {});
+    for (int voice : {2, 0, 3, 1}) allocator.voiceFinished(voice);
+    order_ok = true;
+    int8_t expected_free[] = {2, 0, 3, 1};
+    for (int i = 0; i < 4; ++i) {
+        Allocation a = on(allocator, (uint8_t)(90 + i));
+        order_ok &= a.voice == expected_free[i] && !a.stolen;
+    }
+    expect(order_ok, "free voices are reused in the order they finished");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    g_verbose = argc > 1 && std::strcmp(argv[1], "--verbose") == 0;
+
+    struct Case {
+        const char* name;
+        void (*run)();
+    };
+    const Case cases[] = {
+        {"oldest_steal", oldestSteal},
+        {"quietest_steal", quietestSteal},
+        {"retrigger_stack", retriggerAndStack},
+        {"protect_notes", protectNotes},
+        {"part_voice_limit", partVoiceLimit},
+        {"list_order", listOrder},
+    };
+
+    int failures = 0;
+    for (const auto& c : cases) {
+        if (g_verbose) std::printf("%s:\n", c.name);
+        g_case_failures = 0;
+        c.run();
+        std::printf("%-18s %s\n", c.name, g_case_failures ? "FAILED" : "ok");
+        if (g_case_failures) failures++;
+    }
+    std::printf("%zu cases, %d failed\n", sizeof(cases) / sizeof(cases[0]), failures);
+    return failures ? 1 : 0;
+}
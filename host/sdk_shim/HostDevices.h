@@ -0,0 +1,347 @@
+/**
+ * HostDevices.h - DMA, PIO, I2C and interrupt models behind the host SDK shim
+ *
+ * Just enough peripheral behaviour for the firmware's drivers to run unmodified
+ * in a Linux process (FirmwareHost.cpp). An engine thread moves data for every
+ * busy DMA channel at the rate its DREQ allows, in emulated time (HostSdk.h):
+ * - PIO TX: an enabled state machine takes one word from its TX FIFO every
+ *   PIO_CYCLES_PER_WORD cycles of its divided clock, like audio_i2s.pio. Words
+ *   go to g_pio_sink; an empty FIFO once streaming has started is a stall.
+ * - I2C TX: bytes leave at the i2c_init baud rate, 9 bit times each, into an
+ *   SSD1306 model that keeps the display RAM for snapshots.
+ * A finished transfer raises DMA_IRQ_0: the registered handler runs on the
+ * engine thread, which takes the core number of whoever enabled the IRQ.
+ * i2c_write_blocking sleeps for the bus time, so display writes stall Core 0
+ * just as long as on the board.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "HostSdk.h"
+
+namespace host_sdk {
+
+constexpr unsigned NUM_DMA_CHANNELS = 12;
+constexpr unsigned NUM_PIO_SM = 4;
+constexpr unsigned NUM_IRQS = 32;
+
+// RP2040 DREQ numbers
+constexpr unsigned DREQ_PIO0_TX0 = 0;
+constexpr unsigned DREQ_PIO0_RX0 = 4;
+constexpr unsigned DREQ_I2C0_TX = 32;
+constexpr unsigned DREQ_I2C0_RX = 33;
+constexpr unsigned DREQ_FORCE = 0x3f;
+
+constexpr unsigned IRQ_DMA_0 = 11;
+
+constexpr uint32_t PIO_CYCLES_PER_WORD = 64;    // audio_i2s.pio: 2 cycles per bit, 32 bits
+constexpr unsigned PIO_FIFO_DEPTH = 4;          // Per direction; 8 when joined
+
+// dma_channel_config.ctrl layout (same fields as the RP2040 CTRL register, packed differently)
+constexpr uint32_t DMA_CTRL_SIZE_MASK = 0x3;
+constexpr uint32_t DMA_CTRL_INCR_READ = 1u << 2;
+constexpr uint32_t DMA_CTRL_INCR_WRITE = 1u << 3;
+constexpr unsigned DMA_CTRL_DREQ_SHIFT = 8;
+
+struct DmaRegisters {
+    volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+};
+
+struct DmaChannel {
+    bool claimed = false;
+    bool active = false;
+    bool irq0 = false;
+    uint32_t ctrl = 0;
+    const uint8_t* read = nullptr;
+    volatile uint8_t* write = nullptr;
+    uint32_t reload_count = 0;      // TRANS_COUNT a retrigger starts from
+    double next_byte_us = 0;        // I2C pacing
+    DmaRegisters regs{};            // What dma_channel_hw_addr() shows (transfer_count is live)
+
+    unsigned dreq() const { return (ctrl >> DMA_CTRL_DREQ_SHIFT) & 0x3f; }
+    unsigned size() const { return 1u << (ctrl & DMA_CTRL_SIZE_MASK); }
+};
+
+struct PioStateMachine {
+    bool claimed = false;
+    bool enabled = false;
+    bool joined = false;
+    bool started = false;           // Has had a word; an empty FIFO before that is just idle
+    float clkdiv = 1.0f;
+    uint32_t fifo[2 * PIO_FIFO_DEPTH] = {};
+    unsigned head = 0, level = 0;
+    double next_pull_us = 0;
+
+    unsigned depth() const { return joined ? 2 * PIO_FIFO_DEPTH : PIO_FIFO_DEPTH; }
+};
+
+// 128x64 SSD1306 fed with I2C transactions: control byte, then commands or GDDRAM data
+class Ssd1306Model {
+public:
+    static constexpr int WIDTH = 128;
+    static constexpr int PAGES = 8;
+
+    void beginTransaction() { expect_control = true; }
+
+    void write(uint8_t byte) {
+        if (expect_control) {
+            control = byte;
+            expect_control = false;
+            return;
+        }
+        if (control & 0x40) writeData(byte);
+        else writeCommand(byte);
+        if (control & 0x80) expect_control = true;  // Co bit: a control byte follows every byte
+    }
+
+    // Bit y%8 of ram[y/8][x] is pixel (x, y), before the panel's remap and scan direction
+    uint8_t ram[PAGES][WIDTH] = {};
+    bool display_on = false;
+    bool inverted = false;
+    uint64_t generation = 0;        // Bumped by every data write or display-mode change
+
+    // What the panel shows at (x, y), before the remap
+    bool lit(int x, int y) const { return display_on && (((ram[y / 8][x] >> (y % 8)) & 1) != inverted); }
+
+    // Binary PBM (1 = black, so lit pixels are written as 0)
+    bool writePbm(const char* path) const {
+        FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+        std::fprintf(f, "P4\n%d %d\n", WIDTH, PAGES * 8);
+        for (int y = 0; y < PAGES * 8; ++y) {
+            uint8_t row[WIDTH / 8] = {};
+            for (int x = 0; x < WIDTH; ++x) {
+                if (!lit(x, y)) row[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+            }
+            std::fwrite(row, 1, sizeof(row), f);
+        }
+        return std::fclose(f) == 0;
+    }
+
+private:
+    static int argCount(uint8_t cmd) {
+        switch (cmd) {
+            case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+                return 1;
+            case 0x21: case 0x22: case 0xA3:
+                return 2;
+            case 0x29: case 0x2A:
+                return 5;
+            case 0x26: case 0x27:
+                return 6;
+            default:
+                return 0;
+        }
+    }
+
+    void writeCommand(uint8_t byte) {
+        if (args_left) {
+            args[args_seen++] = byte;
+            if (--args_left == 0) apply();
+            return;
+        }
+        command = byte;
+        args_seen = 0;
+        args_left = argCount(byte);
+        if (!args_left) apply();
+    }
+
+    void apply() {
+        switch (command) {
+            case 0x20: mode = args[0] & 3; return;
+            case 0x21: col_start = col = args[0] & 0x7F; col_end = args[1] & 0x7F; return;
+            case 0x22: page_start = page = args[0] & 7; page_end = args[1] & 7; return;
+            case 0xAE: case 0xAF: display_on = command & 1; generation++; return;
+            case 0xA6: case 0xA7: inverted = command & 1; generation++; return;
+            default: break;
+        }
+        if (mode == 2) {    // Page addressing mode positioning
+            if (command >= 0xB0 && command <= 0xB7) page = command & 7;
+            else if (command <= 0x0F) col = (col & 0xF0) | command;
+            else if (command <= 0x1F) col = (col & 0x0F) | ((command & 0x0F) << 4);
+        }
+    }
+
+    void writeData(uint8_t byte) {
+        ram[page][col] = byte;
+        generation++;
+        if (mode == 0) {            // Horizontal: across the column window, then down a page
+            if (++col > col_end) {
+                col = col_start;
+                if (++page > page_end) page = page_start;
+            }
+        } else if (mode == 1) {     // Vertical: down the page window, then across a column
+            if (++page > page_end) {
+                page = page_start;
+                if (++col > col_end) col = col_start;
+            }
+        } else if (++col >= WIDTH) {
+            col = 0;
+        }
+    }
+
+    bool expect_control = true;
+    uint8_t control = 0;
+    uint8_t command = 0;
+    uint8_t args[6] = {};
+    int args_seen = 0, args_left = 0;
+    int mode = 2;                   // Power-on default is page addressing
+    int col = 0, col_start = 0, col_end = WIDTH - 1;
+    int page = 0, page_start = 0, page_end = PAGES - 1;
+};
+
+struct I2cBus {
+    uint32_t baud = 100000;
+    Ssd1306Model display;           // The only device on the bus
+    uint64_t bytes = 0;
+    double busy_us = 0;             // Bus time of every transfer so far
+    uint64_t dma_transfers = 0;
+    uint64_t blocking_writes = 0;
+
+    double byteUs() const { return 9e6 / baud; }
+};
+
+struct Devices {
+    std::recursive_mutex mutex;     // The IRQ handler re-enters the DMA API from the engine thread
+    DmaChannel dma[NUM_DMA_CHANNELS];
+    PioStateMachine pio_sm[NUM_PIO_SM];
+    I2cBus i2c;
+    uint32_t sys_clock_hz = 125000000;
+    void (*irq_handlers[NUM_IRQS])() = {};
+    bool irq_enabled[NUM_IRQS] = {};
+    unsigned irq_core[NUM_IRQS] = {};
+    uint32_t dma_ints0 = 0;
+    uint64_t pio_words = 0;
+    uint64_t pio_stalls = 0;
+    bool engine_running = false;
+};
+
+inline Devices g_devices;
+
+// Receives every word a PIO state machine shifts out (and a 0 for each stall); runs on the engine thread
+inline std::function<void(unsigned sm, uint32_t word)> g_pio_sink;
+
+inline void raiseDmaIrq(unsigned ch) {
+    Devices& d = g_devices;
+    if (!d.dma[ch].irq0) return;
+    d.dma_ints0 |= 1u << ch;
+    if (d.irq_enabled[IRQ_DMA_0] && d.irq_handlers[IRQ_DMA_0]) {
+        setCurrentCore(d.irq_core[IRQ_DMA_0]);
+        d.irq_handlers[IRQ_DMA_0]();
+    }
+}
+
+inline void finishDma(unsigned ch) {
+    g_devices.dma[ch].active = false;
+    raiseDmaIrq(ch);
+}
+
+// Refills a state machine's FIFO from the channel paced by its TX DREQ
+inline void feedPio(unsigned sm) {
+    Devices& d = g_devices;
+    PioStateMachine& state = d.pio_sm[sm];
+    for (unsigned ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+        DmaChannel& c = d.dma[ch];
+        while (c.active && c.dreq() == DREQ_PIO0_TX0 + sm && state.level < state.depth()) {
+            uint32_t word = 0;
+            std::memcpy(&word, c.read, c.size());
+            if (c.ctrl & DMA_CTRL_INCR_READ) c.read += c.size();
+            state.fifo[(state.head + state.level) % state.depth()] = word;
+            state.level++;
+            if (--c.regs.transfer_count == 0) finishDma(ch);
+        }
+    }
+}
+
+inline void servicePio(uint64_t now) {
+    Devices& d = g_devices;
+    for (unsigned sm = 0; sm < NUM_PIO_SM; ++sm) {
+        PioStateMachine& state = d.pio_sm[sm];
+        if (!state.enabled) continue;
+        double period_us = 1e6 * state.clkdiv * PIO_CYCLES_PER_WORD / d.sys_clock_hz;
+        feedPio(sm);
+        if (!state.started) {
+            if (!state.level) continue;
+            state.started = true;
+            state.next_pull_us = (double)now;
+        }
+        while (state.next_pull_us <= (double)now) {
+            uint32_t word = 0;
+            if (state.level) {
+                word = state.fifo[state.head];
+                state.head = (state.head + 1) % state.depth();
+                state.level--;
+                d.pio_words++;
+            } else {
+                d.pio_stalls++;
+            }
+            if (g_pio_sink) g_pio_sink(sm, word);
+            state.next_pull_us += period_us;
+            feedPio(sm);
+        }
+    }
+}
+
+inline void serviceDma(uint64_t now) {
+    Devices& d = g_devices;
+    for (unsigned ch = 0; ch < NUM_DMA_CHANNELS; ++ch) {
+        DmaChannel& c = d.dma[ch];
+        if (!c.active) continue;
+        if (c.dreq() == DREQ_I2C0_TX) {
+            while (c.active && c.next_byte_us <= (double)now) {
+                d.i2c.display.write(*c.read);
+                if (c.ctrl & DMA_CTRL_INCR_READ) c.read += c.size();
+                c.next_byte_us += d.i2c.byteUs();
+                d.i2c.bytes++;
+                d.i2c.busy_us += d.i2c.byteUs();
+                if (--c.regs.transfer_count == 0) finishDma(ch);
+            }
+        } else if (c.dreq() == DREQ_FORCE) {
+            // Unpaced memory copy, done in one go
+            while (c.active) {
+                std::memcpy((void*)c.write, c.read, c.size());
+                if (c.ctrl & DMA_CTRL_INCR_READ) c.read += c.size();
+                if (c.ctrl & DMA_CTRL_INCR_WRITE) c.write += c.size();
+                if (--c.regs.transfer_count == 0) finishDma(ch);
+            }
+        }
+    }
+}
+
+inline void startEngine() {
+    if (g_devices.engine_running) return;
+    g_devices.engine_running = true;
+    std::thread([] {
+        while (true) {
+            {
+                std::lock_guard<std::recursive_mutex> lock(g_devices.mutex);
+                uint64_t now = nowUs();
+                servicePio(now);
+                serviceDma(now);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }).detach();
+}
+
+// Called with the mutex held
+inline void startDma(unsigned ch) {
+    DmaChannel& c = g_devices.dma[ch];
+    c.active = c.regs.transfer_count > 0;
+    if (!c.active) return;
+    if (c.dreq() == DREQ_I2C0_TX) {
+        g_devices.i2c.display.beginTransaction();
+        g_devices.i2c.dma_transfers++;
+        c.next_byte_us = (double)nowUs() + g_devices.i2c.byteUs();     // Address byte first
+        g_devices.i2c.busy_us += g_devices.i2c.byteUs();
+    }
+    startEngine();
+}
+
+}  // namespace host_sdk
@@ -0,0 +1,155 @@
+/**
+ * HostSdk.h - State behind the host Pico SDK shim
+ *
+ * Lets the synth's headers compile and run natively for host tools. By default
+ * time is a virtual microsecond counter that the tool advances explicitly, so
+ * renders are repeatable. useRealTime() switches to scaled wall-clock time for
+ * running the whole firmware (FirmwareHost.cpp): sleeps really sleep and the
+ * peripheral models in HostDevices.h pace themselves against the same clock.
+ *
+ * Each emulated core has an inbound FIFO; the calling thread's core number
+ * decides which FIFO multicore_fifo_pop reads and which one push writes.
+ */
+
+#pragma once
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace host_sdk {
+
+// RP2040 inter-core FIFO depth (pushes beyond this block or time out like on hardware)
+constexpr size_t FIFO_DEPTH = 8;
+
+// Fixed ring, so emulated cores never allocate through the shim (HeapGuard.h). Only
+// fifoInject() fills it beyond FIFO_DEPTH.
+struct CoreFifo {
+    static constexpr size_t CAPACITY = 4096;
+
+    std::mutex mutex;
+    uint32_t entries[CAPACITY];
+    size_t head = 0;
+    size_t count = 0;
+
+    void push(uint32_t value) {
+        if (count == CAPACITY) {
+            std::fprintf(stderr, "Host FIFO overflow (%zu entries)\n", CAPACITY);
+            std::abort();
+        }
+        entries[(head + count++) % CAPACITY] = value;
+    }
+    uint32_t pop() {
+        uint32_t value = entries[head];
+        head = (head + 1) % CAPACITY;
+        count--;
+        return value;
+    }
+};
+
+// Back-pressure counters per FIFO, for load reports
+struct FifoStats {
+    std::atomic<uint64_t> pushes{0};
+    std::atomic<uint64_t> blocked{0};   // push_blocking calls that found the FIFO full
+    std::atomic<uint64_t> dropped{0};   // push_timeout_us calls that gave up
+    std::atomic<uint32_t> peak{0};      // Deepest occupancy seen
+};
+
+inline std::atomic<uint64_t> g_time_us{0};
+inline thread_local unsigned g_current_core = 0;
+inline CoreFifo g_fifos[2];        // Indexed by the receiving core
+inline FifoStats g_fifo_stats[2];  // Indexed by the receiving core
+
+// Real-time mode: emulated time = g_time_us + wall time since useRealTime() * g_time_scale
+inline std::atomic<bool> g_real_time{false};
+inline double g_time_scale = 1.0;
+inline std::chrono::steady_clock::time_point g_wall_start;
+
+// Serial port behind getchar_timeout_us (USB CDC on the Pico); -1 = nothing attached
+inline std::atomic<int> g_serial_fd{-1};
+
+inline void advanceTime(uint64_t us) { g_time_us += us; }
+inline void setCurrentCore(unsigned core) { g_current_core = core & 1; }
+
+// Call before starting any emulated core; scale > 1 runs emulated time faster than the wall clock
+inline void useRealTime(double scale) {
+    g_time_scale = scale;
+    g_wall_start = std::chrono::steady_clock::now();
+    g_real_time = true;
+}
+
+inline uint64_t nowUs() {
+    if (!g_real_time) return g_time_us.load();
+    std::chrono::duration<double, std::micro> wall = std::chrono::steady_clock::now() - g_wall_start;
+    return g_time_us.load() + (uint64_t)(wall.count() * g_time_scale);
+}
+
+inline void sleepUs(uint64_t us) {
+    if (!g_real_time) {
+        advanceTime(us);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(us / g_time_scale));
+}
+
+// Next byte from the serial port, or -1 after timeout_us of emulated time
+inline int serialGetchar(uint64_t timeout_us) {
+    int fd = g_serial_fd;
+    int wait_ms = 0;
+    if (g_real_time && timeout_us) wait_ms = (int)(timeout_us / g_time_scale / 1000.0) + 1;
+    if (fd >= 0) {
+        pollfd p{fd, POLLIN, 0};
+        if (poll(&p, 1, wait_ms) > 0) {
+            unsigned char c;
+            ssize_t n = read(fd, &c, 1);
+            if (n == 1) return c;
+            if (n == 0) g_serial_fd = -1;   // End of input: behave like an unplugged cable
+        }
+        return -1;
+    }
+    sleepUs(timeout_us);
+    return -1;
+}
+
+// Queues a packet for a core regardless of depth (tools feeding scripted events)
+inline void fifoInject(unsigned core, uint32_t value) {
+    std::lock_guard<std::mutex> lock(g_fifos[core & 1].mutex);
+    g_fifos[core & 1].push(value);
+}
+
+inline bool fifoTryPush(unsigned core, uint32_t value) {
+    std::lock_guard<std::mutex> lock(g_fifos[core & 1].mutex);
+    CoreFifo& fifo = g_fifos[core & 1];
+    if (fifo.count >= FIFO_DEPTH) return false;
+    fifo.push(value);
+    FifoStats& stats = g_fifo_stats[core & 1];
+    stats.pushes++;
+    if (fifo.count > stats.peak) stats.peak = (uint32_t)fifo.count;
+    return true;
+}
+
+inline bool fifoTryPop(unsigned core, uint32_t& value) {
+    std::lock_guard<std::mutex> lock(g_fifos[core & 1].mutex);
+    if (g_fifos[core & 1].count == 0) return false;
+    value = g_fifos[core & 1].pop();
+    return true;
+}
+
+inline size_t fifoSize(unsigned core) {
+    std::lock_guard<std::mutex> lock(g_fifos[core & 1].mutex);
+    return g_fifos[core & 1].count;
+}
+
+inline void fifoClear(unsigned core) {
+    std::lock_guard<std::mutex> lock(g_fifos[core & 1].mutex);
+    g_fifos[core & 1].count = 0;
+}
+
+}  // namespace host_sdk
@@ -0,0 +1,13 @@
+// Host stand-in for the pioasm output of audio_i2s.pio. The program itself is not run:
+// the PIO model in HostDevices.h shifts out one word per PIO_CYCLES_PER_WORD cycles like it.
+#pragma once
+
+#include "hardware/pio.h"
+
+#define audio_i2s_offset_entry_point 7u
+
+static const pio_program_t audio_i2s_program = {nullptr, 0, -1};
+
+static inline pio_sm_config audio_i2s_program_get_default_config(uint) {
+    return pio_get_default_sm_config();
+}
@@ -0,0 +1,16 @@
+// Host shim for hardware/clocks.h - only clk_sys has a frequency (it paces the PIO model)
+#pragma once
+
+#include "pico/stdlib.h"
+#include "HostDevices.h"
+
+enum clock_index { clk_gpout0 = 0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc };
+
+inline uint32_t clock_get_hz(clock_index clk) {
+    return clk == clk_sys ? host_sdk::g_devices.sys_clock_hz : 0;
+}
+
+inline bool set_sys_clock_khz(uint32_t khz, bool) {
+    host_sdk::g_devices.sys_clock_hz = khz * 1000;
+    return true;
+}
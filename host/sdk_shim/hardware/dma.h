@@ -0,0 +1,105 @@
+// Host shim for hardware/dma.h - channels are serviced by the engine in HostDevices.h
+#pragma once
+
+#include "pico/stdlib.h"
+#include "HostDevices.h"
+
+typedef struct { uint32_t ctrl; } dma_channel_config;
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef host_sdk::DmaRegisters dma_channel_hw_t;
+struct dma_hw_t {
+    struct WriteOneToClear {
+        WriteOneToClear& operator=(uint32_t bits) {
+            std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+            host_sdk::g_devices.dma_ints0 &= ~bits;
+            return *this;
+        }
+        operator uint32_t() const { return host_sdk::g_devices.dma_ints0; }
+    } ints0;
+};
+inline dma_hw_t g_host_dma_hw;
+#define dma_hw (&g_host_dma_hw)
+
+inline int dma_claim_unused_channel(bool required) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    for (unsigned ch = 0; ch < host_sdk::NUM_DMA_CHANNELS; ++ch) {
+        if (!host_sdk::g_devices.dma[ch].claimed) {
+            host_sdk::g_devices.dma[ch].claimed = true;
+            return (int)ch;
+        }
+    }
+    if (required) panic("No DMA channels are available");
+    return -1;
+}
+
+inline dma_channel_config dma_channel_get_default_config(uint) {
+    return {DMA_SIZE_32 | host_sdk::DMA_CTRL_INCR_READ | (host_sdk::DREQ_FORCE << host_sdk::DMA_CTRL_DREQ_SHIFT)};
+}
+
+inline void channel_config_set_transfer_data_size(dma_channel_config* c, dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~host_sdk::DMA_CTRL_SIZE_MASK) | size;
+}
+
+inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    c->ctrl = incr ? (c->ctrl | host_sdk::DMA_CTRL_INCR_READ) : (c->ctrl & ~host_sdk::DMA_CTRL_INCR_READ);
+}
+
+inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    c->ctrl = incr ? (c->ctrl | host_sdk::DMA_CTRL_INCR_WRITE) : (c->ctrl & ~host_sdk::DMA_CTRL_INCR_WRITE);
+}
+
+inline void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+    c->ctrl = (c->ctrl & ~(0x3fu << host_sdk::DMA_CTRL_DREQ_SHIFT)) | ((dreq & 0x3f) << host_sdk::DMA_CTRL_DREQ_SHIFT);
+}
+
+inline void dma_channel_set_read_addr(uint ch, const volatile void* read_addr, bool trigger) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::DmaChannel& c = host_sdk::g_devices.dma[ch];
+    c.read = (const uint8_t*)read_addr;
+    if (trigger) {
+        c.regs.transfer_count = c.reload_count;
+        host_sdk::startDma(ch);
+    }
+}
+
+inline void dma_channel_set_trans_count(uint ch, uint32_t count, bool trigger) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::DmaChannel& c = host_sdk::g_devices.dma[ch];
+    c.reload_count = count;
+    c.regs.transfer_count = count;
+    if (trigger) host_sdk::startDma(ch);
+}
+
+inline void dma_channel_configure(uint ch, const dma_channel_config* config, volatile void* write_addr,
+                                  const volatile void* read_addr, uint count, bool trigger) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::DmaChannel& c = host_sdk::g_devices.dma[ch];
+    c.ctrl = config->ctrl;
+    c.write = (volatile uint8_t*)write_addr;
+    c.read = (const uint8_t*)read_addr;
+    c.reload_count = count;
+    c.regs.transfer_count = count;
+    if (trigger) host_sdk::startDma(ch);
+}
+
+inline void dma_channel_transfer_from_buffer_now(uint ch, const volatile void* read_addr, uint32_t count) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::DmaChannel& c = host_sdk::g_devices.dma[ch];
+    c.read = (const uint8_t*)read_addr;
+    c.reload_count = count;
+    c.regs.transfer_count = count;
+    host_sdk::startDma(ch);
+}
+
+inline bool dma_channel_is_busy(uint ch) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    return host_sdk::g_devices.dma[ch].active;
+}
+
+inline void dma_channel_set_irq0_enabled(uint ch, bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::g_devices.dma[ch].irq0 = enabled;
+}
+
+inline dma_channel_hw_t* dma_channel_hw_addr(uint ch) { return &host_sdk::g_devices.dma[ch].regs; }
@@ -0,0 +1,42 @@
+// Host shim for hardware/i2c.h - i2c0 talks to the SSD1306 model in HostDevices.h
+#pragma once
+
+#include "pico/stdlib.h"
+#include "HostDevices.h"
+
+struct i2c_hw_t {
+    volatile uint32_t data_cmd;     // Stand-in DMA target; transfers are paced by DREQ_I2C0_TX
+};
+struct i2c_inst_t {
+    i2c_hw_t* hw;
+};
+inline i2c_hw_t g_host_i2c0_hw;
+inline i2c_inst_t g_host_i2c0_inst{&g_host_i2c0_hw};
+#define i2c0 (&g_host_i2c0_inst)
+
+inline uint i2c_init(i2c_inst_t*, uint baudrate) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::g_devices.i2c.baud = baudrate;
+    return baudrate;
+}
+
+inline uint i2c_get_dreq(i2c_inst_t*, bool is_tx) {
+    return is_tx ? host_sdk::DREQ_I2C0_TX : host_sdk::DREQ_I2C0_RX;
+}
+
+// Delivers the bytes at once, then holds the caller for the bus time (address byte included)
+inline int i2c_write_blocking(i2c_inst_t*, uint8_t, const uint8_t* src, size_t len, bool) {
+    double bus_us;
+    {
+        std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+        host_sdk::I2cBus& bus = host_sdk::g_devices.i2c;
+        bus.display.beginTransaction();
+        for (size_t i = 0; i < len; ++i) bus.display.write(src[i]);
+        bus_us = (double)(len + 1) * bus.byteUs();
+        bus.bytes += len;
+        bus.busy_us += bus_us;
+        bus.blocking_writes++;
+    }
+    host_sdk::sleepUs((uint64_t)bus_us);
+    return (int)len;
+}
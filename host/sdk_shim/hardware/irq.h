@@ -0,0 +1,21 @@
+// Host shim for hardware/irq.h - handlers run on the HostDevices.h engine thread
+#pragma once
+
+#include "pico/stdlib.h"
+#include "HostDevices.h"
+
+typedef void (*irq_handler_t)();
+
+#define DMA_IRQ_0 host_sdk::IRQ_DMA_0
+
+inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::g_devices.irq_handlers[num] = handler;
+}
+
+// Like NVIC enables, an IRQ belongs to the core that enabled it
+inline void irq_set_enabled(uint num, bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::g_devices.irq_enabled[num] = enabled;
+    host_sdk::g_devices.irq_core[num] = get_core_num();
+}
@@ -0,0 +1,76 @@
+// Host shim for hardware/pio.h - state machines drain their TX FIFO in HostDevices.h
+#pragma once
+
+#include "pico/stdlib.h"
+#include "HostDevices.h"
+
+struct pio_hw_t {
+    volatile uint32_t txf[host_sdk::NUM_PIO_SM];    // Stand-in addresses; DMA pacing goes by DREQ
+};
+typedef pio_hw_t* PIO;
+inline pio_hw_t g_host_pio0_hw;
+#define pio0 (&g_host_pio0_hw)
+
+typedef struct {
+    const uint16_t* instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+typedef struct {
+    float clkdiv;
+    bool join_tx;
+} pio_sm_config;
+
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+
+inline pio_sm_config pio_get_default_sm_config() { return {1.0f, false}; }
+
+inline uint pio_claim_unused_sm(PIO, bool required) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    for (unsigned sm = 0; sm < host_sdk::NUM_PIO_SM; ++sm) {
+        if (!host_sdk::g_devices.pio_sm[sm].claimed) {
+            host_sdk::g_devices.pio_sm[sm].claimed = true;
+            return sm;
+        }
+    }
+    if (required) panic("No PIO state machines are available");
+    return (uint)-1;
+}
+
+// Programs are not executed; the state machine model stands in for audio_i2s.pio
+inline uint pio_add_program(PIO, const pio_program_t*) { return 0; }
+
+inline void sm_config_set_out_pins(pio_sm_config*, uint, uint) {}
+inline void sm_config_set_sideset_pins(pio_sm_config*, uint) {}
+inline void sm_config_set_out_shift(pio_sm_config*, bool, bool, uint) {}
+inline void sm_config_set_fifo_join(pio_sm_config* c, pio_fifo_join join) { c->join_tx = join == PIO_FIFO_JOIN_TX; }
+inline void sm_config_set_clkdiv(pio_sm_config* c, float div) { c->clkdiv = div; }
+
+inline void pio_sm_init(PIO, uint sm, uint, const pio_sm_config* config) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::PioStateMachine& state = host_sdk::g_devices.pio_sm[sm];
+    state.clkdiv = config->clkdiv;
+    state.joined = config->join_tx;
+    state.enabled = false;
+    state.started = false;
+    state.head = state.level = 0;
+}
+
+inline void pio_gpio_init(PIO, uint) {}
+inline void pio_sm_set_consecutive_pindirs(PIO, uint, uint, uint, bool) {}
+
+inline uint pio_get_dreq(PIO, uint sm, bool is_tx) {
+    return (is_tx ? host_sdk::DREQ_PIO0_TX0 : host_sdk::DREQ_PIO0_RX0) + sm;
+}
+
+inline void pio_sm_set_enabled(PIO, uint sm, bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    host_sdk::g_devices.pio_sm[sm].enabled = enabled;
+    if (enabled) host_sdk::startEngine();
+}
+
+inline uint pio_sm_get_tx_fifo_level(PIO, uint sm) {
+    std::lock_guard<std::recursive_mutex> lock(host_sdk::g_devices.mutex);
+    return host_sdk::g_devices.pio_sm[sm].level;
+}
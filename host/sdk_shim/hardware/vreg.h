@@ -0,0 +1,7 @@
+// Host shim for hardware/vreg.h - nothing to regulate
+#pragma once
+
+enum vreg_voltage { VREG_VOLTAGE_1_05 = 0b1010, VREG_VOLTAGE_1_10 = 0b1011, VREG_VOLTAGE_1_15 = 0b1100,
+                    VREG_VOLTAGE_1_20 = 0b1101, VREG_VOLTAGE_1_25 = 0b1110, VREG_VOLTAGE_1_30 = 0b1111 };
+
+inline void vreg_set_voltage(vreg_voltage) {}
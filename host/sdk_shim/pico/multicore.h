@@ -0,0 +1,49 @@
+// Host shim for pico/multicore.h - core 1 launch, inter-core FIFO and barriers
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include "pico/stdlib.h"
+
+inline void __dmb() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+// Core 1 is a thread for the life of the process
+inline void multicore_launch_core1(void (*entry)()) {
+    std::thread([entry] {
+        host_sdk::setCurrentCore(1);
+        entry();
+    }).detach();
+}
+
+inline bool multicore_fifo_rvalid() {
+    return host_sdk::fifoSize(get_core_num()) != 0;
+}
+
+inline bool multicore_fifo_wready() {
+    return host_sdk::fifoSize(get_core_num() ^ 1) < host_sdk::FIFO_DEPTH;
+}
+
+inline uint32_t multicore_fifo_pop_blocking() {
+    uint32_t value;
+    while (!host_sdk::fifoTryPop(get_core_num(), value)) tight_loop_contents();
+    return value;
+}
+
+inline void multicore_fifo_push_blocking(uint32_t value) {
+    if (host_sdk::fifoTryPush(get_core_num() ^ 1, value)) return;
+    host_sdk::g_fifo_stats[get_core_num() ^ 1].blocked++;
+    while (!host_sdk::fifoTryPush(get_core_num() ^ 1, value)) tight_loop_contents();
+}
+
+// Virtual time does not advance while waiting, so there only a zero timeout is meaningful
+inline bool multicore_fifo_push_timeout_us(uint32_t value, uint64_t timeout_us) {
+    uint64_t deadline = time_us_64() + timeout_us;
+    while (!host_sdk::fifoTryPush(get_core_num() ^ 1, value)) {
+        if (!host_sdk::g_real_time || time_us_64() >= deadline) {
+            host_sdk::g_fifo_stats[get_core_num() ^ 1].dropped++;
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
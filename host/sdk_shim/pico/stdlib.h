@@ -0,0 +1,56 @@
+// Host shim for pico/stdlib.h - the subset used by the synth's headers and main.cpp
+#pragma once
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "HostSdk.h"
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define PICO_ERROR_TIMEOUT -1
+
+inline uint64_t time_us_64() { return host_sdk::nowUs(); }
+inline uint32_t time_us_32() { return (uint32_t)host_sdk::nowUs(); }
+inline absolute_time_t get_absolute_time() { return time_us_64(); }
+inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+
+inline void sleep_us(uint64_t us) { host_sdk::sleepUs(us); }
+inline void sleep_ms(uint32_t ms) { host_sdk::sleepUs((uint64_t)ms * 1000); }
+inline void tight_loop_contents() { std::this_thread::yield(); }
+
+inline unsigned get_core_num() { return host_sdk::g_current_core; }
+
+// stdio: printf goes to stdout; the host decides what getchar reads (host_sdk::g_serial_fd)
+inline bool stdio_init_all() { return true; }
+inline bool stdio_usb_connected() { return host_sdk::g_serial_fd >= 0; }
+inline int getchar_timeout_us(uint32_t timeout_us) {
+    int c = host_sdk::serialGetchar(timeout_us);
+    return c < 0 ? PICO_ERROR_TIMEOUT : c;
+}
+
+[[noreturn]] inline void panic(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    std::fprintf(stderr, "PANIC: ");
+    std::vfprintf(stderr, fmt, args);
+    std::fprintf(stderr, "\n");
+    va_end(args);
+    std::abort();
+}
+
+// GPIO (hardware/gpio.h): pins have nothing attached on the host
+#define GPIO_OUT 1
+#define GPIO_IN 0
+enum gpio_function { GPIO_FUNC_SPI = 1, GPIO_FUNC_UART = 2, GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4,
+                     GPIO_FUNC_SIO = 5, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7, GPIO_FUNC_NULL = 0x1f };
+
+inline void gpio_init(uint) {}
+inline void gpio_set_dir(uint, bool) {}
+inline void gpio_put(uint, bool) {}
+inline void gpio_set_function(uint, gpio_function) {}
+inline void gpio_pull_up(uint) {}
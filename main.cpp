@@ -2,7 +2,6 @@
 #include "pico/multicore.h"
 #include "pico/stdlib.h"
 #include <cstdint>
-#include <string>
 // --- Core Application Headers ---
 #include "AudioEngine.h"
 #include "I2sAudioOutput.h"
@@ -10,8 +9,12 @@
 #include "GainModule.h"
 #include "MidiSerialListener.h"
 #include "Sh101StyleSynth.h"
+#include "DrumModule.h"
 #include "SynthScreens.h"
 #include "OledDisplay.h"
+#include "TelemetryStreamer.h"
+#include "HeapGuard.h"
+#include "BootSequence.h"
 
 // --- Synth-Specific Module Headers ---
 // #include "freqModSineModule.h"
@@ -30,10 +33,13 @@ void main_core1() {
 
   // 2. Create audio modules in processing order
   static Sh101StyleSynth synth_voice((float)ActiveAudioOutput::SAMPLE_RATE);
+  static DrumModule drums((float)ActiveAudioOutput::SAMPLE_RATE);
   static GainModule master_gain((float)ActiveAudioOutput::SAMPLE_RATE);
+  synth_voice.setDrumModule(&drums);
 
-  // 3. Add modules to engine in processing order (filter now per-voice)
+  // 3. Add modules to engine in processing order (filter now per-voice, drums mix over the synth)
   engine.addModule(&synth_voice);
+  engine.addModule(&drums);
   engine.addModule(&master_gain);
 
   // 4. Instantiate the audio hardware driver and give it the engine
@@ -47,51 +53,43 @@ void main_core1() {
 // Core 0: The Control Thread
 //==============================================================================
 int main() {
-  // Initialize USB FIRST with default clock
-  stdio_init_all();
-  sleep_ms(1000); // Allow USB to enumerate
-  
-  // --- Overclocking Section (AFTER USB init) ---
+  BootSequence boot;
+
+  // --- Overclocking Section (first, so Core 1 starts at full speed) ---
   // Set the core voltage. VREG_VOLTAGE_1_15 is a safe level for a 250MHz overclock.
   vreg_set_voltage(VREG_VOLTAGE_1_15);
   sleep_ms(2); // Allow voltage to stabilize
   // Set the system clock to 250 MHz (the SDK takes the frequency in KHz)
   set_sys_clock_khz(250000, true);
   sleep_ms(2);
+  boot.mark(BootMilestone::CLOCKS);
   // ----------------------------
 
-
   // IMPORTANT: Initialize the global parameter store BEFORE launching Core 1
   initialize_parameters();
 
-
-  printf("LOG:--- Pico Synth (Integrated Voice) Initialized ---\n");
-  printf("LOG: System clock is running at %lu kHz\n",
-         clock_get_hz(clk_sys) / 1000);
-  
-  // Initialize OLED display with loading animation
-  writeToOled("PICO SYNTH");
-  sleep_ms(500);
-  
-  // Simple loading animation
-  for (int i = 0; i < 6; i++) {
-    std::string dots(i + 1, '.');
-    writeToOled("PICO SYNTH\nLOADING" + dots);
-    sleep_ms(200);
-  }
-  
-  writeToOled("PICO SYNTH\nREADY!");
-  sleep_ms(500);
-  
-  // Launch the audio engine on the second core
+  // Launch the audio engine on the second core before the display and USB,
+  // so a reboot mid-set is silent for as short as possible (BootSequence.h)
   multicore_launch_core1(main_core1);
+  boot.mark(BootMilestone::CORE1_LAUNCHED);
+
+  // USB enumerates in the background; the boot report waits for the connection
+  stdio_init_all();
 
   // Create the listeners that will run on this core
-  MidiSerialListener midi_listener;
+  MidiSerialListener midi_listener(I2sAudioOutput::SAMPLE_RATE);
   
   // Switch to waveform display after startup
   switchSynthScreen(SynthScreen::WAVEFORM);
 
+  // Static memory model: once Core 1 renders, both cores are set up and any later
+  // heap allocation panics (HeapGuard.h)
+  while (g_engine_telemetry.read().block_count == 0) {
+    tight_loop_contents();
+  }
+  boot.mark(BootMilestone::AUDIO);
+  lockHeap();
+
   // The main control loop for Core 0 - MIDI gets absolute priority
   while (true) {
     // 1. MIDI processing - ALWAYS gets priority, run multiple times per loop
@@ -104,12 +102,11 @@ int main() {
     while (multicore_fifo_rvalid() && sample_count < 32) {  // Limit to 32 samples per loop
       uint32_t data = multicore_fifo_pop_blocking();
       
-      // Unpack fix15 from uint32_t and convert to float on Core 0
+      // Unpack fix15 from uint32_t - the display works on 16-bit integer samples directly
       int16_t fix15_sample = (int16_t)(data - 32768);
-      float sample = (float)fix15_sample / 32768.0f;
       
       // Feed to global screen manager (single sample at a time)
-      feedSynthWaveform(&sample, 1);
+      feedSynthWaveform(&fix15_sample, 1);
       sample_count++;
     }
     
@@ -119,6 +116,12 @@ int main() {
       updateSynthScreens();
       display_counter = 0;
     }
+    
+    // 4. Telemetry frames for host monitoring (no-op unless enabled with TLM_RATE)
+    g_telemetry_streamer.update();
+
+    // 5. Splash screen and boot report until both are done
+    boot.update();
   }
 
   return 0; // Will never be reached
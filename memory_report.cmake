@@ -0,0 +1,268 @@
+# memory_report.cmake - Post-build memory budget of the firmware
+#
+#   cmake -DOBJDUMP=<objdump> -DELF=<file.elf> -P memory_report.cmake
+#
+# Sums up each memory region and the SRAM left for the heap, breaks flash, SRAM
+# and scratch bank usage down per subsystem (SUBSYSTEMS), lists the symbols
+# placed by MemoryPlacement.h with the region they landed in, and flags hot audio
+# functions that are still executed from flash (XIP). The report is printed and
+# written next to the ELF as <name>.memory.txt.
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT OBJDUMP OR NOT ELF)
+    message(FATAL_ERROR "Usage: cmake -DOBJDUMP=<objdump> -DELF=<file.elf> -P memory_report.cmake")
+endif()
+
+# Per-sample, per-block and IRQ code of Core 1, matched against the function's own
+# name (a template's return type is skipped, its arguments are not searched).
+# Out-of-line copies of these belong in SRAM; an inlined one does not show up at all.
+# The block's control and note paths count too, and so do the float routines they
+# call (PICO_FLOAT_IN_RAM in CMakeLists.txt).
+set(HOT_FUNCTIONS
+        "::process\\("
+        "::processVoice\\("
+        "::mixOscillators\\("
+        "::handleMidiPacket\\("
+        "::getSample\\("
+        "::getNextValue\\("
+        "::getTriangle\\("
+        "::directSample\\("
+        "Phase::next\\("
+        "DrumModule::mix<"
+        "AudioEngine::processNextBlock\\("
+        "I2sAudioOutput::fillAndConvertNextBuffer\\("
+        "I2sAudioOutput::(static_)?dma_irh\\("
+        "packI2sFrames\\("
+        "Sh101StyleSynth::(updateControlSignals|snapshotPart|updateEnvelopes|updateUnison|updateVoiceMode)\\("
+        "Sh101StyleSynth::(updatePitchModulation|playNote|handleNoteOn|handleNoteOff|handleMonoNoteOn|handleMonoNoteOff)\\("
+        "VoiceAllocator::(noteOn<|noteOff\\(|chooseVictim<)"
+        "StepSequencer::(beginBlock|processEvents|fireStep)<"
+        "Arpeggiator::(configure<|processEvents<|selectNote\\()"
+        "DrumModule::startHit\\("
+        "^(__wrap_)?(expf|powf|sinf|sqrtf)$"
+)
+
+# Const tables read per sample (AUDIO_RAM_DATA)
+set(HOT_TABLES "(^|::)(NOTE_TABLE|FINE_TABLE|SINE|KBD_TRACKING_TABLE)$")
+
+# Subsystems for the breakdown: the first pattern matching a symbol's demangled
+# name wins, anything unmatched counts as SDK and C runtime
+set(SUBSYSTEMS samples drums voices sequencer engine display parameters control telemetry heap_guard)
+set(samples_LABEL "flash samples")
+set(samples_PATTERN "(^|::)samples::|SamplePlayer|g_sample_prefetch")
+set(drums_LABEL "drums")
+set(drums_PATTERN "DrumModule|drum_detail|g_drum_channel|main_core1\\(\\)::drums")
+set(voices_LABEL "synth voices")
+set(voices_PATTERN "Sh101StyleSynth|VoiceFilter|fixOscs|Fix15VCAEnvelopeModule|SmoothedValue|VoiceAllocator|NoteStack|pitch::|KBD_TRACKING_TABLE|KeyboardTracking|g_voice_policy|main_core1\\(\\)::synth_voice")
+set(sequencer_LABEL "sequencer, arp, clock")
+set(sequencer_PATTERN "Sequencer|g_sequencer|Arpeggiator|MidiClock|g_midi_clock")
+set(engine_LABEL "audio engine, I2S")
+set(engine_PATTERN "AudioEngine|GainModule|I2sAudioOutput|packI2sFrames|audio_i2s|^main_core1")
+set(display_LABEL "OLED screens")
+set(display_PATTERN "Oled|oled|SynthScreen|showSynthParameter|feedSynthWaveform|global_screen_manager|WidgetCanvas|Fix15FFT|AudioCapture|g_audio_capture|^font$")
+set(parameters_LABEL "parameters, parts")
+set(parameters_PATTERN "Parameter|g_synth_parameters|g_parameter_change_count|PartBank|g_part_|g_edit_part|reset_part_config")
+set(control_LABEL "MIDI, serial, main loop")
+set(control_PATTERN "MidiSerialListener|^main$")
+set(telemetry_LABEL "telemetry, trace")
+set(telemetry_PATTERN "Telemetry|g_engine_telemetry|TraceRing|g_trace_rings|traceEvent|LatencyProbe|g_latency_probe")
+set(heap_guard_LABEL "heap guard")
+set(heap_guard_PATTERN "HeapGuard|heap_locked|heap_stats|guardedAlloc|lockHeap|^operator (new|delete)")
+set(runtime_LABEL "SDK, C runtime")
+
+# Output sections of the SDK's default linker script, by region
+set(SRAM_SECTIONS ".data" ".bss" ".heap")
+set(SCRATCH_SECTIONS ".scratch_x" ".scratch_y" ".stack1_dummy" ".stack_dummy")
+set(FLASH_SECTIONS ".text" ".rodata" ".binary_info" ".boot2" ".ARM.exidx" ".ARM.extab")
+
+execute_process(COMMAND ${OBJDUMP} -h ${ELF} OUTPUT_VARIABLE headers RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} -h ${ELF} failed")
+endif()
+execute_process(COMMAND ${OBJDUMP} -t -C ${ELF} OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} -t ${ELF} failed")
+endif()
+
+# Brackets and semicolons in demangled names would break CMake list handling
+string(REGEX REPLACE "[][;]" "_" symbols "${symbols}")
+string(REPLACE "\n" ";" symbols "${symbols}")
+string(REPLACE "\n" ";" headers "${headers}")
+
+set(report "")
+macro(report_line line)
+    string(APPEND report "${line}\n")
+endmacro()
+
+macro(pad_left out value width)
+    set(${out} "${value}")
+    string(LENGTH "${${out}}" length)
+    while(length LESS ${width})
+        set(${out} " ${${out}}")
+        math(EXPR length "${length} + 1")
+    endwhile()
+endmacro()
+
+macro(pad_right out value width)
+    set(${out} "${value}")
+    string(LENGTH "${${out}}" length)
+    while(length LESS ${width})
+        set(${out} "${${out}} ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+endmacro()
+
+# "<size padded to 8> <name>", so that sorting the text sorts by size
+macro(size_entry out size name)
+    pad_left(${out} "${size}" 8)
+    set(${out} "${${out}}  ${name}")
+endmacro()
+
+get_filename_component(elf_name ${ELF} NAME)
+report_line("Memory budget of ${elf_name}")
+
+# Region totals from the section headers
+foreach(region SRAM SCRATCH FLASH)
+    set(${region}_bytes 0)
+endforeach()
+foreach(line IN LISTS headers)
+    if(NOT line MATCHES "^ *[0-9]+ ([^ ]+) +([0-9a-f]+) ")
+        continue()
+    endif()
+    set(section ${CMAKE_MATCH_1})
+    math(EXPR size "0x${CMAKE_MATCH_2}")
+    foreach(region SRAM SCRATCH FLASH)
+        if(section IN_LIST ${region}_SECTIONS)
+            math(EXPR ${region}_bytes "${${region}_bytes} + ${size}")
+        endif()
+    endforeach()
+endforeach()
+report_line("  flash (XIP): ${FLASH_bytes} bytes, SRAM: ${SRAM_bytes} bytes, scratch banks: ${SCRATCH_bytes} bytes")
+
+foreach(subsystem IN LISTS SUBSYSTEMS ITEMS runtime)
+    foreach(region SRAM SCRATCH FLASH)
+        set(${subsystem}_${region} 0)
+    endforeach()
+endforeach()
+
+# objdump -t line: <address> <7 flag characters> <section>\t<size> <name>
+set(heap_start "")
+set(heap_limit "")
+set(ram_code "")
+set(ram_data "")
+set(scratch_data "")
+set(flash_hot "")
+foreach(line IN LISTS symbols)
+    if(NOT line MATCHES "^([0-9a-f]+) (.......) ([^\t ]+)\t([0-9a-f]+) (.*)$")
+        continue()
+    endif()
+    set(flags "${CMAKE_MATCH_2}")
+    set(section "${CMAKE_MATCH_3}")
+    math(EXPR size "0x${CMAKE_MATCH_4}")
+    set(name "${CMAKE_MATCH_5}")
+    string(STRIP "${name}" name)
+    string(REGEX REPLACE "^\\.hidden " "" name "${name}")
+    if(name STREQUAL "__end__")
+        set(heap_start ${CMAKE_MATCH_1})
+    elseif(name STREQUAL "__HeapLimit")
+        set(heap_limit ${CMAKE_MATCH_1})
+    endif()
+    if(size EQUAL 0 OR name STREQUAL "")
+        continue()
+    endif()
+    string(REGEX MATCH "^[^(<]*[(<]?" function_name "${name}")
+    string(SUBSTRING "${flags}" 6 1 type)
+
+    # Subsystem breakdown of functions and objects; .data counts as SRAM (its flash image is not added)
+    if(type STREQUAL "F" OR type STREQUAL "O")
+        set(region "")
+        foreach(candidate SRAM SCRATCH FLASH)
+            if(section IN_LIST ${candidate}_SECTIONS)
+                set(region ${candidate})
+            endif()
+        endforeach()
+        if(region)
+            set(owner runtime)
+            foreach(subsystem IN LISTS SUBSYSTEMS)
+                if(name MATCHES "${${subsystem}_PATTERN}")
+                    set(owner ${subsystem})
+                    break()
+                endif()
+            endforeach()
+            math(EXPR ${owner}_${region} "${${owner}_${region}} + ${size}")
+        endif()
+    endif()
+
+    # Only SRAM code is a function in .data: the SDK copies .time_critical.* there at boot
+    if(section STREQUAL ".data" AND type STREQUAL "F")
+        size_entry(entry ${size} "${name}")
+        list(APPEND ram_code "${entry}")
+        continue()
+    endif()
+    if(section MATCHES "^\\.scratch_[xy]$" AND type STREQUAL "O")
+        size_entry(entry ${size} "${section}: ${name}")
+        list(APPEND scratch_data "${entry}")
+        continue()
+    endif()
+    if(type STREQUAL "O" AND name MATCHES "${HOT_TABLES}")
+        size_entry(entry ${size} "${name}")
+        if(section STREQUAL ".data")
+            list(APPEND ram_data "${entry}")
+        else()
+            list(APPEND flash_hot "${entry}")
+        endif()
+        continue()
+    endif()
+    if(section STREQUAL ".text" AND type STREQUAL "F")
+        foreach(pattern IN LISTS HOT_FUNCTIONS)
+            if(function_name MATCHES "${pattern}")
+                size_entry(entry ${size} "${name}")
+                list(APPEND flash_hot "${entry}")
+                break()
+            endif()
+        endforeach()
+    endif()
+endforeach()
+
+macro(report_list title entries)
+    set(total 0)
+    foreach(entry IN LISTS ${entries})
+        string(REGEX MATCH "[0-9]+" size "${entry}")
+        math(EXPR total "${total} + ${size}")
+    endforeach()
+    list(LENGTH ${entries} count)
+    report_line("  ${title}: ${count} symbols, ${total} bytes")
+    list(SORT ${entries})
+    list(REVERSE ${entries})
+    foreach(entry IN LISTS ${entries})
+        report_line("  ${entry}")
+    endforeach()
+endmacro()
+
+if(heap_start AND heap_limit)
+    math(EXPR heap_bytes "0x${heap_limit} - 0x${heap_start}")
+    report_line("  SRAM left for the heap: ${heap_bytes} bytes (no allocation after boot, HeapGuard.h)")
+endif()
+
+report_line("  by subsystem (bytes):        flash     SRAM  scratch")
+foreach(subsystem IN LISTS SUBSYSTEMS ITEMS runtime)
+    pad_right(label "${${subsystem}_LABEL}" 24)
+    pad_left(flash "${${subsystem}_FLASH}" 9)
+    pad_left(sram "${${subsystem}_SRAM}" 9)
+    pad_left(scratch "${${subsystem}_SCRATCH}" 9)
+    report_line("    ${label}${flash}${sram}${scratch}")
+endforeach()
+
+report_list("code in SRAM" ram_code)
+report_list("tables in SRAM" ram_data)
+report_list("Core 1 scratch bank" scratch_data)
+report_list("hot code and tables still in flash" flash_hot)
+
+string(REGEX REPLACE "\\.elf$" "" report_path "${ELF}")
+file(WRITE "${report_path}.memory.txt" "${report}")
+string(REGEX REPLACE "\n$" "" report "${report}")
+message("${report}")
+if(flash_hot)
+    message(WARNING "Hot audio code or tables are still in flash; see MemoryPlacement.h")
+endif()